@@ -0,0 +1,138 @@
+// log_tag_bench.cpp - 日志着色分类微基准
+// 在一份运行日志上测量原先界面线程每行的关键字扫描, 与现在的做法对比:
+// 状态码行的类别取自解析结果, 只有其余行在求解线程上调用 ClassifyLogLine
+//
+// 用法: log_tag_bench [运行日志 (未压缩)] [重复次数]
+// 不给日志时使用内置的合成日志
+
+#include "log_tag.h"
+#include "status_parser.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+constexpr int kDefaultRepeat = 50;
+
+// 合成日志: 状态码行与 CPLEX 输出, 警告, 错误行混合
+QVector<QByteArray> SyntheticLog() {
+    QVector<QByteArray> lines;
+    lines.append("[LOAD:OK:12:40:3:24]");
+    for (int k = 1; k <= 2000; ++k) {
+        lines.append(QByteArray("[ITER:") + QByteArray::number(k) + ":START]");
+        lines.append("CPLEX: Tried aggregator 1 time.");
+        lines.append("[MP:1020.5:1033.25:1001.75:0.0125]");
+        lines.append("  Root relaxation solution time = 0.02 sec.");
+        lines.append("[SP:{0,3,5,7}:4200.50:0.0125]");
+        lines.append("[CUT:{0,3,5,7}:4200.50]");
+        lines.append("Elapsed time = 0.15 sec. (57.2 ticks, tree = 0.01 MB)");
+        if (k % 50 == 0) {
+            lines.append("[WARN] 规划子问题达到时限, 使用当前最好解");
+        }
+        if (k % 400 == 0) {
+            lines.append("CPLEX Error  1217: No solution exists.");
+        }
+    }
+    lines.append("[DONE:OPTIMAL:0.000125:2000:312.5]");
+    return lines;
+}
+
+bool LoadLog(const QString& path, QVector<QByteArray>* lines) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "无法打开日志 %s: %s\n", qPrintable(path), qPrintable(file.errorString()));
+        return false;
+    }
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (!line.isEmpty()) {
+            lines->append(line);
+        }
+    }
+    return true;
+}
+
+// 原先 LogWidget::Append 在界面线程上选颜色的关键字扫描
+int LegacyColor(const QString& message) {
+    if (message.contains("[ERROR]") || message.contains("错误")) {
+        return 1;
+    } else if (message.contains("[WARN]") || message.contains("警告")) {
+        return 2;
+    } else if (message.contains("[INFO]")) {
+        return 3;
+    } else if (message.contains("[CUT]")) {
+        return 4;
+    } else if (message.contains("[GRAND]") || message.contains("[CONVERGE]") || message.contains("[DONE]")) {
+        return 5;
+    }
+    return 0;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QVector<QByteArray> raw;
+    if (args.size() > 1) {
+        if (!LoadLog(args[1], &raw)) {
+            return 1;
+        }
+    } else {
+        raw = SyntheticLog();
+    }
+    const int repeat = args.size() > 2 ? qMax(1, args[2].toInt()) : kDefaultRepeat;
+    if (raw.isEmpty()) {
+        std::fprintf(stderr, "日志为空\n");
+        return 1;
+    }
+
+    // 解码和状态码解析两种做法都要做, 不计入分类耗时
+    QStringList messages;
+    QVector<bool> is_status;
+    StatusParser parser;
+    for (const QByteArray& line : raw) {
+        messages.append(QString::fromLocal8Bit(line));
+        is_status.append(parser.Parse(line));
+    }
+    const qint64 total = messages.size();
+    const qint64 plain = std::count(is_status.cbegin(), is_status.cend(), false);
+
+    qint64 sink = 0;
+    QElapsedTimer timer;
+
+    timer.start();
+    for (int r = 0; r < repeat; ++r) {
+        for (const QString& message : messages) {
+            sink += LegacyColor(message);
+        }
+    }
+    const double legacy_ns = double(timer.nsecsElapsed()) / (double(total) * repeat);
+
+    timer.restart();
+    for (int r = 0; r < repeat; ++r) {
+        for (qint64 i = 0; i < total; ++i) {
+            if (!is_status[i]) {
+                sink += static_cast<int>(ClassifyLogLine(messages[i]));
+            }
+        }
+    }
+    const double classify_ns = double(timer.nsecsElapsed()) / (double(total) * repeat);
+
+    std::printf("行数 %lld (非状态码行 %lld), 重复 %d 次\n",
+                static_cast<long long>(total), static_cast<long long>(plain), repeat);
+    std::printf("原先界面线程关键字扫描: %8.1f ns/行\n", legacy_ns);
+    std::printf("现在求解线程分类:       %8.1f ns/行 (仅非状态码行调用, 按全部行平均)\n", classify_ns);
+    std::printf("现在界面线程:           按类别枚举查预先包装的调色板, 不扫描文本\n");
+    std::printf("(校验和 %lld)\n", static_cast<long long>(sink));
+    return 0;
+}
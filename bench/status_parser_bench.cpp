@@ -0,0 +1,177 @@
+// status_parser_bench.cpp - 状态码解析微基准
+// 在一份运行日志上比较原先的逐个正则匹配与 StatusParser 按标签分派的耗时
+//
+// 用法: status_parser_bench [运行日志 (未压缩)] [重复次数]
+// 不给日志时使用内置的合成日志
+
+#include "status_parser.h"
+
+#include <QByteArray>
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QStringList>
+#include <QVector>
+#include <cstdio>
+
+namespace {
+
+constexpr int kDefaultRepeat = 20;
+
+// 合成日志: 按一次典型求解的比例混合状态码行和普通日志行
+QVector<QByteArray> SyntheticLog() {
+    QVector<QByteArray> lines;
+    lines.append("[LOAD:OK:12:40:3:24]");
+    lines.append("[GRAND:15234.75:1.25]");
+    for (int k = 1; k <= 2000; ++k) {
+        lines.append(QByteArray("[ITER:") + QByteArray::number(k) + ":START]");
+        lines.append("CPLEX: Tried aggregator 1 time.");
+        lines.append("MIP Presolve eliminated 120 rows and 85 columns.");
+        QByteArray mp("[MP:");
+        for (int u = 0; u < 12; ++u) {
+            mp += QByteArray::number(1000.0 + u * 17.25 + k * 0.01, 'f', 4) + ':';
+        }
+        mp += QByteArray::number(1.0 / k, 'f', 6) + ']';
+        lines.append(mp);
+        lines.append("  Root relaxation solution time = 0.02 sec.");
+        lines.append("[SP:{0,3,5,7}:" + QByteArray::number(4200.5 + k, 'f', 2) + ":0.0125]");
+        lines.append("[CUT:{0,3,5,7}:" + QByteArray::number(4200.5 + k, 'f', 2) + "]");
+        lines.append("Elapsed time = 0.15 sec. (57.2 ticks, tree = 0.01 MB)");
+    }
+    lines.append("[CONVERGE:1.0e-06]");
+    lines.append("[DONE:OPTIMAL:0.000125:2000:312.5]");
+    return lines;
+}
+
+bool LoadLog(const QString& path, QVector<QByteArray>* lines) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "无法打开日志 %s: %s\n", qPrintable(path), qPrintable(file.errorString()));
+        return false;
+    }
+    while (!file.atEnd()) {
+        const QByteArray line = file.readLine().trimmed();
+        if (!line.isEmpty()) {
+            lines->append(line);
+        }
+    }
+    return true;
+}
+
+// 原先 SolverWorker::ParseStatusCode 的做法: 每行解码为 QString, 依次构造并匹配各标签的正则
+bool RegexParse(const QByteArray& raw) {
+    const QString line = QString::fromLocal8Bit(raw);
+
+    QRegularExpression load_regex(R"(\[LOAD:OK:(\d+):(\d+):(\d+):(\d+)\])");
+    auto load_match = load_regex.match(line);
+    if (load_match.hasMatch()) {
+        return load_match.captured(1).toInt() >= 0;
+    }
+
+    QRegularExpression grand_regex(R"(\[GRAND:([\d.]+):([\d.]+)\])");
+    auto grand_match = grand_regex.match(line);
+    if (grand_match.hasMatch()) {
+        return grand_match.captured(1).toDouble() >= 0;
+    }
+
+    QRegularExpression iter_regex(R"(\[ITER:(\d+):START\])");
+    auto iter_match = iter_regex.match(line);
+    if (iter_match.hasMatch()) {
+        return iter_match.captured(1).toInt() >= 0;
+    }
+
+    QRegularExpression mp_regex(R"(\[MP:([\d.:]+)\])");
+    auto mp_match = mp_regex.match(line);
+    if (mp_match.hasMatch()) {
+        QStringList parts = mp_match.captured(1).split(':');
+        QVector<double> pi;
+        for (int i = 0; i < parts.size() - 1; ++i) {
+            pi.append(parts[i].toDouble());
+        }
+        return parts.size() >= 2;
+    }
+
+    QRegularExpression sp_regex(R"(\[SP:(\{[^}]+\}):([\d.]+):([\d.-]+)\])");
+    auto sp_match = sp_regex.match(line);
+    if (sp_match.hasMatch()) {
+        return !sp_match.captured(1).isEmpty();
+    }
+
+    QRegularExpression cut_regex(R"(\[CUT:(\{[^}]+\}):([\d.]+)\])");
+    auto cut_match = cut_regex.match(line);
+    if (cut_match.hasMatch()) {
+        return !cut_match.captured(1).isEmpty();
+    }
+
+    QRegularExpression conv_regex(R"(\[CONVERGE:([\d.e+-]+)\])");
+    auto conv_match = conv_regex.match(line);
+    if (conv_match.hasMatch()) {
+        return conv_match.captured(1).toDouble() >= 0;
+    }
+
+    QRegularExpression done_regex(R"(\[DONE:(\w+):([\d.-]+):(\d+):([\d.]+)\])");
+    auto done_match = done_regex.match(line);
+    return done_match.hasMatch();
+}
+
+struct BenchResult {
+    qint64 matched = 0;
+    double ns_per_line = 0.0;
+};
+
+template <typename ParseFn>
+BenchResult Run(const QVector<QByteArray>& lines, int repeat, ParseFn parse) {
+    BenchResult result;
+    QElapsedTimer timer;
+    timer.start();
+    for (int r = 0; r < repeat; ++r) {
+        for (const QByteArray& line : lines) {
+            result.matched += parse(line) ? 1 : 0;
+        }
+    }
+    result.ns_per_line = double(timer.nsecsElapsed()) / (double(lines.size()) * repeat);
+    result.matched /= repeat;
+    return result;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QVector<QByteArray> lines;
+    if (args.size() > 1) {
+        if (!LoadLog(args[1], &lines)) {
+            return 1;
+        }
+    } else {
+        lines = SyntheticLog();
+    }
+    const int repeat = args.size() > 2 ? qMax(1, args[2].toInt()) : kDefaultRepeat;
+    if (lines.isEmpty()) {
+        std::fprintf(stderr, "日志为空\n");
+        return 1;
+    }
+
+    const BenchResult regex = Run(lines, repeat, RegexParse);
+
+    StatusParser parser;
+    const BenchResult dispatch = Run(lines, repeat, [&parser](const QByteArray& line) {
+        return parser.Parse(line);
+    });
+
+    std::printf("行数 %lld, 重复 %d 次\n", static_cast<long long>(lines.size()), repeat);
+    std::printf("正则逐个匹配: %10.1f ns/行, 状态码行 %lld\n", regex.ns_per_line,
+                static_cast<long long>(regex.matched));
+    std::printf("按标签分派:   %10.1f ns/行, 状态码行 %lld\n", dispatch.ns_per_line,
+                static_cast<long long>(dispatch.matched));
+    std::printf("加速比: %.1fx\n", regex.ns_per_line / qMax(dispatch.ns_per_line, 1e-9));
+
+    // 两种做法识别的行数不同时提示 (新解析器接受完整的 double 语法, 旧正则不接受指数和负号)
+    if (regex.matched != dispatch.matched) {
+        std::printf("注意: 两者识别的状态码行数不同\n");
+    }
+    return 0;
+}
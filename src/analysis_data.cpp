@@ -0,0 +1,212 @@
+// analysis_data.cpp - 分析面板数据实现
+
+#include "analysis_data.h"
+
+#include <QJsonArray>
+#include <QHash>
+
+namespace {
+
+// 每处理这么多行报告一次进度 (同时检查取消)
+constexpr int kProgressStride = 4096;
+
+// 个体理性的容差
+constexpr double kRationalityTolerance = 1e-6;
+
+// 按行报告进度, 每 kProgressStride 行回调一次 (同时检查取消)
+class RowProgress {
+public:
+    RowProgress(qint64 total_rows, const AnalysisProgress& progress)
+        : total_rows_(qMax<qint64>(1, total_rows)), progress_(progress) {}
+
+    bool Step() { return ++done_rows_ % kProgressStride != 0 || Report(); }
+
+    bool Report() const {
+        return !progress_ || progress_(static_cast<int>(done_rows_ * 100 / total_rows_));
+    }
+
+private:
+    qint64 total_rows_;
+    qint64 done_rows_ = 0;
+    const AnalysisProgress& progress_;
+};
+
+// 阶段计时 (由本程序运行的求解附带) 按运行内的迭代序号对应到行
+// 续算的运行计时表的迭代号含检查点偏移 (从偏移 + 1 开始), 迭代历史则从 1 开始,
+// 因此以计时表第一行为本次运行的第 1 轮
+QHash<int, int> TimingRows(const PhaseTiming& timing) {
+    QHash<int, int> rows;
+    if (timing.Rows().isEmpty()) {
+        return rows;
+    }
+    const int offset = timing.Rows().first().iteration - 1;
+    for (int r = 0; r < timing.Rows().size(); ++r) {
+        rows.insert(timing.Rows()[r].iteration - offset, r);
+    }
+    return rows;
+}
+
+}  // namespace
+
+AnalysisData AnalysisData::FromSummary(const QJsonObject& result) {
+    AnalysisData data;
+
+    // ========== 概览 ==========
+    OverviewData& overview = data.overview;
+    overview.grand_cost = result["grand_coalition_cost"].toDouble();
+    overview.v_star = result["least_core_slack"].toDouble();
+    overview.iterations = result["iterations"].toInt();
+    overview.runtime = result["runtime_seconds"].toDouble();
+    overview.core_nonempty = result["interpretation"].toObject()["core_status"].toString() == "non-empty";
+
+    const QJsonArray alloc_array = result["allocation_array"].toArray();
+    overview.allocation.reserve(alloc_array.size());
+    for (const QJsonValue& value : alloc_array) {
+        overview.allocation.append(value.toDouble());
+    }
+
+    const QJsonObject problem_size = result["problem_size"].toObject();
+    overview.num_plants = problem_size["num_plants"].toInt();
+    overview.num_items = problem_size["num_items"].toInt();
+    overview.num_families = problem_size["num_families"].toInt();
+    overview.num_periods = problem_size["num_periods"].toInt();
+
+    // ========== 工厂视角 ==========
+    PlantData& plants = data.plants;
+    const QJsonObject singleton_costs = result["singleton_costs"].toObject();
+    plants.grand_cost = overview.grand_cost;
+    plants.rows.reserve(overview.allocation.size());
+    for (int u = 0; u < overview.allocation.size(); ++u) {
+        PlantRow row;
+        row.allocation = overview.allocation[u];
+        row.singleton_cost = singleton_costs.value(QString::number(u)).toDouble(0.0);
+        row.savings = row.singleton_cost - row.allocation;
+        row.savings_rate = (row.singleton_cost > 0) ? (row.savings / row.singleton_cost * 100.0) : 0.0;
+        row.rational = row.allocation <= row.singleton_cost + kRationalityTolerance;
+
+        plants.total_allocation += row.allocation;
+        plants.total_singleton += row.singleton_cost;
+        plants.all_rational = plants.all_rational && row.rational;
+        plants.rows.append(row);
+    }
+    return data;
+}
+
+bool AnalysisData::FromResultFile(const ResultFile& file, AnalysisData* out, QString* error) {
+    // 摘要只含标量和分配等小字段, 不读取约束和迭代历史
+    QJsonObject summary;
+    if (!file.ReadSummary(&summary, error)) {
+        return false;
+    }
+    *out = FromSummary(summary);
+    return true;
+}
+
+bool CoalitionData::FromJson(const QJsonObject& result, const OverviewData& overview, CoalitionData* out,
+                             const AnalysisProgress& progress) {
+    const QJsonArray cuts = result["cuts"].toArray();
+    RowProgress rows(cuts.size(), progress);
+
+    out->allocation = overview.allocation;
+    out->v_star = overview.v_star;
+    out->cuts.Clear();
+    out->cuts.Reserve(cuts.size());
+    for (int i = 0; i < cuts.size(); ++i) {
+        const QJsonObject cut = cuts[i].toObject();
+        out->cuts.Append(cut["iteration"].toInt(i + 1),
+                         Coalition::FromJson(cut["coalition"].toArray()),
+                         cut["cost"].toDouble());
+        if (!rows.Step()) return false;
+    }
+    out->cuts.Finish(out->allocation, out->v_star);
+    return rows.Report();
+}
+
+bool CoalitionData::FromResultFile(const ResultFile& file, const OverviewData& overview, CoalitionData* out,
+                                   const AnalysisProgress& progress, QString* error) {
+    // 按列读取, 不经过 JSON
+    ResultTable cuts;
+    if (!file.ReadTable("cuts", &cuts, error)) {
+        return false;
+    }
+    RowProgress rows(cuts.Rows(), progress);
+
+    out->allocation = overview.allocation;
+    out->v_star = overview.v_star;
+    out->cuts.Clear();
+    out->cuts.Reserve(cuts.Rows());
+    for (int i = 0; i < cuts.Rows(); ++i) {
+        out->cuts.Append(static_cast<int>(cuts.Integer("iteration", i, i + 1)),
+                         cuts.CoalitionAt("coalition", i),
+                         cuts.Double("cost", i));
+        if (!rows.Step()) return false;
+    }
+    out->cuts.Finish(out->allocation, out->v_star);
+    return rows.Report();
+}
+
+bool IterationData::FromJson(const QJsonObject& result, const OverviewData& overview, IterationData* out,
+                             const AnalysisProgress& progress) {
+    const QJsonArray history = result["iteration_history"].toArray();
+    RowProgress rows(history.size(), progress);
+
+    out->timing = PhaseTiming::FromJson(result["phase_timing"].toArray());
+    out->final_v = overview.v_star;
+    out->runtime = overview.runtime;
+    out->rows.clear();
+
+    const QHash<int, int> timing_rows = TimingRows(out->timing);
+    out->rows.reserve(history.size());
+    for (int i = 0; i < history.size(); ++i) {
+        const QJsonObject iter = history[i].toObject();
+        IterationRow row;
+        row.v_hat = iter["v_hat"].toDouble();
+        row.delta = iter["delta"].toDouble();
+        row.coalition = Coalition::FromJson(iter["coalition"].toArray());
+        row.cost = iter["coalition_cost"].toDouble();
+        row.converged = iter["converged"].toBool(false);
+        row.timing_row = timing_rows.value(i + 1, -1);
+        out->rows.append(row);
+        if (!rows.Step()) return false;
+    }
+    return rows.Report();
+}
+
+bool IterationData::FromResultFile(const ResultFile& file, const QJsonObject& extra, const OverviewData& overview,
+                                   IterationData* out, const AnalysisProgress& progress, QString* error) {
+    // 本次运行附带的阶段计时优先, 否则读文件中的计时表
+    QJsonArray timing_json = extra["phase_timing"].toArray();
+    if (!extra.contains("phase_timing") && file.HasTable("phase_timing")) {
+        ResultTable timing;
+        if (!file.ReadTable("phase_timing", &timing, error)) {
+            return false;
+        }
+        timing_json = timing.ToJson();
+    }
+
+    ResultTable history;
+    if (!file.ReadTable("iteration_history", &history, error)) {
+        return false;
+    }
+    RowProgress rows(history.Rows(), progress);
+
+    out->timing = PhaseTiming::FromJson(timing_json);
+    out->final_v = overview.v_star;
+    out->runtime = overview.runtime;
+    out->rows.clear();
+
+    const QHash<int, int> timing_rows = TimingRows(out->timing);
+    out->rows.reserve(history.Rows());
+    for (int i = 0; i < history.Rows(); ++i) {
+        IterationRow row;
+        row.v_hat = history.Double("v_hat", i);
+        row.delta = history.Double("delta", i);
+        row.coalition = history.CoalitionAt("coalition", i);
+        row.cost = history.Double("coalition_cost", i);
+        row.converged = history.Bool("converged", i);
+        row.timing_row = timing_rows.value(i + 1, -1);
+        out->rows.append(row);
+        if (!rows.Step()) return false;
+    }
+    return rows.Report();
+}
@@ -0,0 +1,115 @@
+// analysis_data.h - 分析面板数据
+// 在加载线程上由结果 JSON 或二进制结果文件准备各面板要显示的内容, 面板只负责显示
+// 摘要部分 (概览, 工厂视角) 随结果一起准备; 联盟分析和迭代历史要读取约束和迭代历史, 在面板需要时才单独准备
+
+#ifndef ANALYSIS_DATA_H
+#define ANALYSIS_DATA_H
+
+#include "coalition.h"
+#include "cut_store.h"
+#include "phase_timing.h"
+#include "result_file.h"
+
+#include <QJsonObject>
+#include <QMetaType>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+// 概览: 指标, 分配, 核状态, 问题规模
+struct OverviewData {
+    double grand_cost = 0.0;
+    double v_star = 0.0;
+    int iterations = 0;
+    double runtime = 0.0;
+    QVector<double> allocation;
+    bool core_nonempty = false;
+    int num_plants = 0;
+    int num_items = 0;
+    int num_families = 0;
+    int num_periods = 0;
+};
+
+// 工厂视角: 每个工厂一行及合计
+struct PlantRow {
+    double singleton_cost = 0.0;    // c({u})
+    double allocation = 0.0;        // pi_u
+    double savings = 0.0;
+    double savings_rate = 0.0;      // 百分比
+    bool rational = true;           // pi_u <= c({u})
+};
+
+struct PlantData {
+    QVector<PlantRow> rows;
+    double grand_cost = 0.0;
+    double total_allocation = 0.0;
+    double total_singleton = 0.0;
+    bool all_rational = true;
+};
+
+// 进度回调 (0-100), 返回 false 表示取消
+using AnalysisProgress = std::function<bool(int percent)>;
+
+// 摘要部分: 概览和工厂视角, 只用到结果的摘要字段
+struct AnalysisData {
+    QString source_file;
+    OverviewData overview;
+    PlantData plants;
+
+    // 由结果 JSON (只用摘要字段) 准备
+    static AnalysisData FromSummary(const QJsonObject& summary);
+
+    // 由二进制结果文件的摘要节准备, 不读取约束和迭代历史; 出错时写入 *error
+    static bool FromResultFile(const ResultFile& file, AnalysisData* out, QString* error);
+};
+
+// 联盟分析: 约束 (列存储, 已按最终分配算好松弛量和排序) 及最终分配
+struct CoalitionData {
+    CutStore cuts;
+    QVector<double> allocation;
+    double v_star = 0.0;
+
+    // 由结果 JSON 的 cuts 准备; 取消时返回 false
+    static bool FromJson(const QJsonObject& result, const OverviewData& overview, CoalitionData* out,
+                         const AnalysisProgress& progress = AnalysisProgress());
+
+    // 由二进制结果文件的 cuts 节准备; 出错时写入 *error, 取消时返回 false 且 *error 为空
+    static bool FromResultFile(const ResultFile& file, const OverviewData& overview, CoalitionData* out,
+                               const AnalysisProgress& progress, QString* error);
+};
+
+// 迭代历史: 每轮一行, 阶段用时按运行内的迭代序号对应 (续算时不含检查点偏移; 没有时 timing_row 为 -1)
+struct IterationRow {
+    double v_hat = 0.0;
+    double delta = 0.0;
+    Coalition coalition;
+    double cost = 0.0;
+    bool converged = false;
+    int timing_row = -1;
+};
+
+struct IterationData {
+    QVector<IterationRow> rows;
+    PhaseTiming timing;
+    double final_v = 0.0;
+    double runtime = 0.0;
+
+    // 由结果 JSON 的 iteration_history 和 phase_timing 准备; 取消时返回 false
+    static bool FromJson(const QJsonObject& result, const OverviewData& overview, IterationData* out,
+                         const AnalysisProgress& progress = AnalysisProgress());
+
+    // 由二进制结果文件准备, 阶段计时优先取 extra 中的; 出错时写入 *error, 取消时返回 false 且 *error 为空
+    static bool FromResultFile(const ResultFile& file, const QJsonObject& extra, const OverviewData& overview,
+                               IterationData* out, const AnalysisProgress& progress, QString* error);
+};
+
+using AnalysisDataPtr = QSharedPointer<const AnalysisData>;
+using CoalitionDataPtr = QSharedPointer<const CoalitionData>;
+using IterationDataPtr = QSharedPointer<const IterationData>;
+
+Q_DECLARE_METATYPE(AnalysisDataPtr)
+Q_DECLARE_METATYPE(CoalitionDataPtr)
+Q_DECLARE_METATYPE(IterationDataPtr)
+
+#endif  // ANALYSIS_DATA_H
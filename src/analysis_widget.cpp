@@ -7,12 +7,44 @@
 #include "panels/iteration_panel.h"
 
 #include <QVBoxLayout>
+#include <QHBoxLayout>
 #include <QTabWidget>
 #include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QFileInfo>
+#include <QTimer>
+
+namespace {
+
+// 换数据后等当前 Tab 绘制完成再在空闲时填充其余面板
+constexpr int kIdleLoadDelayMs = 300;
+
+}  // namespace
 
 AnalysisWidget::AnalysisWidget(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , loader_(new ResultLoader(this))
+    , loading_request_(0)
+    , data_request_(0)
+    , data_generation_(0)
+    , coalitions_requested_(0)
+    , iterations_requested_(0) {
     SetupUI();
+
+    panel_generation_.fill(0, tab_widget_->count());
+    idle_timer_ = new QTimer(this);
+    idle_timer_->setSingleShot(true);
+    connect(idle_timer_, &QTimer::timeout, this, &AnalysisWidget::LoadNextIdlePanel);
+    connect(tab_widget_, &QTabWidget::currentChanged, this, &AnalysisWidget::OnTabChanged);
+
+    connect(loader_, &ResultLoader::Progress, this, &AnalysisWidget::OnLoadProgress);
+    connect(loader_, &ResultLoader::Loaded, this, &AnalysisWidget::OnLoaded);
+    connect(loader_, &ResultLoader::CoalitionsLoaded, this, &AnalysisWidget::OnCoalitionsLoaded);
+    connect(loader_, &ResultLoader::IterationsLoaded, this, &AnalysisWidget::OnIterationsLoaded);
+    connect(loader_, &ResultLoader::Failed, this, &AnalysisWidget::OnLoadFailed);
+    connect(loader_, &ResultLoader::PartFailed, this, &AnalysisWidget::OnPartFailed);
+    connect(loader_, &ResultLoader::Cancelled, this, &AnalysisWidget::OnLoadCancelled);
 }
 
 void AnalysisWidget::SetupUI() {
@@ -23,6 +55,18 @@ void AnalysisWidget::SetupUI() {
     status_label_ = new QLabel("请加载结果文件或运行求解器");
     status_label_->setStyleSheet("color: #999;");
 
+    // 加载进度 (加载期间显示)
+    loading_bar_ = new QWidget();
+    QHBoxLayout* loading_layout = new QHBoxLayout(loading_bar_);
+    loading_layout->setContentsMargins(0, 0, 0, 0);
+    loading_progress_ = new QProgressBar();
+    loading_progress_->setRange(0, 100);
+    loading_cancel_button_ = new QPushButton("取消");
+    loading_layout->addWidget(loading_progress_, 1);
+    loading_layout->addWidget(loading_cancel_button_);
+    loading_bar_->setVisible(false);
+    connect(loading_cancel_button_, &QPushButton::clicked, loader_, &ResultLoader::Cancel);
+
     // Tab 控件 - 与主窗口风格一致
     tab_widget_ = new QTabWidget();
     tab_widget_->setStyleSheet(R"(
@@ -55,29 +99,198 @@ void AnalysisWidget::SetupUI() {
     tab_widget_->addTab(iteration_panel_, "迭代历史");
 
     layout->addWidget(status_label_);
+    layout->addWidget(loading_bar_);
     layout->addWidget(tab_widget_);
 }
 
-void AnalysisWidget::LoadResult(const QJsonObject& result) {
-    current_result_ = result;
+void AnalysisWidget::LoadFile(const QString& path, const QJsonObject& extra) {
+    loading_request_ = loader_->Load(path, extra);
+    loading_progress_->setValue(0);
+    loading_progress_->setFormat(QString("%1: %p%").arg(QFileInfo(path).fileName()));
+    SetLoading(true);
+}
 
-    if (result.isEmpty()) {
+void AnalysisWidget::ShowResult(int request_id, const AnalysisDataPtr& data) {
+    if (!data) {
         Clear();
         return;
     }
 
+    // 同一份数据已填充过的面板保持不变
+    if (data != current_data_) {
+        current_data_ = data;
+        data_request_ = request_id;
+        coalitions_.reset();
+        iterations_.reset();
+        ++data_generation_;
+    }
+
     // 隐藏提示
     status_label_->setVisible(false);
 
-    // 加载到各个子面板
-    overview_panel_->LoadData(result);
-    plant_panel_->LoadData(result);
-    coalition_panel_->LoadData(result);
-    iteration_panel_->LoadData(result);
+    // 只填充当前 Tab, 其余的留到切换或空闲时; 约束和迭代历史也到那时才准备
+    EnsurePanelLoaded(tab_widget_->currentIndex());
+    UpdatePartProgress();
+    idle_timer_->start(kIdleLoadDelayMs);
+}
+
+bool AnalysisWidget::EnsurePanelLoaded(int index) {
+    if (!current_data_ || index < 0 || index >= panel_generation_.size()) {
+        return false;
+    }
+    if (panel_generation_[index] == data_generation_) {
+        return true;
+    }
+
+    QWidget* panel = tab_widget_->widget(index);
+    if (panel == overview_panel_) {
+        overview_panel_->LoadData(*current_data_);
+    } else if (panel == plant_panel_) {
+        plant_panel_->LoadData(*current_data_);
+    } else if (panel == coalition_panel_) {
+        if (!coalitions_) {
+            RequestPart(AnalysisPart::kCoalitions);
+            return false;
+        }
+        coalition_panel_->LoadData(*coalitions_);
+    } else if (panel == iteration_panel_) {
+        if (!iterations_) {
+            RequestPart(AnalysisPart::kIterations);
+            return false;
+        }
+        iteration_panel_->LoadData(*iterations_);
+    }
+    panel_generation_[index] = data_generation_;
+    return true;
+}
+
+void AnalysisWidget::RequestPart(AnalysisPart part) {
+    int& requested = (part == AnalysisPart::kCoalitions) ? coalitions_requested_ : iterations_requested_;
+    if (requested == data_generation_) return;
+    requested = data_generation_;
+    loader_->LoadPart(data_request_, part);
+}
+
+void AnalysisWidget::UpdatePendingPanels() {
+    EnsurePanelLoaded(tab_widget_->currentIndex());
+    UpdatePartProgress();
+    idle_timer_->start(kIdleLoadDelayMs);
+}
+
+void AnalysisWidget::UpdatePartProgress() {
+    // 加载新文件期间显示的是文件加载进度
+    if (loading_request_ != 0) return;
+
+    const int index = tab_widget_->currentIndex();
+    const bool waiting = current_data_ && index >= 0 && index < panel_generation_.size()
+                         && panel_generation_[index] != data_generation_;
+    if (waiting && !loading_bar_->isVisible()) {
+        loading_progress_->setValue(0);
+        loading_progress_->setFormat("准备数据 %p%");
+    }
+    loading_bar_->setVisible(waiting);
+    loading_cancel_button_->setVisible(false);
+}
+
+void AnalysisWidget::OnTabChanged(int index) {
+    EnsurePanelLoaded(index);
+    UpdatePartProgress();
+}
+
+void AnalysisWidget::LoadNextIdlePanel() {
+    if (!current_data_) return;
+
+    // 每次只填一个面板, 之间让出事件循环, 界面保持响应
+    // 数据未就绪的面板在这里请求准备, 等数据到达后再继续, 加载线程上同一时间只准备一个部分
+    for (int index = 0; index < panel_generation_.size(); ++index) {
+        if (panel_generation_[index] == data_generation_) continue;
+        if (EnsurePanelLoaded(index)) {
+            idle_timer_->start(0);
+        }
+        return;
+    }
+}
+
+void AnalysisWidget::OnLoadProgress(int request_id, int percent, const QString& stage) {
+    // 文件加载的进度, 或当前 Tab 等待的部分数据的进度
+    const bool part_progress = loading_request_ == 0 && request_id == data_request_ && loading_bar_->isVisible();
+    if (request_id != loading_request_ && !part_progress) return;
+    loading_progress_->setValue(percent);
+    loading_progress_->setFormat(QString("%1 %p%").arg(stage));
+}
+
+void AnalysisWidget::OnLoaded(int request_id, const QString& path, const AnalysisDataPtr& data) {
+    if (request_id != loading_request_) return;
+    SetLoading(false);
+    ShowResult(request_id, data);
+    emit ResultLoaded(path);
+}
+
+void AnalysisWidget::OnCoalitionsLoaded(int request_id, const CoalitionDataPtr& data) {
+    if (request_id != data_request_ || !current_data_) return;
+    coalitions_ = data;
+    UpdatePendingPanels();
+}
+
+void AnalysisWidget::OnIterationsLoaded(int request_id, const IterationDataPtr& data) {
+    if (request_id != data_request_ || !current_data_) return;
+    iterations_ = data;
+    UpdatePendingPanels();
+}
+
+void AnalysisWidget::OnLoadFailed(int request_id, const QString& path, const QString& error) {
+    if (request_id != loading_request_) return;
+    SetLoading(false);
+    ResumePartRequests();
+    emit LoadFailed(path, error);
+}
+
+void AnalysisWidget::OnPartFailed(int request_id, AnalysisPart part, const QString& error) {
+    if (request_id != data_request_ || !current_data_) return;
+
+    // 面板保持空白, 这份结果不再重试
+    QWidget* panel = (part == AnalysisPart::kCoalitions) ? static_cast<QWidget*>(coalition_panel_) : iteration_panel_;
+    panel_generation_[tab_widget_->indexOf(panel)] = data_generation_;
+    UpdatePendingPanels();
+    emit LoadFailed(current_data_->source_file, error);
+}
+
+void AnalysisWidget::OnLoadCancelled(int request_id) {
+    if (request_id != loading_request_) return;
+    SetLoading(false);
+    ResumePartRequests();
+}
+
+void AnalysisWidget::ResumePartRequests() {
+    if (!current_data_) return;
+
+    // 新文件加载期间发出的部分请求已被加载线程丢弃, 仍显示原结果时重新请求 (准备过的部分由加载线程直接发回)
+    coalitions_requested_ = 0;
+    iterations_requested_ = 0;
+    UpdatePendingPanels();
+}
+
+void AnalysisWidget::SetLoading(bool loading) {
+    if (!loading) {
+        loading_request_ = 0;
+    }
+    loading_bar_->setVisible(loading);
+    loading_cancel_button_->setVisible(true);
+    if (loading) {
+        status_label_->setVisible(false);
+    } else if (!current_data_) {
+        status_label_->setVisible(true);
+    }
 }
 
 void AnalysisWidget::Clear() {
-    current_result_ = QJsonObject();
+    current_data_.reset();
+    data_request_ = 0;
+    coalitions_.reset();
+    iterations_.reset();
+    ++data_generation_;
+    idle_timer_->stop();
+    UpdatePartProgress();
 
     status_label_->setVisible(true);
 
@@ -1,14 +1,23 @@
 // analysis_widget.h - 分析面板主控件
-// 包含子 Tab: 概览 | 工厂视角 | 联盟分析 | 迭代历史
+// 包含子 Tab: 概览 | 工厂视角 | 联盟分析 | 迭代历史; 结果文件在后台加载, 期间显示进度并可取消
+// 子面板按需填充: 当前 Tab 先填, 其余在切换到该 Tab 或空闲时填, 结果不变时不重复填
+// 联盟分析和迭代历史的数据也到这时才请求加载线程准备, 每份结果只准备一次
 
 #ifndef ANALYSIS_WIDGET_H
 #define ANALYSIS_WIDGET_H
 
+#include "analysis_data.h"
+#include "result_loader.h"
+
 #include <QWidget>
 #include <QJsonObject>
+#include <QVector>
 
 class QTabWidget;
 class QLabel;
+class QProgressBar;
+class QPushButton;
+class QTimer;
 
 // 前向声明子面板
 class OverviewPanel;
@@ -22,26 +31,83 @@ class AnalysisWidget : public QWidget {
 public:
     explicit AnalysisWidget(QWidget* parent = nullptr);
 
-    // 加载结果数据
-    void LoadResult(const QJsonObject& result);
+    // 后台加载结果文件, extra 中的字段并入结果 (如阶段计时); 之前未完成的加载被取消
+    void LoadFile(const QString& path, const QJsonObject& extra = QJsonObject());
 
     // 清空
     void Clear();
 
+signals:
+    void ResultLoaded(const QString& path);
+    void LoadFailed(const QString& path, const QString& error);
+
+private slots:
+    void OnLoadProgress(int request_id, int percent, const QString& stage);
+    void OnLoaded(int request_id, const QString& path, const AnalysisDataPtr& data);
+    void OnCoalitionsLoaded(int request_id, const CoalitionDataPtr& data);
+    void OnIterationsLoaded(int request_id, const IterationDataPtr& data);
+    void OnLoadFailed(int request_id, const QString& path, const QString& error);
+    void OnPartFailed(int request_id, AnalysisPart part, const QString& error);
+    void OnLoadCancelled(int request_id);
+
+    // 切换 Tab 时填充该面板
+    void OnTabChanged(int index);
+
+    // 空闲时填充下一个待填充的面板
+    void LoadNextIdlePanel();
+
 private:
     void SetupUI();
+    void SetLoading(bool loading);
+
+    // 显示加载请求 request_id 的摘要部分: 立即填充当前 Tab, 其余面板标记为待填充
+    void ShowResult(int request_id, const AnalysisDataPtr& data);
+
+    // 第 index 个 Tab 的面板未填充当前数据且数据已就绪时填充, 返回面板是否已是当前数据;
+    // 数据未就绪时请求加载线程准备
+    bool EnsurePanelLoaded(int index);
+
+    // 请求加载线程准备当前结果的一个部分, 同一份结果只请求一次
+    void RequestPart(AnalysisPart part);
+
+    // 部分数据到达, 失败或请求被丢弃后: 重新检查当前 Tab 和空闲填充
+    void UpdatePendingPanels();
+
+    // 当前 Tab 在等待部分数据时显示进度 (不可取消)
+    void UpdatePartProgress();
+
+    // 新文件的加载取消或失败后, 继续为仍显示的结果准备部分数据
+    void ResumePartRequests();
 
     QTabWidget* tab_widget_;
     QLabel* status_label_;
 
+    // 加载进度
+    QWidget* loading_bar_;
+    QProgressBar* loading_progress_;
+    QPushButton* loading_cancel_button_;
+    ResultLoader* loader_;
+    int loading_request_;
+
     // 子面板
     OverviewPanel* overview_panel_;
     PlantPanel* plant_panel_;
     CoalitionPanel* coalition_panel_;
     IterationPanel* iteration_panel_;
 
-    // 当前数据
-    QJsonObject current_result_;
+    // 当前数据: 摘要部分及其加载请求, 按需准备的部分 (未就绪时为空)
+    AnalysisDataPtr current_data_;
+    int data_request_;
+    CoalitionDataPtr coalitions_;
+    IterationDataPtr iterations_;
+
+    // 数据版本, 每次换数据递增; 面板记录自己填充时的版本, 不同即待填充
+    // 各部分记录请求时的版本, 同一版本不重复请求
+    int data_generation_;
+    QVector<int> panel_generation_;
+    int coalitions_requested_;
+    int iterations_requested_;
+    QTimer* idle_timer_;
 };
 
 #endif  // ANALYSIS_WIDGET_H
@@ -0,0 +1,130 @@
+// checkpoint.cpp - 求解检查点实现
+// 文件格式: 魔数 "GMCKPT01" + quint32 版本 + qCompress(QDataStream 正文)
+
+#include "checkpoint.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QSaveFile>
+
+#include <cstring>
+
+namespace {
+
+constexpr char kMagic[] = "GMCKPT01";
+constexpr int kMagicSize = 8;
+constexpr quint32 kVersion = 1;
+
+}  // namespace
+
+bool SolveCheckpoint::Apply(const QVector<SolverEvent>& events) {
+    bool changed = false;
+    for (const SolverEvent& event : events) {
+        switch (event.type) {
+        case SolverEventType::kIterationStarted:
+            iteration = event.ints[0];
+            changed = true;
+            break;
+        case SolverEventType::kMPSolved:
+            allocation = event.pi;
+            v = event.values[0];
+            changed = true;
+            break;
+        case SolverEventType::kCutAdded:
+            cuts.append({event.coalition, event.values[0]});
+            changed = true;
+            break;
+        default:
+            break;
+        }
+    }
+    return changed;
+}
+
+bool SolveCheckpoint::Save(const QString& path) {
+    saved_ms = QDateTime::currentMSecsSinceEpoch();
+
+    QByteArray body;
+    {
+        QDataStream out(&body, QIODevice::WriteOnly);
+        out.setVersion(QDataStream::Qt_6_0);
+        out << data_file << instance_key << params
+            << qint32(iteration) << v << allocation << saved_ms;
+
+        // 联盟按成员编号写出, 宽联盟也能完整还原
+        out << quint32(cuts.size());
+        for (const CutPool::Cut& cut : std::as_const(cuts)) {
+            out << cut.first.Members() << cut.second;
+        }
+    }
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream header(&file);
+    header.writeRawData(kMagic, kMagicSize);
+    header << kVersion;
+    file.write(qCompress(body));
+    return file.commit();
+}
+
+bool SolveCheckpoint::Load(const QString& path, SolveCheckpoint* checkpoint, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+
+    char magic[kMagicSize];
+    QDataStream header(&file);
+    quint32 version = 0;
+    if (header.readRawData(magic, kMagicSize) != kMagicSize
+        || std::memcmp(magic, kMagic, kMagicSize) != 0) {
+        *error = "不是检查点文件";
+        return false;
+    }
+    header >> version;
+    if (version != kVersion) {
+        *error = QString("不支持的检查点版本 %1").arg(version);
+        return false;
+    }
+
+    const QByteArray body = qUncompress(file.readAll());
+    if (body.isEmpty()) {
+        *error = "检查点数据损坏";
+        return false;
+    }
+
+    SolveCheckpoint loaded;
+    QDataStream in(body);
+    in.setVersion(QDataStream::Qt_6_0);
+    qint32 iteration = 0;
+    quint32 cut_count = 0;
+    in >> loaded.data_file >> loaded.instance_key >> loaded.params
+       >> iteration >> loaded.v >> loaded.allocation >> loaded.saved_ms >> cut_count;
+    loaded.iteration = iteration;
+
+    loaded.cuts.reserve(qMin<quint32>(cut_count, 1u << 20));
+    for (quint32 i = 0; i < cut_count && in.status() == QDataStream::Ok; ++i) {
+        QVector<int> members;
+        double cost = 0.0;
+        in >> members >> cost;
+        Coalition coalition;
+        for (int member : std::as_const(members)) {
+            if (!coalition.Add(member)) {
+                in.setStatus(QDataStream::ReadCorruptData);
+                break;
+            }
+        }
+        loaded.cuts.append({coalition, cost});
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        *error = "检查点数据不完整";
+        return false;
+    }
+    *checkpoint = loaded;
+    return true;
+}
@@ -0,0 +1,33 @@
+// checkpoint.h - 求解检查点
+// 从事件流中记录约束集, 最新分配, v 和迭代号, 定期压缩写盘; 中断的运行据此带着已有约束重新启动
+
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "cut_pool.h"
+#include "solver_event.h"
+
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+struct SolveCheckpoint {
+    QString data_file;
+    QString instance_key;      // 保存时实例文件的内容哈希
+    QVariantMap params;        // 求解参数 (不含热启动文件和按预算分配的资源)
+    int iteration = 0;         // 最近开始的迭代 (已计入之前续算的偏移)
+    double v = 0.0;
+    QVector<double> allocation;
+    QVector<CutPool::Cut> cuts;
+    qint64 saved_ms = 0;
+
+    // 按事件批次更新, 有变化时返回 true
+    bool Apply(const QVector<SolverEvent>& events);
+
+    // 写盘 (先写临时文件再替换)
+    bool Save(const QString& path);
+
+    static bool Load(const QString& path, SolveCheckpoint* checkpoint, QString* error);
+};
+
+#endif  // CHECKPOINT_H
@@ -0,0 +1,132 @@
+// coalition.cpp - 联盟 (工厂子集) 实现
+
+#include "coalition.h"
+
+#include <QHashFunctions>
+#include <QJsonArray>
+
+Coalition Coalition::Parse(QByteArrayView text) {
+    Coalition coalition;
+    int member = -1;
+    for (char c : text) {
+        if (c >= '0' && c <= '9') {
+            // 超出上限立即拒绝, 长数字串不会溢出
+            member = (member < 0 ? 0 : member * 10) + (c - '0');
+            if (member > kMaxMember) {
+                return Coalition();
+            }
+        } else if (member >= 0) {
+            coalition.Add(member);
+            member = -1;
+        }
+    }
+    if (member >= 0) {
+        coalition.Add(member);
+    }
+    return coalition;
+}
+
+Coalition Coalition::Parse(const QString& text) {
+    return Parse(QByteArrayView(text.toLatin1()));
+}
+
+Coalition Coalition::FromJson(const QJsonArray& members) {
+    Coalition coalition;
+    for (const QJsonValue& value : members) {
+        if (!coalition.Add(value.toInt(-1))) {
+            return Coalition();
+        }
+    }
+    return coalition;
+}
+
+Coalition Coalition::FromMask(quint64 mask) {
+    Coalition coalition;
+    coalition.mask_ = mask;
+    return coalition;
+}
+
+bool Coalition::Add(int member) {
+    if (member < 0 || member > kMaxMember) return false;
+
+    text_.clear();
+    if (member < 64) {
+        mask_ |= quint64(1) << member;
+        return true;
+    }
+
+    const int word = member / 64 - 1;
+    if (word >= high_.size()) {
+        high_.resize(word + 1, 0);
+    }
+    high_[word] |= quint64(1) << (member % 64);
+    return true;
+}
+
+bool Coalition::Contains(int member) const {
+    if (member < 0) return false;
+    if (member < 64) return (mask_ >> member) & 1;
+
+    const int word = member / 64 - 1;
+    return word < high_.size() && ((high_[word] >> (member % 64)) & 1);
+}
+
+bool Coalition::operator<(const Coalition& other) const {
+    // 高位字不含末尾的零字, 字数多的更大
+    if (high_.size() != other.high_.size()) {
+        return high_.size() < other.high_.size();
+    }
+    for (qsizetype word = high_.size() - 1; word >= 0; --word) {
+        if (high_[word] != other.high_[word]) {
+            return high_[word] < other.high_[word];
+        }
+    }
+    return mask_ < other.mask_;
+}
+
+int Coalition::Size() const {
+    int size = qPopulationCount(mask_);
+    for (quint64 bits : high_) {
+        size += qPopulationCount(bits);
+    }
+    return size;
+}
+
+QVector<int> Coalition::Members() const {
+    QVector<int> members;
+    members.reserve(Size());
+    ForEachMember([&members](int member) { members.append(member); });
+    return members;
+}
+
+double Coalition::Sum(const QVector<double>& values) const {
+    double sum = 0.0;
+    const int n = static_cast<int>(values.size());
+    ForEachMember([&](int member) {
+        if (member < n) sum += values[member];
+    });
+    return sum;
+}
+
+const QString& Coalition::ToString() const {
+    if (text_.isEmpty()) {
+        QString text("{");
+        bool first = true;
+        ForEachMember([&](int member) {
+            if (!first) text += ", ";
+            text += QString::number(member);
+            first = false;
+        });
+        text += '}';
+        text_ = text;
+    }
+    return text_;
+}
+
+size_t qHash(const Coalition& coalition, size_t seed) {
+    seed = qHash(coalition.mask_, seed);
+    for (quint64 bits : coalition.high_) {
+        seed = qHash(bits, seed);
+    }
+    return seed;
+}
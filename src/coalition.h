@@ -0,0 +1,91 @@
+// coalition.h - 联盟 (工厂子集)
+// 64 个工厂以内用一个位掩码表示, 更多时追加高位字; 输入时解析一次, 之后成员判断和求和都是位运算
+
+#ifndef COALITION_H
+#define COALITION_H
+
+#include <QByteArrayView>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+class QJsonArray;
+
+class Coalition {
+public:
+    Coalition() = default;
+
+    // 成员编号上限; 超出视为数据损坏, 避免一行错误输出分配大量高位字
+    static constexpr int kMaxMember = (1 << 16) - 1;
+
+    // 解析 "{0,1,2}" / "{0, 1, 2}" (只取数字, 忽略其他字符); 有成员超出上限时返回空联盟
+    static Coalition Parse(QByteArrayView text);
+    static Coalition Parse(const QString& text);
+
+    // 由结果 JSON 的成员数组构造; 有成员超出上限时返回空联盟
+    static Coalition FromJson(const QJsonArray& members);
+
+    // 由低 64 位掩码构造
+    static Coalition FromMask(quint64 mask);
+
+    // 加入成员; 编号为负或超出上限时不加入并返回 false
+    bool Add(int member);
+    bool Contains(int member) const;
+
+    // 成员数 (popcount)
+    int Size() const;
+    bool IsEmpty() const { return mask_ == 0 && high_.isEmpty(); }
+
+    // 是否有编号 >= 64 的成员
+    bool IsWide() const { return !high_.isEmpty(); }
+
+    // 低 64 位掩码
+    quint64 Mask() const { return mask_; }
+
+    // 按编号升序遍历成员
+    template <typename Fn>
+    void ForEachMember(Fn fn) const;
+
+    QVector<int> Members() const;
+
+    // 成员对应分量之和 (越界成员忽略)
+    double Sum(const QVector<double>& values) const;
+
+    // "{0, 1, 2}", 首次调用时格式化并缓存
+    const QString& ToString() const;
+
+    bool operator==(const Coalition& other) const {
+        return mask_ == other.mask_ && high_ == other.high_;
+    }
+    bool operator!=(const Coalition& other) const { return !(*this == other); }
+
+    // 把全部位字视为一个无符号大整数比较; 都只有低 64 位时与比较 Mask() 相同
+    bool operator<(const Coalition& other) const;
+
+    friend size_t qHash(const Coalition& coalition, size_t seed = 0);
+
+private:
+    quint64 mask_ = 0;
+
+    // 编号 64 及以上的成员, high_[i] 对应 [64(i+1), 64(i+2))
+    QVector<quint64> high_;
+
+    mutable QString text_;
+};
+
+template <typename Fn>
+void Coalition::ForEachMember(Fn fn) const {
+    for (int word = -1; word < static_cast<int>(high_.size()); ++word) {
+        quint64 bits = (word < 0) ? mask_ : high_[word];
+        const int base = (word + 1) * 64;
+        while (bits != 0) {
+            fn(base + qCountTrailingZeroBits(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+Q_DECLARE_METATYPE(Coalition)
+
+#endif  // COALITION_H
@@ -0,0 +1,324 @@
+// column_table_model.cpp - 只读列存储表格模型实现
+
+#include "column_table_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace {
+
+// 第 row 行的联盟: 宽联盟取完整对象, 其余由低 64 位掩码还原
+Coalition CoalitionAt(const QVector<quint64>& masks, const QHash<int, Coalition>& wide, int row) {
+    auto it = wide.constFind(row);
+    return it != wide.constEnd() ? it.value() : Coalition::FromMask(masks[row]);
+}
+
+}  // namespace
+
+// ========== ColumnTable ==========
+
+int ColumnTable::Add(const Column& column) {
+    columns_.append(column);
+    return Columns() - 1;
+}
+
+int ColumnTable::AddDouble(const QString& header, const QVector<double>& values,
+                           int precision, const QString& suffix) {
+    Column column;
+    column.kind = Kind::kDouble;
+    column.header = header;
+    column.precision = precision;
+    column.affix = suffix;
+    column.doubles = values;
+    return Add(column);
+}
+
+int ColumnTable::AddInteger(const QString& header, const QVector<int>& values,
+                            const QString& prefix) {
+    Column column;
+    column.kind = Kind::kInteger;
+    column.header = header;
+    column.affix = prefix;
+    column.integers = values;
+    return Add(column);
+}
+
+int ColumnTable::AddCoalition(const QString& header, const QVector<quint64>& masks,
+                              const QHash<int, Coalition>& wide) {
+    Column column;
+    column.kind = Kind::kCoalition;
+    column.header = header;
+    column.masks = masks;
+    column.wide = wide;
+    return Add(column);
+}
+
+int ColumnTable::AddCategory(const QString& header, const QVector<int>& codes,
+                             const QStringList& labels, const QVector<QColor>& colors) {
+    Column column;
+    column.kind = Kind::kCategory;
+    column.header = header;
+    column.integers = codes;
+    column.labels = labels;
+    column.colors = colors;
+    return Add(column);
+}
+
+QVariant ColumnTable::Data(int row, int column, int role) const {
+    const Column& col = columns_[column];
+    if (col.roles) {
+        const QVariant value = col.roles(row, role);
+        if (value.isValid()) return value;
+    }
+    if (row_roles_) {
+        const QVariant value = row_roles_(row, role);
+        if (value.isValid()) return value;
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return Text(row, column);
+    case Qt::ForegroundRole:
+        if (col.kind == Kind::kCategory && col.integers[row] >= 0 && col.integers[row] < col.colors.size()) {
+            return col.colors[col.integers[row]];
+        }
+        return QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+QString ColumnTable::Text(int row, int column) const {
+    const Column& col = columns_[column];
+    switch (col.kind) {
+    case Kind::kDouble: {
+        const double value = col.doubles[row];
+        return std::isnan(value) ? QString("-") : QString::number(value, 'f', col.precision) + col.affix;
+    }
+    case Kind::kInteger:
+        return col.affix + QString::number(col.integers[row]);
+    case Kind::kCoalition:
+        return CoalitionAt(col.masks, col.wide, row).ToString();
+    case Kind::kCategory:
+        return col.labels.value(col.integers[row]);
+    }
+    return QString();
+}
+
+bool ColumnTable::Less(int column, int a, int b) const {
+    const Column& col = columns_[column];
+    switch (col.kind) {
+    case Kind::kDouble: {
+        const double x = col.doubles[a];
+        const double y = col.doubles[b];
+        if (std::isnan(x) || std::isnan(y)) return std::isnan(x) && !std::isnan(y);
+        return x < y;
+    }
+    case Kind::kInteger:
+    case Kind::kCategory:
+        return col.integers[a] < col.integers[b];
+    case Kind::kCoalition:
+        // 有宽联盟时按完整联盟比较, 高位字不同的联盟不会按低 64 位混在一起
+        if (col.wide.isEmpty()) return col.masks[a] < col.masks[b];
+        return CoalitionAt(col.masks, col.wide, a) < CoalitionAt(col.masks, col.wide, b);
+    }
+    return false;
+}
+
+QVector<qint32> ColumnTable::Order(int column) const {
+    const Column& col = columns_[column];
+    if (col.order.size() == rows_) {
+        return col.order;
+    }
+
+    QVector<qint32> order(rows_);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this, column](qint32 a, qint32 b) {
+        return Less(column, a, b);
+    });
+    return order;
+}
+
+// ========== ColumnTableModel ==========
+
+ColumnTableModel::ColumnTableModel(QObject* parent)
+    : QAbstractTableModel(parent) {
+}
+
+int ColumnTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : table_.Rows();
+}
+
+int ColumnTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : table_.Columns();
+}
+
+QVariant ColumnTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid()) {
+        return QVariant();
+    }
+    return table_.Data(index.row(), index.column(), role);
+}
+
+QVariant ColumnTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole
+        || section < 0 || section >= table_.Columns()) {
+        return QVariant();
+    }
+    return table_.Header(section);
+}
+
+void ColumnTableModel::SetTable(const ColumnTable& table) {
+    beginResetModel();
+    table_ = table;
+    orders_.clear();
+    endResetModel();
+}
+
+void ColumnTableModel::Clear() {
+    SetTable(ColumnTable());
+}
+
+const QVector<qint32>& ColumnTableModel::Order(int column) const {
+    auto it = orders_.constFind(column);
+    if (it == orders_.constEnd()) {
+        it = orders_.insert(column, table_.Order(column));
+    }
+    return it.value();
+}
+
+// ========== ColumnSortFilterProxy ==========
+
+ColumnSortFilterProxy::ColumnSortFilterProxy(QObject* parent)
+    : QAbstractProxyModel(parent)
+    , source_(nullptr)
+    , sort_column_(-1)
+    , descending_(false)
+    , row_count_(0) {
+}
+
+void ColumnSortFilterProxy::setSourceModel(QAbstractItemModel* source) {
+    beginResetModel();
+    if (source_) {
+        disconnect(source_, nullptr, this, nullptr);
+    }
+    source_ = qobject_cast<ColumnTableModel*>(source);
+    QAbstractProxyModel::setSourceModel(source_);
+    if (source_) {
+        // 换表后保留筛选和排序列, 筛选位集由使用者随新表一起重设
+        connect(source_, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+            beginResetModel();
+        });
+        connect(source_, &QAbstractItemModel::modelReset, this, [this]() {
+            SelectRows();
+            endResetModel();
+        });
+    }
+    SelectRows();
+    endResetModel();
+}
+
+QModelIndex ColumnSortFilterProxy::index(int row, int column, const QModelIndex& parent) const {
+    if (parent.isValid() || row < 0 || row >= row_count_ || column < 0 || column >= columnCount()) {
+        return QModelIndex();
+    }
+    return createIndex(row, column);
+}
+
+QModelIndex ColumnSortFilterProxy::parent(const QModelIndex& /*child*/) const {
+    return QModelIndex();
+}
+
+int ColumnSortFilterProxy::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : row_count_;
+}
+
+int ColumnSortFilterProxy::columnCount(const QModelIndex& parent) const {
+    return (parent.isValid() || !source_) ? 0 : source_->columnCount();
+}
+
+QVariant ColumnSortFilterProxy::headerData(int section, Qt::Orientation orientation, int role) const {
+    // 列不重排, 表头直接取源模型的 (筛选后没有行时也能显示)
+    if (orientation != Qt::Horizontal || !source_) {
+        return QVariant();
+    }
+    return source_->headerData(section, orientation, role);
+}
+
+QModelIndex ColumnSortFilterProxy::mapToSource(const QModelIndex& proxy_index) const {
+    if (!proxy_index.isValid() || !source_) {
+        return QModelIndex();
+    }
+    return source_->index(SourceRow(proxy_index.row()), proxy_index.column());
+}
+
+QModelIndex ColumnSortFilterProxy::mapFromSource(const QModelIndex& source_index) const {
+    if (!source_index.isValid()) {
+        return QModelIndex();
+    }
+    if (source_to_row_.isEmpty()) {
+        source_to_row_.fill(-1, source_->rowCount());
+        for (int row = 0; row < row_count_; ++row) {
+            source_to_row_[SourceRow(row)] = row;
+        }
+    }
+    const int row = source_to_row_.value(source_index.row(), -1);
+    return row < 0 ? QModelIndex() : createIndex(row, source_index.column());
+}
+
+void ColumnSortFilterProxy::sort(int column, Qt::SortOrder order) {
+    beginResetModel();
+    sort_column_ = (source_ && column < source_->columnCount()) ? column : -1;
+    descending_ = sort_column_ >= 0 && order == Qt::DescendingOrder;
+    SelectRows();
+    endResetModel();
+}
+
+void ColumnSortFilterProxy::SetRowFilter(const QVector<quint64>& bits) {
+    beginResetModel();
+    filter_bits_ = bits;
+    SelectRows();
+    endResetModel();
+}
+
+void ColumnSortFilterProxy::SelectRows() {
+    source_to_row_.clear();
+    rows_.clear();
+    const int source_rows = source_ ? source_->rowCount() : 0;
+    if (!source_ || sort_column_ >= source_->columnCount()) {
+        sort_column_ = -1;
+        descending_ = false;
+    }
+
+    // 不筛选时直接用排序下标 (共享, 不复制)
+    if (filter_bits_.isEmpty()) {
+        if (sort_column_ >= 0) {
+            rows_ = source_->Order(sort_column_);
+        }
+        row_count_ = source_rows;
+        return;
+    }
+
+    // 位集可能来自换表之前, 超出行数的位不算
+    if (sort_column_ >= 0) {
+        for (qint32 row : source_->Order(sort_column_)) {
+            const int word = row >> 6;
+            if (word < filter_bits_.size() && ((filter_bits_[word] >> (row & 63)) & 1)) {
+                rows_.append(row);
+            }
+        }
+    } else {
+        // 逐字取出置位的行
+        for (int word = 0; word < filter_bits_.size(); ++word) {
+            quint64 bits = filter_bits_[word];
+            while (bits != 0) {
+                const int row = word * 64 + qCountTrailingZeroBits(bits);
+                if (row >= source_rows) break;
+                rows_.append(row);
+                bits &= bits - 1;
+            }
+        }
+    }
+    row_count_ = static_cast<int>(rows_.size());
+}
@@ -0,0 +1,161 @@
+// column_table_model.h - 只读列存储表格模型
+// 每列一个紧凑数组 (数值/整数/联盟/分类), 单元格显示时才格式化, 内存随列数而不是单元格数增长;
+// ColumnSortFilterProxy 按行下标筛选, 按列的排序下标排序, 不比较字符串
+
+#ifndef COLUMN_TABLE_MODEL_H
+#define COLUMN_TABLE_MODEL_H
+
+#include "coalition.h"
+
+#include <QAbstractProxyModel>
+#include <QAbstractTableModel>
+#include <QColor>
+#include <QHash>
+#include <QStringList>
+#include <QVector>
+#include <functional>
+
+class ColumnTable {
+public:
+    // 单元格的其他角色 (前景色, 背景色, 替换文本等), 返回无效值时按列数据显示
+    using RoleFn = std::function<QVariant(int row, int role)>;
+
+    explicit ColumnTable(int rows = 0) : rows_(rows) {}
+
+    int Rows() const { return rows_; }
+    int Columns() const { return static_cast<int>(columns_.size()); }
+    QString Header(int column) const { return columns_[column].header; }
+
+    // 以下各列的值个数须等于行数, 返回列号
+    // 数值列: precision 位小数, suffix 接在数值后 (如 "%"); NaN 显示为 "-"
+    int AddDouble(const QString& header, const QVector<double>& values,
+                  int precision, const QString& suffix = QString());
+
+    // 整数列: prefix 接在数值前 (如 "工厂 ")
+    int AddInteger(const QString& header, const QVector<int>& values,
+                   const QString& prefix = QString());
+
+    // 联盟列: 低 64 位掩码, 成员编号超过 63 的联盟另存完整对象
+    int AddCoalition(const QString& header, const QVector<quint64>& masks,
+                     const QHash<int, Coalition>& wide = QHash<int, Coalition>());
+
+    // 分类列: 每行一个代码, 显示 labels[代码], 有 colors 时作为前景色; 按代码排序
+    int AddCategory(const QString& header, const QVector<int>& codes,
+                    const QStringList& labels, const QVector<QColor>& colors = QVector<QColor>());
+
+    void SetColumnRoles(int column, const RoleFn& roles) { columns_[column].roles = roles; }
+
+    // 整行的角色 (如高亮背景), 列自己的角色优先
+    void SetRowRoles(const RoleFn& roles) { row_roles_ = roles; }
+
+    // 预先排好的升序行下标 (如在加载线程上算好), 没有时首次按该列排序时计算
+    void SetOrder(int column, const QVector<qint32>& order) { columns_[column].order = order; }
+
+    QVariant Data(int row, int column, int role) const;
+    QString Text(int row, int column) const;
+
+    // 按列值比较两行 (NaN 最小)
+    bool Less(int column, int a, int b) const;
+
+    // 按列升序的行下标 (相同值保持行序)
+    QVector<qint32> Order(int column) const;
+
+private:
+    enum class Kind { kDouble, kInteger, kCoalition, kCategory };
+
+    struct Column {
+        Kind kind = Kind::kDouble;
+        QString header;
+        int precision = 2;
+        QString affix;                  // 数值列的后缀, 整数列的前缀
+        QVector<double> doubles;
+        QVector<int> integers;          // kInteger / kCategory
+        QVector<quint64> masks;
+        QHash<int, Coalition> wide;
+        QStringList labels;
+        QVector<QColor> colors;
+        RoleFn roles;
+        QVector<qint32> order;
+    };
+
+    int Add(const Column& column);
+
+    int rows_;
+    QVector<Column> columns_;
+    RoleFn row_roles_;
+};
+
+class ColumnTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit ColumnTableModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    // 整表替换 (共享列数据, 不复制), 清空缓存的排序下标
+    void SetTable(const ColumnTable& table);
+    const ColumnTable& Table() const { return table_; }
+
+    void Clear();
+
+    // 按列升序的行下标, 首次使用时取出并缓存
+    const QVector<qint32>& Order(int column) const;
+
+private:
+    ColumnTable table_;
+    mutable QHash<int, QVector<qint32>> orders_;
+};
+
+// 只跟随 ColumnTableModel 的整表重置 (模型只读, 没有行级变化)
+class ColumnSortFilterProxy : public QAbstractProxyModel {
+    Q_OBJECT
+
+public:
+    explicit ColumnSortFilterProxy(QObject* parent = nullptr);
+
+    void setSourceModel(QAbstractItemModel* source) override;
+
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& child) const override;
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+    QModelIndex mapToSource(const QModelIndex& proxy_index) const override;
+    QModelIndex mapFromSource(const QModelIndex& source_index) const override;
+
+    // column < 0 恢复源模型的行序
+    void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+    // 按位集筛选行 (第 i 位对应源模型第 i 行), 空表示不筛选
+    void SetRowFilter(const QVector<quint64>& bits);
+
+private:
+    // 显示行 -> 源模型行
+    int SourceRow(int row) const {
+        const int position = descending_ ? row_count_ - 1 - row : row;
+        return rows_.isEmpty() ? position : rows_[position];
+    }
+
+    // 按当前筛选和排序重新取出行下标 (一次线性扫描)
+    void SelectRows();
+
+    ColumnTableModel* source_;
+    QVector<quint64> filter_bits_;
+    int sort_column_;
+    bool descending_;
+
+    // 未筛选且未排序时为空, 按源模型行序 (筛选后没有行时 row_count_ 为 0, 不会取下标)
+    QVector<qint32> rows_;
+    int row_count_;
+
+    // 源模型行 -> 显示行, 首次 mapFromSource 时建立
+    mutable QVector<qint32> source_to_row_;
+};
+
+#endif  // COLUMN_TABLE_MODEL_H
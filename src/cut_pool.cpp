@@ -0,0 +1,164 @@
+// cut_pool.cpp - 联盟约束池实现
+// 池文件为文本: 首行 "# data_file: 路径", 之后每行 "{0, 1, 2}:成本", 与求解器 [CUT:...] 输出一致
+
+#include "cut_pool.h"
+#include "file_hash.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QTextStream>
+
+namespace {
+
+constexpr char kPoolSuffix[] = ".cuts";
+constexpr char kDataFileHeader[] = "# data_file: ";
+
+QString ReadDataFileHeader(const QString& pool_path) {
+    QFile file(pool_path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        return QString();
+    }
+    const QString first = QString::fromUtf8(file.readLine()).trimmed();
+    return first.startsWith(kDataFileHeader) ? first.mid(qstrlen(kDataFileHeader)) : QString();
+}
+
+}  // namespace
+
+CutPool::CutPool(const QString& root)
+    : root_(root) {
+}
+
+QString CutPool::InstanceKey(const QString& data_file) {
+    // 与结果缓存共用按大小和修改时间缓存的哈希, 同一实例不重复读盘
+    return QString::fromLatin1(FileHash::Sha256(data_file).toHex());
+}
+
+QString CutPool::PoolPath(const QString& instance_key) const {
+    return QDir(root_).filePath(instance_key + kPoolSuffix);
+}
+
+QHash<Coalition, double>* CutPool::Load(const QString& instance_key) {
+    auto it = pools_.find(instance_key);
+    if (it != pools_.end()) {
+        return &it.value();
+    }
+
+    QHash<Coalition, double>& pool = pools_[instance_key];
+    QFile file(PoolPath(instance_key));
+    if (file.open(QIODevice::ReadOnly)) {
+        while (!file.atEnd()) {
+            const QByteArray line = file.readLine().trimmed();
+            if (line.isEmpty() || line.startsWith('#')) continue;
+            const qsizetype colon = line.lastIndexOf(':');
+            if (colon <= 0) continue;
+            bool ok = false;
+            const double cost = line.mid(colon + 1).toDouble(&ok);
+            const Coalition coalition = Coalition::Parse(QByteArrayView(line).first(colon));
+            if (ok && !coalition.IsEmpty()) {
+                pool.insert(coalition, cost);
+            }
+        }
+    }
+    return &pool;
+}
+
+bool CutPool::Save(const QString& instance_key, const QString& data_file) {
+    if (!QDir().mkpath(root_)) {
+        return false;
+    }
+
+    // 先写临时文件再替换, 中途退出不会留下残缺的池
+    QSaveFile file(PoolPath(instance_key));
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << kDataFileHeader << QFileInfo(data_file).absoluteFilePath() << "\n";
+    const QHash<Coalition, double>& pool = pools_[instance_key];
+    for (auto it = pool.cbegin(); it != pool.cend(); ++it) {
+        out << it.key().ToString() << ":" << QString::number(it.value(), 'g', 17) << "\n";
+    }
+    out.flush();
+    return file.commit();
+}
+
+int CutPool::Add(const QString& instance_key, const QString& data_file, const QVector<Cut>& cuts) {
+    if (instance_key.isEmpty() || cuts.isEmpty()) return 0;
+
+    QHash<Coalition, double>* pool = Load(instance_key);
+    int added = 0;
+    for (const Cut& cut : cuts) {
+        if (cut.first.IsEmpty()) continue;
+        if (!pool->contains(cut.first)) {
+            ++added;
+        }
+        pool->insert(cut.first, cut.second);
+    }
+    Save(instance_key, data_file);
+    return added;
+}
+
+int CutPool::Count(const QString& instance_key) {
+    return instance_key.isEmpty() ? 0 : static_cast<int>(Load(instance_key)->size());
+}
+
+QString CutPool::FindPoolByPath(const QString& data_file) const {
+    const QString abs_path = QFileInfo(data_file).absoluteFilePath();
+    const QFileInfoList files = QDir(root_).entryInfoList(
+        {QString("*") + kPoolSuffix}, QDir::Files, QDir::Time);
+    for (const QFileInfo& info : files) {
+        if (ReadDataFileHeader(info.absoluteFilePath()) == abs_path) {
+            return info.completeBaseName();
+        }
+    }
+    return QString();
+}
+
+CutPool::WarmStart CutPool::WriteWarmStart(const QString& instance_key, const QString& data_file,
+                                           const QString& out_path, int* count) {
+    *count = 0;
+
+    // 优先使用同一实例的池, 否则退回同一路径的旧版本实例
+    WarmStart mode = WarmStart::kExact;
+    QString source = instance_key;
+    if (Count(source) == 0) {
+        source = FindPoolByPath(data_file);
+        if (source.isEmpty() || source == instance_key || Count(source) == 0) {
+            return WarmStart::kNone;
+        }
+        mode = WarmStart::kCoalitions;
+    }
+
+    const QHash<Coalition, double>& pool = *Load(source);
+    QVector<Cut> cuts;
+    cuts.reserve(pool.size());
+    for (auto it = pool.cbegin(); it != pool.cend(); ++it) {
+        cuts.append({it.key(), it.value()});
+    }
+
+    // 实例改动后旧成本不再成立, 只给出联盟
+    if (!WriteCutsFile(out_path, cuts, mode == WarmStart::kExact)) {
+        return WarmStart::kNone;
+    }
+    *count = static_cast<int>(cuts.size());
+    return mode;
+}
+
+bool CutPool::WriteCutsFile(const QString& path, const QVector<Cut>& cuts, bool with_costs) {
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    for (const Cut& cut : cuts) {
+        out << cut.first.ToString();
+        if (with_costs) {
+            out << ":" << QString::number(cut.second, 'g', 17);
+        }
+        out << "\n";
+    }
+    out.flush();
+    return file.commit();
+}
@@ -0,0 +1,57 @@
+// cut_pool.h - 联盟约束池
+// 按实例文件内容哈希保存历次运行发现的 (联盟, c(S)), 为下一次运行写出初始约束文件 (--cuts-file)
+
+#ifndef CUT_POOL_H
+#define CUT_POOL_H
+
+#include "coalition.h"
+
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+class CutPool {
+public:
+    using Cut = QPair<Coalition, double>;
+
+    // 热启动文件的来源
+    enum class WarmStart {
+        kNone,        // 没有可用的约束
+        kExact,       // 同一实例: 联盟和成本都可直接使用
+        kCoalitions   // 同一路径但内容已改动的实例: 只给出联盟, 成本由求解器重算
+    };
+
+    explicit CutPool(const QString& root);
+
+    // 实例键 (文件内容哈希, 见 FileHash), 文件无法读取时返回空串
+    static QString InstanceKey(const QString& data_file);
+
+    // 合并一批约束到实例的约束池 (同一联盟保留最新成本), 返回新增条数
+    int Add(const QString& instance_key, const QString& data_file, const QVector<Cut>& cuts);
+
+    // 实例池中的约束条数
+    int Count(const QString& instance_key);
+
+    // 写出初始约束文件: 每行 "联盟:成本", with_costs 为 false 时只写联盟
+    static bool WriteCutsFile(const QString& path, const QVector<Cut>& cuts, bool with_costs);
+
+    // 为 data_file 写出初始约束文件, 写入条数存入 count
+    WarmStart WriteWarmStart(const QString& instance_key, const QString& data_file,
+                             const QString& out_path, int* count);
+
+private:
+    QString PoolPath(const QString& instance_key) const;
+
+    // 载入实例池 (首次访问时读盘)
+    QHash<Coalition, double>* Load(const QString& instance_key);
+    bool Save(const QString& instance_key, const QString& data_file);
+
+    // 同一路径的实例最近一次保存的约束池, 没有时返回空串
+    QString FindPoolByPath(const QString& data_file) const;
+
+    QString root_;
+    QHash<QString, QHash<Coalition, double>> pools_;
+};
+
+#endif  // CUT_POOL_H
@@ -0,0 +1,120 @@
+// cut_store.cpp - 结果约束的列存储实现
+
+#include "cut_store.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+// 松弛量低于此值为违反约束
+constexpr double kViolationTolerance = 1e-6;
+
+// 松弛量绝对值低于此值为紧约束
+constexpr double kTightTolerance = 1e-4;
+
+int PopCount(const QVector<quint64>& bits) {
+    int count = 0;
+    for (quint64 word : bits) {
+        count += qPopulationCount(word);
+    }
+    return count;
+}
+
+void SetBit(QVector<quint64>* bits, int cut) {
+    (*bits)[cut >> 6] |= quint64(1) << (cut & 63);
+}
+
+}  // namespace
+
+// ========== CutStore ==========
+
+void CutStore::Reserve(int count) {
+    masks_.reserve(count);
+    iterations_.reserve(count);
+    sizes_.reserve(count);
+    costs_.reserve(count);
+}
+
+void CutStore::Append(int iteration, const Coalition& coalition, double cost) {
+    if (coalition.IsWide()) {
+        wide_coalitions_.insert(Count(), coalition);
+    }
+    masks_.append(coalition.Mask());
+    iterations_.append(iteration);
+    sizes_.append(coalition.Size());
+    costs_.append(cost);
+}
+
+void CutStore::Finish(const QVector<double>& allocation, double v_star) {
+    const int count = Count();
+
+    alloc_sums_.resize(count);
+    slacks_.resize(count);
+    violated_.fill(0, (count + 63) / 64);
+    tight_.fill(0, (count + 63) / 64);
+    for (int i = 0; i < count; ++i) {
+        alloc_sums_[i] = CoalitionAt(i).Sum(allocation);
+        slacks_[i] = costs_[i] + v_star - alloc_sums_[i];
+        if (slacks_[i] < -kViolationTolerance) {
+            SetBit(&violated_, i);
+        }
+        if (qAbs(slacks_[i]) < kTightTolerance) {
+            SetBit(&tight_, i);
+        }
+    }
+
+    // 各列的升序下标, 稳定排序使相同键保持加入顺序
+    QVector<qint32> identity(count);
+    std::iota(identity.begin(), identity.end(), 0);
+    auto build = [&](SortKey key, auto less) {
+        QVector<qint32>& order = orders_[static_cast<int>(key)];
+        order = identity;
+        std::stable_sort(order.begin(), order.end(), less);
+    };
+    build(SortKey::kIteration, [this](qint32 a, qint32 b) { return iterations_[a] < iterations_[b]; });
+    build(SortKey::kCoalition, [this](qint32 a, qint32 b) {
+        // 有宽联盟时按完整联盟比较, 否则高位不同的联盟会按低 64 位混在一起
+        if (wide_coalitions_.isEmpty()) return masks_[a] < masks_[b];
+        return CoalitionAt(a) < CoalitionAt(b);
+    });
+    build(SortKey::kSize, [this](qint32 a, qint32 b) { return sizes_[a] < sizes_[b]; });
+    build(SortKey::kCost, [this](qint32 a, qint32 b) { return costs_[a] < costs_[b]; });
+    build(SortKey::kAllocSum, [this](qint32 a, qint32 b) { return alloc_sums_[a] < alloc_sums_[b]; });
+    build(SortKey::kSlack, [this](qint32 a, qint32 b) { return slacks_[a] < slacks_[b]; });
+}
+
+void CutStore::Clear() {
+    *this = CutStore();
+}
+
+Coalition CutStore::CoalitionAt(int cut) const {
+    auto wide = wide_coalitions_.constFind(cut);
+    return wide != wide_coalitions_.constEnd() ? wide.value() : Coalition::FromMask(masks_[cut]);
+}
+
+QVector<quint64> CutStore::FilterBits(Filter filter) const {
+    switch (filter) {
+    case Filter::kViolated:
+        return violated_;
+    case Filter::kTight:
+        return tight_;
+    default:
+        return QVector<quint64>();
+    }
+}
+
+int CutStore::FilteredCount(Filter filter) const {
+    return filter == Filter::kAll ? Count() : PopCount(FilterBits(filter));
+}
+
+int CutStore::TightCount(Filter filter) const {
+    if (filter != Filter::kViolated) {
+        return PopCount(tight_);
+    }
+    int count = 0;
+    for (int w = 0; w < tight_.size(); ++w) {
+        count += qPopulationCount(tight_[w] & violated_[w]);
+    }
+    return count;
+}
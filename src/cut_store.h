@@ -0,0 +1,82 @@
+// cut_store.h - 结果约束的列存储
+// 每份结果构建一次 (在加载线程上): 掩码/规模/成本/分配之和/松弛量/迭代各一列, 每列预先排好序的下标, 违反和紧约束各一个位集;
+// 联盟面板以这些列和下标构建 ColumnTable, 切换筛选或排序只是换一个下标视图, 不重建表格
+
+#ifndef CUT_STORE_H
+#define CUT_STORE_H
+
+#include "coalition.h"
+
+#include <QHash>
+#include <QVector>
+
+class CutStore {
+public:
+    enum class Filter { kAll = 0, kViolated = 1, kTight = 2 };
+
+    // 排序键, 与表格的列一一对应
+    enum class SortKey { kIteration = 0, kCoalition = 1, kSize = 2, kCost = 3, kAllocSum = 4, kSlack = 5 };
+    static constexpr int kSortKeyCount = 6;
+
+    void Reserve(int count);
+    void Append(int iteration, const Coalition& coalition, double cost);
+
+    // 全部约束加入后调用: 按最终分配计算分配之和与松弛量, 建立位集和各列的排序下标
+    void Finish(const QVector<double>& allocation, double v_star);
+
+    void Clear();
+
+    int Count() const { return static_cast<int>(costs_.size()); }
+
+    int Iteration(int cut) const { return iterations_[cut]; }
+    int Size(int cut) const { return sizes_[cut]; }
+    double Cost(int cut) const { return costs_[cut]; }
+    double AllocSum(int cut) const { return alloc_sums_[cut]; }
+    double Slack(int cut) const { return slacks_[cut]; }
+    Coalition CoalitionAt(int cut) const;
+
+    // 整列
+    const QVector<quint64>& Masks() const { return masks_; }
+    const QHash<int, Coalition>& WideCoalitions() const { return wide_coalitions_; }
+    const QVector<qint32>& Iterations() const { return iterations_; }
+    const QVector<qint32>& Sizes() const { return sizes_; }
+    const QVector<double>& Costs() const { return costs_; }
+    const QVector<double>& AllocSums() const { return alloc_sums_; }
+    const QVector<double>& Slacks() const { return slacks_; }
+
+    // 松弛量 < -1e-6 为违反, |松弛量| < 1e-4 为紧 (两者可同时成立)
+    bool IsViolated(int cut) const { return TestBit(violated_, cut); }
+    bool IsTight(int cut) const { return TestBit(tight_, cut); }
+
+    // 筛选位集 (第 i 位对应第 i 条约束), kAll 为空
+    QVector<quint64> FilterBits(Filter filter) const;
+
+    // 满足筛选条件的约束数, 及其中的紧约束数
+    int FilteredCount(Filter filter) const;
+    int TightCount(Filter filter) const;
+
+    // 按 key 升序的全部存储下标 (相同时按加入顺序)
+    const QVector<qint32>& Order(SortKey key) const { return orders_[static_cast<int>(key)]; }
+
+private:
+    static bool TestBit(const QVector<quint64>& bits, int cut) {
+        return (bits[cut >> 6] >> (cut & 63)) & 1;
+    }
+
+    // 成员编号超过 63 的联盟另存完整对象
+    QVector<quint64> masks_;
+    QHash<int, Coalition> wide_coalitions_;
+
+    QVector<qint32> iterations_;
+    QVector<qint32> sizes_;
+    QVector<double> costs_;
+    QVector<double> alloc_sums_;
+    QVector<double> slacks_;
+
+    QVector<quint64> violated_;
+    QVector<quint64> tight_;
+
+    QVector<qint32> orders_[kSortKeyCount];
+};
+
+#endif  // CUT_STORE_H
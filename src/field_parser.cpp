@@ -0,0 +1,63 @@
+// field_parser.cpp - 状态码数值字段解析实现
+
+#include "field_parser.h"
+
+#include <charconv>
+#include <limits>
+
+namespace {
+
+// from_chars 不接受前导 '+', 手动跳过
+const char* SkipPlus(const char* first, const char* last) {
+    if (first != last && *first == '+' && first + 1 != last && first[1] != '-') {
+        return first + 1;
+    }
+    return first;
+}
+
+}  // namespace
+
+bool ParseIntField(QByteArrayView field, int* out) {
+    const char* last = field.data() + field.size();
+    const char* first = SkipPlus(field.data(), last);
+    if (first == last) return false;
+
+    const std::from_chars_result r = std::from_chars(first, last, *out);
+    return r.ec == std::errc() && r.ptr == last;
+}
+
+bool ParseDoubleField(QByteArrayView field, double* out) {
+    const char* last = field.data() + field.size();
+    const char* first = SkipPlus(field.data(), last);
+    if (first == last) return false;
+
+    const std::from_chars_result r =
+        std::from_chars(first, last, *out, std::chars_format::general);
+    return r.ec == std::errc() && r.ptr == last;
+}
+
+int ParseDoubleList(QByteArrayView payload, char sep, QVector<double>* out) {
+    int errors = 0;
+    qsizetype count = 0;
+    qsizetype start = 0;
+
+    for (qsizetype i = 0; i <= payload.size(); ++i) {
+        if (i != payload.size() && payload[i] != sep) continue;
+
+        double value = 0.0;
+        if (!ParseDoubleField(payload.sliced(start, i - start), &value)) {
+            value = std::numeric_limits<double>::quiet_NaN();
+            ++errors;
+        }
+        if (count < out->size()) {
+            (*out)[count] = value;
+        } else {
+            out->append(value);
+        }
+        ++count;
+        start = i + 1;
+    }
+
+    out->resize(count);
+    return errors;
+}
@@ -0,0 +1,20 @@
+// field_parser.h - 状态码数值字段解析
+// 基于 std::from_chars, 直接读取原始字节, 不分配内存
+
+#ifndef FIELD_PARSER_H
+#define FIELD_PARSER_H
+
+#include <QByteArrayView>
+#include <QVector>
+
+// 解析整数字段 (允许前导 '+')
+bool ParseIntField(QByteArrayView field, int* out);
+
+// 解析浮点字段, 支持完整 double 语法: 符号, 小数, 指数, inf, nan
+bool ParseDoubleField(QByteArrayView field, double* out);
+
+// 解析以 sep 分隔的浮点序列, 原地写入复用缓冲区 out (不收缩容量)
+// 格式错误的字段写入 NaN 并计数, 返回格式错误字段数
+int ParseDoubleList(QByteArrayView payload, char sep, QVector<double>* out);
+
+#endif  // FIELD_PARSER_H
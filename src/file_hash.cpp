@@ -0,0 +1,69 @@
+// file_hash.cpp - 文件内容哈希实现
+
+#include "file_hash.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace {
+
+// 逐块读取文件计算哈希
+constexpr qint64 kHashBlockSize = 1 << 20;
+
+struct HashedFile {
+    qint64 size = 0;
+    QDateTime modified;
+    QByteArray hash;
+};
+
+// 进程内缓存, 哈希本身在锁外计算
+struct HashCache {
+    QMutex mutex;
+    QHash<QString, HashedFile> files;
+};
+
+HashCache& Cache() {
+    static HashCache cache;
+    return cache;
+}
+
+}  // namespace
+
+QByteArray FileHash::Sha256(const QString& path) {
+    const QFileInfo info(path);
+    if (!info.isFile()) {
+        return QByteArray();
+    }
+
+    HashCache& cache = Cache();
+    const QString abs_path = info.absoluteFilePath();
+    {
+        QMutexLocker locker(&cache.mutex);
+        auto it = cache.files.constFind(abs_path);
+        if (it != cache.files.cend() && it->size == info.size() && it->modified == info.lastModified()) {
+            return it->hash;
+        }
+    }
+
+    QFile file(abs_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    while (!file.atEnd()) {
+        hash.addData(file.read(kHashBlockSize));
+    }
+
+    HashedFile hashed;
+    hashed.size = info.size();
+    hashed.modified = info.lastModified();
+    hashed.hash = hash.result();
+    QMutexLocker locker(&cache.mutex);
+    cache.files.insert(abs_path, hashed);
+    return hashed.hash;
+}
@@ -0,0 +1,17 @@
+// file_hash.h - 文件内容哈希
+// 逐块计算 SHA-256, 按 (路径, 大小, 修改时间) 在进程内缓存; 结果缓存和约束池共用
+
+#ifndef FILE_HASH_H
+#define FILE_HASH_H
+
+#include <QByteArray>
+#include <QString>
+
+class FileHash {
+public:
+    // 文件内容的 SHA-256 (原始字节), 文件无法读取时返回空
+    // 可在任意线程调用; 未改动的文件直接取缓存, 大文件首次计算较慢
+    static QByteArray Sha256(const QString& path);
+};
+
+#endif  // FILE_HASH_H
@@ -0,0 +1,330 @@
+// job_queue.cpp - 求解任务队列实现
+
+#include "job_queue.h"
+#include "solver_supervisor.h"
+
+#include <QDateTime>
+#include <QThread>
+#include <algorithm>
+
+namespace {
+
+// 默认每个任务至少分得的线程数
+constexpr int kDefaultMinThreads = 4;
+
+// 有内存预算时每个任务至少分得的内存 (MB)
+constexpr int kMinJobMemoryMb = 512;
+
+// 按运行分配的参数: 启动时由 StartJob 按预算加入的资源份额/限制/日志路径,
+// 入队时由界面加入的结果目录, 热启动约束, 续算偏移, 以及界面批次窗口, 日志压缩和后台标记
+// 新增这类参数时同时加在这里, 否则同一实例和设置的结果无法命中缓存
+const char* const kRunParams[] = {
+    "cplex_threads", "cplex_memory",
+    "limit_cpu_cores", "limit_memory_mb", "cpu_affinity", "nice",
+    "log_file", "log_compress", "result_dir",
+    "cuts_file", "iteration_offset",
+    "batch_min_ms", "batch_max_ms", "background",
+};
+
+}  // namespace
+
+JobQueue::JobQueue(SolverSupervisor* supervisor, QObject* parent)
+    : QObject(parent)
+    , supervisor_(supervisor)
+    , budget_(DefaultBudget())
+    , next_job_id_(1)
+    , schedule_pending_(false)
+    , used_cores_(0)
+    , used_memory_mb_(0) {
+    connect(supervisor_, &SolverSupervisor::EventsReady, this, &JobQueue::OnEvents);
+    connect(supervisor_, &SolverSupervisor::Finished, this, &JobQueue::OnFinished);
+    connect(supervisor_, &SolverSupervisor::ResourceSampled, this, &JobQueue::OnResourceSampled);
+    connect(supervisor_, &SolverSupervisor::ResourceUsageReady, this, &JobQueue::OnResourceUsage);
+}
+
+ResourceBudget JobQueue::DefaultBudget() {
+    ResourceBudget budget;
+    budget.cores = qMax(1, QThread::idealThreadCount());
+    budget.memory_mb = 0;
+    budget.min_threads = qMin(kDefaultMinThreads, budget.cores);
+    budget.max_jobs = qMax(1, budget.cores / budget.min_threads);
+    return budget;
+}
+
+bool JobQueue::IsRunParam(const QString& key) {
+    return std::any_of(std::begin(kRunParams), std::end(kRunParams),
+                       [&key](const char* param) { return key == QLatin1String(param); });
+}
+
+void JobQueue::SetBudget(const ResourceBudget& budget) {
+    budget_ = budget;
+    budget_.cores = qMax(1, budget_.cores);
+    budget_.memory_mb = qMax(0, budget_.memory_mb);
+    budget_.max_jobs = qMax(1, budget_.max_jobs);
+    budget_.min_threads = qBound(1, budget_.min_threads, budget_.cores);
+    budget_.background_nice = qBound(0, budget_.background_nice, 19);
+    RequestSchedule();
+}
+
+void JobQueue::SetSampleInterval(int interval_ms) {
+    supervisor_->SetSampleInterval(interval_ms);
+}
+
+int JobQueue::Enqueue(const QString& solver_path, const QString& data_file,
+                      const QVariantMap& params, const QString& log_file, bool held) {
+    SolveJob job;
+    job.id = next_job_id_++;
+    job.solver_path = solver_path;
+    job.data_file = data_file;
+    job.params = params;
+    job.log_file = log_file;
+    job.held = held;
+    jobs_.append(job);
+
+    emit JobAdded(job.id);
+    if (!held) {
+        RequestSchedule();
+    }
+    return job.id;
+}
+
+void JobQueue::Release(int job_id, const QVariantMap& params) {
+    SolveJob* job = FindJob(job_id);
+    if (!job || job->state != JobState::kQueued || !job->held) return;
+
+    for (auto it = params.cbegin(); it != params.cend(); ++it) {
+        job->params.insert(it.key(), it.value());
+    }
+    job->held = false;
+    RequestSchedule();
+}
+
+void JobQueue::Cancel(int job_id) {
+    SolveJob* job = FindJob(job_id);
+    if (!job) return;
+
+    if (job->state == JobState::kQueued) {
+        job->state = JobState::kCancelled;
+        job->failure = FailureReason::kCancelled;
+        job->message = "用户取消";
+        job->finished_ms = QDateTime::currentMSecsSinceEpoch();
+        emit JobChanged(job_id);
+        emit JobFinished(job_id);
+    } else if (job->state == JobState::kRunning) {
+        job->cancel_requested = true;
+        supervisor_->Cancel(job->run_id);
+    }
+}
+
+void JobQueue::CancelAll() {
+    // 先取消排队任务, 避免运行中的任务结束后又启动新任务
+    QVector<int> queued;
+    QVector<int> running;
+    for (const SolveJob& job : std::as_const(jobs_)) {
+        if (job.state == JobState::kQueued) {
+            queued.append(job.id);
+        } else if (job.state == JobState::kRunning) {
+            running.append(job.id);
+        }
+    }
+    for (int job_id : queued + running) {
+        Cancel(job_id);
+    }
+}
+
+void JobQueue::RemoveFinished() {
+    const auto it = std::remove_if(jobs_.begin(), jobs_.end(),
+        [](const SolveJob& job) { return !job.IsActive(); });
+    if (it == jobs_.end()) return;
+
+    jobs_.erase(it, jobs_.end());
+    emit JobsRemoved();
+}
+
+const SolveJob* JobQueue::Job(int job_id) const {
+    for (const SolveJob& job : jobs_) {
+        if (job.id == job_id) return &job;
+    }
+    return nullptr;
+}
+
+SolveJob* JobQueue::FindJob(int job_id) {
+    return const_cast<SolveJob*>(std::as_const(*this).Job(job_id));
+}
+
+int JobQueue::RunningCount() const {
+    return static_cast<int>(std::count_if(jobs_.cbegin(), jobs_.cend(),
+        [](const SolveJob& job) { return job.state == JobState::kRunning; }));
+}
+
+int JobQueue::QueuedCount() const {
+    return static_cast<int>(std::count_if(jobs_.cbegin(), jobs_.cend(),
+        [](const SolveJob& job) { return job.state == JobState::kQueued; }));
+}
+
+void JobQueue::RequestSchedule() {
+    // 推迟到事件循环: 同一轮加入的一批任务一起平分资源, 而不是第一个任务独占全部空闲核心
+    if (schedule_pending_) return;
+    schedule_pending_ = true;
+    QMetaObject::invokeMethod(this, [this]() {
+        schedule_pending_ = false;
+        Schedule();
+    }, Qt::QueuedConnection);
+}
+
+void JobQueue::Schedule() {
+    int running = RunningCount();
+    int queued = static_cast<int>(std::count_if(jobs_.cbegin(), jobs_.cend(),
+        [](const SolveJob& job) { return job.state == JobState::kQueued && !job.held; }));
+
+    for (SolveJob& job : jobs_) {
+        if (queued == 0 || running >= budget_.max_jobs) break;
+        if (job.state != JobState::kQueued || job.held) continue;
+
+        // 剩余资源在本轮可启动的任务间平分, 单个任务不超过预算按 max_jobs 均分的份额
+        // (之后加入的任务不必等它结束); 没有任务运行时至少启动一个
+        const int slots = qMin(budget_.max_jobs - running, queued);
+        const int free_cores = budget_.cores - used_cores_;
+        if (running > 0 && free_cores < budget_.min_threads) break;
+        const int core_share = budget_.cores / budget_.max_jobs;
+        const int threads = qMax(qMin(budget_.min_threads, budget_.cores),
+                                 qMin(core_share, free_cores / slots));
+
+        int memory_mb = 0;
+        if (budget_.memory_mb > 0) {
+            // 每个任务至少 kMinJobMemoryMb, 整个预算更小时以预算为准; 分得的内存不超过剩余内存
+            const int min_memory = qMin(kMinJobMemoryMb, budget_.memory_mb);
+            const int free_memory = budget_.memory_mb - used_memory_mb_;
+            if (free_memory <= 0 || (running > 0 && free_memory < min_memory)) break;
+            const int memory_share = budget_.memory_mb / budget_.max_jobs;
+            memory_mb = qMin(free_memory, qMax(min_memory, qMin(memory_share, free_memory / slots)));
+        }
+
+        StartJob(&job, threads, memory_mb);
+        ++running;
+        --queued;
+    }
+}
+
+void JobQueue::StartJob(SolveJob* job, int threads, int memory_mb) {
+    job->state = JobState::kRunning;
+    job->threads = threads;
+    job->memory_mb = memory_mb;
+    job->started_ms = QDateTime::currentMSecsSinceEpoch();
+    used_cores_ += threads;
+    used_memory_mb_ += memory_mb;
+
+    // 绑定 CPU: 从空闲的逻辑 CPU 中依次取, 预算改小后不够时只绑定取到的部分
+    job->cpus.clear();
+    if (budget_.pin_cpus) {
+        if (cpu_used_.size() < budget_.cores) {
+            cpu_used_.resize(budget_.cores);
+        }
+        for (int cpu = 0; cpu < budget_.cores && job->cpus.size() < threads; ++cpu) {
+            if (!cpu_used_[cpu]) {
+                cpu_used_[cpu] = true;
+                job->cpus.append(cpu);
+            }
+        }
+    }
+
+    QVariantMap params = job->params;
+    params["cplex_threads"] = threads;
+    if (memory_mb > 0) {
+        params["cplex_memory"] = memory_mb;
+    }
+    if (budget_.enforce_limits) {
+        params["limit_cpu_cores"] = threads;
+        if (memory_mb > 0) {
+            params["limit_memory_mb"] = memory_mb;
+        }
+    }
+    if (!job->cpus.isEmpty()) {
+        QVariantList cpus;
+        for (int cpu : std::as_const(job->cpus)) {
+            cpus.append(cpu);
+        }
+        params["cpu_affinity"] = cpus;
+    }
+    if (budget_.background_nice > 0 && job->params.value("background").toBool()) {
+        params["nice"] = budget_.background_nice;
+    }
+    if (!job->log_file.isEmpty()) {
+        params["log_file"] = job->log_file;
+    }
+
+    job->run_id = supervisor_->Start(job->solver_path, job->data_file, params);
+    run_to_job_.insert(job->run_id, job->id);
+    emit JobChanged(job->id);
+}
+
+void JobQueue::OnEvents(int run_id, const QVector<SolverEvent>& events) {
+    const int job_id = run_to_job_.value(run_id);
+    SolveJob* job = FindJob(job_id);
+    if (!job) return;
+
+    // 只记录队列面板显示的进度
+    for (const SolverEvent& event : events) {
+        switch (event.type) {
+        case SolverEventType::kIterationStarted:
+            job->iteration = event.ints[0];
+            break;
+        case SolverEventType::kMPSolved:
+            job->v = event.values[0];
+            break;
+        case SolverEventType::kCutAdded:
+            ++job->cuts;
+            break;
+        default:
+            break;
+        }
+    }
+
+    emit JobChanged(job_id);
+    emit JobEvents(job_id, events);
+}
+
+void JobQueue::OnResourceSampled(int run_id, const ResourceSample& sample) {
+    const int job_id = run_to_job_.value(run_id);
+    SolveJob* job = FindJob(job_id);
+    if (!job) return;
+
+    job->resources.append(sample);
+    emit JobChanged(job_id);
+}
+
+void JobQueue::OnResourceUsage(int run_id, const ResourceUsage& usage) {
+    SolveJob* job = FindJob(run_to_job_.value(run_id));
+    if (job) {
+        job->usage = usage;
+    }
+}
+
+void JobQueue::OnFinished(int run_id, bool success, FailureReason reason, const QString& message,
+                          double final_v, int iterations, double runtime) {
+    const int job_id = run_to_job_.take(run_id);
+    SolveJob* job = FindJob(job_id);
+    if (!job) return;
+
+    used_cores_ -= job->threads;
+    used_memory_mb_ -= job->memory_mb;
+    for (int cpu : std::as_const(job->cpus)) {
+        if (cpu < cpu_used_.size()) {
+            cpu_used_[cpu] = false;
+        }
+    }
+
+    job->state = success ? JobState::kSucceeded
+               : (job->cancel_requested ? JobState::kCancelled : JobState::kFailed);
+    job->failure = reason;
+    job->message = message;
+    job->final_v = final_v;
+    job->iterations = iterations;
+    job->runtime = runtime;
+    job->finished_ms = QDateTime::currentMSecsSinceEpoch();
+
+    emit JobChanged(job_id);
+    emit JobFinished(job_id);
+
+    RequestSchedule();
+}
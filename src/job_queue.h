@@ -0,0 +1,158 @@
+// job_queue.h - 求解任务队列
+// 按核心数和内存预算同时运行多个求解进程, 每个任务启动时分得自己的 --threads / --memory
+
+#ifndef JOB_QUEUE_H
+#define JOB_QUEUE_H
+
+#include "solver_event.h"
+#include "resource_sampler.h"
+
+#include <QHash>
+#include <QObject>
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+class SolverSupervisor;
+
+// 任务状态
+enum class JobState {
+    kQueued,
+    kRunning,
+    kSucceeded,
+    kFailed,
+    kCancelled
+};
+
+// 资源预算
+struct ResourceBudget {
+    int cores = 1;            // 可分配的 CPU 核心数
+    int memory_mb = 0;        // 可分配的内存 (MB), 0 表示不限
+    int max_jobs = 1;         // 最多同时运行的任务数
+    int min_threads = 1;      // 每个任务至少分得的线程数
+
+    // 强制执行 (仅 Linux): 分得的内存/线程作为 cgroup 或 setrlimit 上限, 而不只是传给求解器的参数
+    bool enforce_limits = false;
+    bool pin_cpus = false;        // 每个任务绑定到互不重叠的逻辑 CPU
+    int background_nice = 0;      // 后台任务 (参数 background) 的 nice 值, 0 表示不调整
+};
+
+struct SolveJob {
+    int id = 0;
+    QString solver_path;
+    QString data_file;
+    QVariantMap params;
+    QString log_file;
+
+    JobState state = JobState::kQueued;
+    bool held = false;            // 排队但等待界面准备 (哈希, 初始约束文件), 调度时跳过
+    int run_id = 0;
+    bool cancel_requested = false;
+
+    // 启动时分配的资源
+    int threads = 0;
+    int memory_mb = 0;
+    QVector<int> cpus;        // 绑定的逻辑 CPU (pin_cpus 时)
+
+    // 进度
+    int iteration = 0;
+    double v = 0.0;
+    int cuts = 0;
+    qint64 started_ms = 0;
+    qint64 finished_ms = 0;
+
+    // 资源采样序列 (最后一个为当前值) 及结束时的合计
+    QVector<ResourceSample> resources;
+    ResourceUsage usage;
+
+    // 结果
+    FailureReason failure = FailureReason::kNone;
+    QString message;
+    double final_v = 0.0;
+    int iterations = 0;
+    double runtime = 0.0;
+
+    bool IsActive() const { return state == JobState::kQueued || state == JobState::kRunning; }
+};
+
+class JobQueue : public QObject {
+    Q_OBJECT
+
+public:
+    explicit JobQueue(SolverSupervisor* supervisor, QObject* parent = nullptr);
+
+    // 默认预算: 全部逻辑核心, 内存不限, 每个任务至少 4 线程
+    static ResourceBudget DefaultBudget();
+
+    // 按运行分配, 不影响求解结果的任务参数 (结果缓存的键不计入)
+    static bool IsRunParam(const QString& key);
+
+    // 修改预算 (已运行的任务不受影响), 随后 (下一轮事件循环) 尝试启动排队任务
+    void SetBudget(const ResourceBudget& budget);
+    const ResourceBudget& Budget() const { return budget_; }
+
+    // 运行中任务的资源采样周期 (毫秒), 0 表示关闭
+    void SetSampleInterval(int interval_ms);
+
+    // 加入队列, 返回任务编号; 任务在下一轮事件循环与同批加入的任务一起调度
+    // held 为 true 时任务先挂起, 直到 Release 才参与调度
+    int Enqueue(const QString& solver_path, const QString& data_file,
+                const QVariantMap& params, const QString& log_file, bool held = false);
+
+    // 放行挂起的任务, params 并入任务参数; 任务已取消时忽略
+    void Release(int job_id, const QVariantMap& params = QVariantMap());
+
+    // 取消任务: 排队中的直接标记取消, 运行中的结束进程
+    void Cancel(int job_id);
+    void CancelAll();
+
+    // 移除已结束的任务
+    void RemoveFinished();
+
+    const QVector<SolveJob>& Jobs() const { return jobs_; }
+    const SolveJob* Job(int job_id) const;
+
+    int RunningCount() const;
+    int QueuedCount() const;
+    int UsedCores() const { return used_cores_; }
+
+signals:
+    void JobAdded(int job_id);
+    void JobChanged(int job_id);
+    void JobsRemoved();
+
+    // 任务的事件批次 (按到达顺序), 供界面跟随某个任务
+    void JobEvents(int job_id, QVector<SolverEvent> events);
+    void JobFinished(int job_id);
+
+private:
+    // 在下一轮事件循环调度, 合并连续的多次请求
+    void RequestSchedule();
+
+    // 在预算内启动尽可能多的排队任务
+    void Schedule();
+    void StartJob(SolveJob* job, int threads, int memory_mb);
+
+    void OnEvents(int run_id, const QVector<SolverEvent>& events);
+    void OnResourceSampled(int run_id, const ResourceSample& sample);
+    void OnResourceUsage(int run_id, const ResourceUsage& usage);
+    void OnFinished(int run_id, bool success, FailureReason reason, const QString& message,
+                    double final_v, int iterations, double runtime);
+
+    SolveJob* FindJob(int job_id);
+
+    SolverSupervisor* supervisor_;
+    ResourceBudget budget_;
+
+    QVector<SolveJob> jobs_;
+    QHash<int, int> run_to_job_;
+    int next_job_id_;
+    bool schedule_pending_;
+
+    // 运行中任务占用的资源
+    int used_cores_;
+    int used_memory_mb_;
+    QVector<bool> cpu_used_;
+};
+
+#endif  // JOB_QUEUE_H
@@ -0,0 +1,342 @@
+// job_queue_panel.cpp - 求解队列面板实现
+
+#include "job_queue_panel.h"
+#include "job_queue.h"
+#include "update_scheduler.h"
+#include "resource_sampler.h"
+#include "process_limits.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QSpinBox>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QColor>
+
+namespace {
+
+// 队列表格每秒最多刷新次数
+constexpr int kQueueViewMaxFps = 10;
+
+// 默认资源采样周期 (毫秒)
+constexpr int kDefaultSampleIntervalMs = 1000;
+
+enum Column {
+    kColumnId,
+    kColumnFile,
+    kColumnState,
+    kColumnResources,
+    kColumnUsage,
+    kColumnIteration,
+    kColumnV,
+    kColumnElapsed,
+    kColumnCount
+};
+
+QString StateText(const SolveJob& job) {
+    if (job.state == JobState::kFailed && job.failure == FailureReason::kMemoryLimit) {
+        return "超出内存";
+    }
+    switch (job.state) {
+    case JobState::kQueued: return "排队";
+    case JobState::kRunning: return "运行中";
+    case JobState::kSucceeded: return "完成";
+    case JobState::kFailed: return "失败";
+    case JobState::kCancelled: return "已取消";
+    }
+    return QString();
+}
+
+QColor StateColor(JobState state) {
+    switch (state) {
+    case JobState::kRunning: return QColor("#1976D2");
+    case JobState::kSucceeded: return QColor("#4CAF50");
+    case JobState::kFailed: return QColor("#e53935");
+    case JobState::kCancelled: return QColor("#999");
+    case JobState::kQueued: break;
+    }
+    return QColor("#666");
+}
+
+}  // namespace
+
+JobQueuePanel::JobQueuePanel(JobQueue* queue, QWidget* parent)
+    : QWidget(parent)
+    , queue_(queue)
+    , refresh_scheduler_(new UpdateScheduler(kQueueViewMaxFps, this)) {
+    SetupUI();
+
+    connect(queue_, &JobQueue::JobAdded, this, &JobQueuePanel::OnJobAdded);
+    connect(queue_, &JobQueue::JobChanged, this, &JobQueuePanel::OnJobChanged);
+    connect(queue_, &JobQueue::JobsRemoved, this, &JobQueuePanel::RebuildTable);
+    connect(refresh_scheduler_, &UpdateScheduler::UpdateDue, this, &JobQueuePanel::RefreshRows);
+
+    UpdateSummary();
+}
+
+void JobQueuePanel::SetupUI() {
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(4);
+
+    // 资源预算
+    const ResourceBudget budget = queue_->Budget();
+    QHBoxLayout* budget_row = new QHBoxLayout();
+    budget_row->setSpacing(6);
+
+    budget_row->addWidget(new QLabel("核心"));
+    cores_spin_ = new QSpinBox();
+    cores_spin_->setRange(1, 1024);
+    cores_spin_->setValue(budget.cores);
+    cores_spin_->setToolTip("所有任务共用的 CPU 核心数, 按任务平分为 --threads");
+    budget_row->addWidget(cores_spin_);
+
+    budget_row->addWidget(new QLabel("内存"));
+    memory_spin_ = new QSpinBox();
+    memory_spin_->setRange(0, 1048576);
+    memory_spin_->setSingleStep(1024);
+    memory_spin_->setSuffix(" MB");
+    memory_spin_->setSpecialValueText("不限");
+    memory_spin_->setValue(budget.memory_mb);
+    memory_spin_->setToolTip("所有任务共用的内存, 按任务平分为 --memory");
+    budget_row->addWidget(memory_spin_);
+
+    budget_row->addWidget(new QLabel("并发"));
+    max_jobs_spin_ = new QSpinBox();
+    max_jobs_spin_->setRange(1, 256);
+    max_jobs_spin_->setValue(budget.max_jobs);
+    budget_row->addWidget(max_jobs_spin_);
+
+    budget_row->addWidget(new QLabel("每任务最少线程"));
+    min_threads_spin_ = new QSpinBox();
+    min_threads_spin_->setRange(1, 64);
+    min_threads_spin_->setValue(budget.min_threads);
+    budget_row->addWidget(min_threads_spin_);
+
+    budget_row->addWidget(new QLabel("采样"));
+    sample_spin_ = new QSpinBox();
+    sample_spin_->setRange(0, 60000);
+    sample_spin_->setSingleStep(250);
+    sample_spin_->setSuffix(" ms");
+    sample_spin_->setSpecialValueText("关闭");
+    sample_spin_->setValue(kDefaultSampleIntervalMs);
+    sample_spin_->setEnabled(ResourceSampler::IsSupported());
+    sample_spin_->setToolTip(ResourceSampler::IsSupported()
+        ? "读取 /proc 采样求解进程 (含子进程) 的 CPU, 内存和磁盘读写"
+        : "当前平台没有 /proc, 不采样资源");
+    budget_row->addWidget(sample_spin_);
+
+    budget_row->addStretch();
+    layout->addLayout(budget_row);
+
+    // 强制执行 (仅 Linux)
+    const bool limits_supported = ProcessLimiter::IsSupported();
+    QHBoxLayout* limit_row = new QHBoxLayout();
+    limit_row->setSpacing(6);
+
+    enforce_check_ = new QCheckBox("强制限制");
+    enforce_check_->setChecked(budget.enforce_limits);
+    enforce_check_->setToolTip("分得的内存和线程数作为进程上限 (cgroup v2, 不可用时内存用 setrlimit);\n"
+                               "超出内存的任务以\"超出内存\"结束, 不影响其他任务");
+    limit_row->addWidget(enforce_check_);
+
+    pin_check_ = new QCheckBox("绑定核心");
+    pin_check_->setChecked(budget.pin_cpus);
+    pin_check_->setToolTip("每个任务绑定到互不重叠的逻辑 CPU");
+    limit_row->addWidget(pin_check_);
+
+    limit_row->addWidget(new QLabel("后台 nice"));
+    nice_spin_ = new QSpinBox();
+    nice_spin_->setRange(0, 19);
+    nice_spin_->setSpecialValueText("不调整");
+    nice_spin_->setValue(budget.background_nice);
+    nice_spin_->setToolTip("批量添加和参数扫描的任务以该 nice 值运行, 界面上直接运行的任务不受影响");
+    limit_row->addWidget(nice_spin_);
+
+    for (QWidget* widget : {static_cast<QWidget*>(enforce_check_), static_cast<QWidget*>(pin_check_),
+                            static_cast<QWidget*>(nice_spin_)}) {
+        widget->setEnabled(limits_supported);
+    }
+    if (!limits_supported) {
+        enforce_check_->setToolTip("当前平台不支持, 内存/线程只作为参数传给求解器");
+    }
+
+    limit_row->addStretch();
+    layout->addLayout(limit_row);
+
+    // 操作按钮
+    QHBoxLayout* button_row = new QHBoxLayout();
+    button_row->setSpacing(6);
+    add_button_ = new QPushButton("添加文件...");
+    cancel_button_ = new QPushButton("取消选中");
+    clear_button_ = new QPushButton("清除已结束");
+    button_row->addWidget(add_button_);
+    button_row->addWidget(cancel_button_);
+    button_row->addWidget(clear_button_);
+    summary_label_ = new QLabel();
+    summary_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    button_row->addWidget(summary_label_, 1);
+    layout->addLayout(button_row);
+
+    // 任务列表
+    job_table_ = new QTableWidget();
+    job_table_->setColumnCount(kColumnCount);
+    job_table_->setHorizontalHeaderLabels({"#", "文件", "状态", "线程/内存", "CPU/RSS", "迭代", "v", "用时"});
+    job_table_->horizontalHeader()->setStretchLastSection(true);
+    job_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    job_table_->setColumnWidth(kColumnId, 40);
+    job_table_->setColumnWidth(kColumnFile, 160);
+    job_table_->verticalHeader()->setVisible(false);
+    job_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    job_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    layout->addWidget(job_table_, 1);
+
+    for (QSpinBox* spin : {cores_spin_, memory_spin_, max_jobs_spin_, min_threads_spin_, nice_spin_}) {
+        connect(spin, QOverload<int>::of(&QSpinBox::valueChanged),
+                this, &JobQueuePanel::OnBudgetChanged);
+    }
+    for (QCheckBox* check : {enforce_check_, pin_check_}) {
+        connect(check, &QCheckBox::toggled, this, &JobQueuePanel::OnBudgetChanged);
+    }
+    connect(sample_spin_, QOverload<int>::of(&QSpinBox::valueChanged),
+            queue_, &JobQueue::SetSampleInterval);
+    connect(add_button_, &QPushButton::clicked, this, &JobQueuePanel::AddFilesRequested);
+    connect(cancel_button_, &QPushButton::clicked, this, &JobQueuePanel::OnCancelSelected);
+    connect(clear_button_, &QPushButton::clicked, queue_, &JobQueue::RemoveFinished);
+    connect(job_table_, &QTableWidget::cellDoubleClicked, this, [this](int row, int) {
+        emit JobActivated(queue_->Jobs()[row].id);
+    });
+}
+
+void JobQueuePanel::OnBudgetChanged() {
+    ResourceBudget budget;
+    budget.cores = cores_spin_->value();
+    budget.memory_mb = memory_spin_->value();
+    budget.max_jobs = max_jobs_spin_->value();
+    budget.min_threads = min_threads_spin_->value();
+    budget.enforce_limits = enforce_check_->isChecked();
+    budget.pin_cpus = pin_check_->isChecked();
+    budget.background_nice = nice_spin_->value();
+    queue_->SetBudget(budget);
+    UpdateSummary();
+}
+
+void JobQueuePanel::OnJobAdded(int job_id) {
+    const int row = job_table_->rowCount();
+    job_table_->insertRow(row);
+    job_rows_.insert(job_id, row);
+    FillRow(row, job_id);
+    UpdateSummary();
+}
+
+void JobQueuePanel::OnJobChanged(int job_id) {
+    dirty_jobs_.insert(job_id);
+    refresh_scheduler_->RequestUpdate();
+}
+
+void JobQueuePanel::OnCancelSelected() {
+    const QModelIndexList rows = job_table_->selectionModel()->selectedRows();
+    for (const QModelIndex& index : rows) {
+        queue_->Cancel(queue_->Jobs()[index.row()].id);
+    }
+}
+
+void JobQueuePanel::RefreshRows() {
+    for (int job_id : std::as_const(dirty_jobs_)) {
+        const int row = job_rows_.value(job_id, -1);
+        if (row >= 0) {
+            FillRow(row, job_id);
+        }
+    }
+    dirty_jobs_.clear();
+    UpdateSummary();
+}
+
+void JobQueuePanel::RebuildTable() {
+    const QVector<SolveJob>& jobs = queue_->Jobs();
+    job_rows_.clear();
+    dirty_jobs_.clear();
+    job_table_->setRowCount(static_cast<int>(jobs.size()));
+    for (int row = 0; row < jobs.size(); ++row) {
+        job_rows_.insert(jobs[row].id, row);
+        FillRow(row, jobs[row].id);
+    }
+    UpdateSummary();
+}
+
+void JobQueuePanel::FillRow(int row, int job_id) {
+    const SolveJob* job = queue_->Job(job_id);
+    if (!job) return;
+
+    auto set_text = [this, row](int column, const QString& text) {
+        QTableWidgetItem* item = job_table_->item(row, column);
+        if (!item) {
+            item = new QTableWidgetItem();
+            job_table_->setItem(row, column, item);
+        }
+        item->setText(text);
+        return item;
+    };
+
+    set_text(kColumnId, QString::number(job->id));
+    set_text(kColumnFile, QFileInfo(job->data_file).fileName())->setToolTip(job->data_file);
+
+    QTableWidgetItem* state_item = set_text(kColumnState, StateText(*job));
+    state_item->setForeground(StateColor(job->state));
+    state_item->setToolTip(job->message);
+
+    if (job->state == JobState::kQueued) {
+        set_text(kColumnResources, "-");
+    } else {
+        set_text(kColumnResources, job->memory_mb > 0
+            ? QString("%1 / %2 MB").arg(job->threads).arg(job->memory_mb)
+            : QString("%1 / -").arg(job->threads));
+    }
+
+    // 运行中显示最近一次采样, 结束后显示 CPU 时间和峰值内存
+    if (job->state == JobState::kRunning && !job->resources.isEmpty()) {
+        const ResourceSample& sample = job->resources.last();
+        set_text(kColumnUsage, QString("%1% / %2")
+            .arg(sample.cpu_percent, 0, 'f', 0)
+            .arg(FormatBytes(sample.rss_kb * 1024.0)))->setToolTip(
+            QString("读 %1/s, 写 %2/s, %3 进程 %4 线程")
+                .arg(FormatBytes(sample.read_bps), FormatBytes(sample.write_bps))
+                .arg(sample.processes).arg(sample.threads));
+    } else if (!job->IsActive() && job->usage.samples > 0) {
+        set_text(kColumnUsage, QString("%1 s / %2")
+            .arg(job->usage.user_s + job->usage.system_s, 0, 'f', 1)
+            .arg(FormatBytes(job->usage.peak_rss_kb * 1024.0)))->setToolTip(
+            QString("CPU 时间 / 峰值内存; 读 %1, 写 %2")
+                .arg(FormatBytes(job->usage.read_bytes), FormatBytes(job->usage.write_bytes)));
+    } else {
+        set_text(kColumnUsage, "-");
+    }
+
+    set_text(kColumnIteration, job->iteration > 0 ? QString::number(job->iteration) : "-");
+
+    const bool done = job->state == JobState::kSucceeded;
+    set_text(kColumnV, done ? QString::number(job->final_v, 'f', 6)
+                     : (job->iteration > 0 ? QString::number(job->v, 'f', 6) : "-"));
+
+    if (job->started_ms > 0) {
+        const qint64 end = job->finished_ms > 0 ? job->finished_ms
+                                                : QDateTime::currentMSecsSinceEpoch();
+        set_text(kColumnElapsed, QString("%1 s").arg((end - job->started_ms) / 1000.0, 0, 'f', 1));
+    } else {
+        set_text(kColumnElapsed, "-");
+    }
+}
+
+void JobQueuePanel::UpdateSummary() {
+    const ResourceBudget& budget = queue_->Budget();
+    summary_label_->setText(QString("运行 %1 / 排队 %2, 核心 %3/%4")
+        .arg(queue_->RunningCount())
+        .arg(queue_->QueuedCount())
+        .arg(queue_->UsedCores())
+        .arg(budget.cores));
+}
@@ -0,0 +1,69 @@
+// job_queue_panel.h - 求解队列面板
+// 资源预算设置 + 任务列表 (每个任务的状态, 分得的资源和实时进度)
+
+#ifndef JOB_QUEUE_PANEL_H
+#define JOB_QUEUE_PANEL_H
+
+#include <QHash>
+#include <QSet>
+#include <QWidget>
+
+class QTableWidget;
+class QSpinBox;
+class QCheckBox;
+class QPushButton;
+class QLabel;
+class JobQueue;
+class UpdateScheduler;
+
+class JobQueuePanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit JobQueuePanel(JobQueue* queue, QWidget* parent = nullptr);
+
+signals:
+    // 请求批量添加数据文件 (使用当前参数)
+    void AddFilesRequested();
+
+    // 双击任务: 界面改为跟随该任务
+    void JobActivated(int job_id);
+
+private slots:
+    void OnBudgetChanged();
+    void OnJobAdded(int job_id);
+    void OnJobChanged(int job_id);
+    void OnCancelSelected();
+    void RefreshRows();
+
+private:
+    void SetupUI();
+    void RebuildTable();
+    void FillRow(int row, int job_id);
+    void UpdateSummary();
+
+    JobQueue* queue_;
+
+    QSpinBox* cores_spin_;
+    QSpinBox* memory_spin_;
+    QSpinBox* max_jobs_spin_;
+    QSpinBox* min_threads_spin_;
+    QSpinBox* sample_spin_;
+    QCheckBox* enforce_check_;
+    QCheckBox* pin_check_;
+    QSpinBox* nice_spin_;
+    QPushButton* add_button_;
+    QPushButton* cancel_button_;
+    QPushButton* clear_button_;
+    QLabel* summary_label_;
+    QTableWidget* job_table_;
+
+    // 任务编号 -> 表格行
+    QHash<int, int> job_rows_;
+
+    // 待刷新的任务, 按帧合并刷新
+    QSet<int> dirty_jobs_;
+    UpdateScheduler* refresh_scheduler_;
+};
+
+#endif  // JOB_QUEUE_PANEL_H
@@ -0,0 +1,73 @@
+// line_buffer.cpp - 进程输出行缓冲实现
+
+#include "line_buffer.h"
+
+#include <QIODevice>
+#include <cstring>
+
+LineBuffer::LineBuffer(qsizetype chunk_size)
+    : head_(0)
+    , tail_(0)
+    , scan_(0)
+    , chunk_size_(chunk_size) {
+    buffer_.resize(chunk_size_ * 2);
+}
+
+void LineBuffer::Reserve(qsizetype free_bytes) {
+    if (buffer_.size() - tail_ >= free_bytes) {
+        return;
+    }
+
+    // 已消费的空间回收: 剩余数据搬到头部
+    const qsizetype pending = tail_ - head_;
+    if (head_ > 0) {
+        char* data = buffer_.data();
+        std::memmove(data, data + head_, pending);
+        scan_ -= head_;
+        head_ = 0;
+        tail_ = pending;
+    }
+
+    // 超长行: 扩容
+    if (buffer_.size() - tail_ < free_bytes) {
+        buffer_.resize(tail_ + free_bytes);
+    }
+}
+
+qsizetype LineBuffer::ReadFrom(QIODevice* device) {
+    Reserve(chunk_size_);
+    const qint64 n = device->read(buffer_.data() + tail_, buffer_.size() - tail_);
+    if (n <= 0) {
+        return 0;
+    }
+    tail_ += n;
+    return n;
+}
+
+bool LineBuffer::NextLine(QByteArrayView* line) {
+    const char* data = buffer_.constData();
+    const void* newline = std::memchr(data + scan_, '\n', tail_ - scan_);
+    if (!newline) {
+        scan_ = tail_;
+        return false;
+    }
+
+    const qsizetype end = static_cast<const char*>(newline) - data;
+    *line = QByteArrayView(data + head_, end - head_);
+    head_ = end + 1;
+    scan_ = head_;
+    return true;
+}
+
+QByteArrayView LineBuffer::TakeRemainder() {
+    const QByteArrayView rest(buffer_.constData() + head_, tail_ - head_);
+    head_ = tail_;
+    scan_ = tail_;
+    return rest;
+}
+
+void LineBuffer::Clear() {
+    head_ = 0;
+    tail_ = 0;
+    scan_ = 0;
+}
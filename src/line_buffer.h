@@ -0,0 +1,40 @@
+// line_buffer.h - 进程输出行缓冲
+// 按块读取管道到复用缓冲区, 原地切分行, 以字节视图交给解析器
+
+#ifndef LINE_BUFFER_H
+#define LINE_BUFFER_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+
+class QIODevice;
+
+class LineBuffer {
+public:
+    explicit LineBuffer(qsizetype chunk_size = 64 * 1024);
+
+    // 从设备读取一块数据, 返回读取字节数 (0 表示暂无数据)
+    // 读取会使之前取出的行视图失效
+    qsizetype ReadFrom(QIODevice* device);
+
+    // 取出下一完整行 (不含换行符); 无完整行时返回 false
+    bool NextLine(QByteArrayView* line);
+
+    // 取出末尾不完整的行 (进程结束时调用)
+    QByteArrayView TakeRemainder();
+
+    // 丢弃全部数据, 保留容量
+    void Clear();
+
+private:
+    // 将未消费数据移到缓冲区头部, 必要时扩容
+    void Reserve(qsizetype free_bytes);
+
+    QByteArray buffer_;
+    qsizetype head_;        // 未消费数据起点
+    qsizetype tail_;        // 已写入数据终点
+    qsizetype scan_;        // 已确认无换行的位置, 避免重复扫描
+    qsizetype chunk_size_;
+};
+
+#endif  // LINE_BUFFER_H
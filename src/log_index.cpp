@@ -0,0 +1,261 @@
+// log_index.cpp - 日志增量索引实现
+
+#include "log_index.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// 合并两个升序行号表 (去重)
+QVector<quint32> MergeLines(const QVector<quint32>& a, const QVector<quint32>& b) {
+    QVector<quint32> out;
+    out.reserve(a.size() + b.size());
+    std::set_union(a.cbegin(), a.cend(), b.cbegin(), b.cend(), std::back_inserter(out));
+    return out;
+}
+
+// 追加一行或一段, 与上一段相邻时合并
+void AppendRange(LineRanges* ranges, quint32 begin, quint32 end) {
+    if (begin >= end) return;
+    if (!ranges->isEmpty() && ranges->last().second == begin) {
+        ranges->last().second = end;
+    } else {
+        ranges->append({begin, end});
+    }
+}
+
+void AppendLine(LineRanges* ranges, quint32 line) {
+    AppendRange(ranges, line, line + 1);
+}
+
+bool IsHan(QChar c) {
+    return c.script() == QChar::Script_Han;
+}
+
+// 形如 e06 的科学计数法指数
+bool IsExponent(QStringView word) {
+    if (word.size() < 2 || (word[0] != 'e' && word[0] != 'E')) return false;
+    for (int k = 1; k < word.size(); ++k) {
+        if (!word[k].isDigit()) return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+void LogIndex::Add(qint64 line, LogTag tag, const QString& message) {
+    const quint32 line_no = static_cast<quint32>(line);
+    tag_lines_[static_cast<int>(tag)].append(line_no);
+
+    if (tag == LogTag::kIter) {
+        // [ITER:k:START], 标签前可能有时间戳等前缀
+        const int start = message.indexOf("[ITER:") + 6;
+        const int end = message.indexOf(':', start);
+        bool ok = false;
+        const int iteration = message.mid(start, end - start).toInt(&ok);
+        if (ok) {
+            iter_spans_.append({iteration, line_no});
+        }
+    }
+
+    // 状态码行的数值字段不成词, 每行只多出标签名一个词项
+    for (const QString& token : Tokenize(message)) {
+        QVector<quint32>& lines = tokens_[token];
+        if (lines.isEmpty() || lines.last() != line_no) {
+            lines.append(line_no);
+        }
+    }
+}
+
+void LogIndex::Evict(qint64 first_kept_line) {
+    const quint32 boundary = static_cast<quint32>(first_kept_line);
+    if (boundary <= indexed_from_) return;
+
+    // 类别: 从各倒排表取出转存部分, 按行号写入字节表
+    evicted_tags_.resize(boundary);
+    for (int t = 0; t < kLogTagCount; ++t) {
+        QVector<quint32>& lines = tag_lines_[t];
+        const auto end = std::lower_bound(lines.cbegin(), lines.cend(), boundary);
+        for (auto it = lines.cbegin(); it != end; ++it) {
+            evicted_tags_[*it] = static_cast<char>(t);
+        }
+        lines.remove(0, end - lines.cbegin());
+    }
+
+    // 词项: 丢弃转存部分, 不再出现的词项整个移除
+    for (auto it = tokens_.begin(); it != tokens_.end();) {
+        QVector<quint32>& lines = it.value();
+        const auto end = std::lower_bound(lines.cbegin(), lines.cend(), boundary);
+        lines.remove(0, end - lines.cbegin());
+        it = lines.isEmpty() ? tokens_.erase(it) : std::next(it);
+    }
+    indexed_from_ = boundary;
+}
+
+void LogIndex::Clear() {
+    for (QVector<quint32>& lines : tag_lines_) {
+        lines.clear();
+    }
+    tokens_.clear();
+    indexed_from_ = 0;
+    evicted_tags_.clear();
+    iter_spans_.clear();
+}
+
+LineRanges LogIndex::Candidates(quint32 tag_mask, int iter_min, int iter_max,
+                                qint64 total_lines) const {
+    const quint32 total = static_cast<quint32>(total_lines);
+
+    // 迭代范围 -> 行区间
+    LineRanges ranges;
+    if (iter_min < 0 && iter_max < 0) {
+        AppendRange(&ranges, 0, total);
+    } else {
+        const auto in_range = [&](int iteration) {
+            return (iter_min < 0 || iteration >= iter_min)
+                && (iter_max < 0 || iteration <= iter_max);
+        };
+        const quint32 first_span = iter_spans_.isEmpty() ? total : iter_spans_.first().first_line;
+        if (in_range(0)) {
+            AppendRange(&ranges, 0, first_span);
+        }
+        for (int i = 0; i < iter_spans_.size(); ++i) {
+            if (!in_range(iter_spans_[i].iteration)) continue;
+            const quint32 end = (i + 1 < iter_spans_.size()) ? iter_spans_[i + 1].first_line : total;
+            AppendRange(&ranges, iter_spans_[i].first_line, end);
+        }
+    }
+
+    // 不限类别: 行区间即候选
+    if (tag_mask == 0) {
+        return ranges;
+    }
+
+    // 已转存部分逐字节检查类别
+    LineRanges out;
+    for (const auto& range : ranges) {
+        const quint32 end = qMin(range.second, indexed_from_);
+        for (quint32 line = range.first; line < end; ++line) {
+            if (tag_mask & (1u << static_cast<quint8>(evicted_tags_[line]))) {
+                AppendLine(&out, line);
+            }
+        }
+    }
+
+    // 其余部分: 合并选中类别的倒排表, 再与行区间求交
+    QVector<quint32> lines;
+    for (int t = 0; t < kLogTagCount; ++t) {
+        if (tag_mask & (1u << t)) {
+            lines = lines.isEmpty() ? tag_lines_[t] : MergeLines(lines, tag_lines_[t]);
+        }
+    }
+
+    int r = 0;
+    for (quint32 line : lines) {
+        while (r < ranges.size() && line >= ranges[r].second) ++r;
+        if (r == ranges.size()) break;
+        if (line >= ranges[r].first) {
+            AppendLine(&out, line);
+        }
+    }
+    return out;
+}
+
+bool LogIndex::FilterByTokens(const QString& text, LineRanges* candidates) const {
+    const QStringList query = Tokenize(text);
+    if (query.isEmpty()) {
+        return false;
+    }
+
+    // 每个查询词: 合并所有包含它的词项 (如 "ut" 对应 "cut"), 各查询词之间取交集
+    QVector<quint32> lines;
+    for (int q = 0; q < query.size(); ++q) {
+        const QString& token = query[q];
+        QVector<quint32> matched;
+        for (auto it = tokens_.cbegin(); it != tokens_.cend(); ++it) {
+            if (it.key().size() >= token.size() && it.key().contains(token)) {
+                matched = matched.isEmpty() ? it.value() : MergeLines(matched, it.value());
+            }
+        }
+
+        if (q == 0) {
+            lines.swap(matched);
+        } else {
+            QVector<quint32> kept;
+            std::set_intersection(lines.cbegin(), lines.cend(),
+                                  matched.cbegin(), matched.cend(), std::back_inserter(kept));
+            lines.swap(kept);
+        }
+        if (lines.isEmpty()) break;
+    }
+
+    // 已转存的行没有词项, 原样保留; 其余行与词项结果求交
+    LineRanges out;
+    for (const auto& range : *candidates) {
+        AppendRange(&out, range.first, qMin(range.second, indexed_from_));
+    }
+    int r = 0;
+    for (quint32 line : lines) {
+        while (r < candidates->size() && line >= (*candidates)[r].second) ++r;
+        if (r == candidates->size()) break;
+        if (line >= (*candidates)[r].first) {
+            AppendLine(&out, line);
+        }
+    }
+    candidates->swap(out);
+    return true;
+}
+
+qint64 LogIndex::CountLines(const LineRanges& ranges) {
+    qint64 count = 0;
+    for (const auto& range : ranges) {
+        count += range.second - range.first;
+    }
+    return count;
+}
+
+int LogIndex::IterationOf(qint64 line) const {
+    auto it = std::upper_bound(iter_spans_.cbegin(), iter_spans_.cend(), line,
+        [](qint64 value, const IterSpan& span) { return value < span.first_line; });
+    return it == iter_spans_.cbegin() ? 0 : std::prev(it)->iteration;
+}
+
+QStringList LogIndex::Tokenize(const QString& text) {
+    QStringList tokens;
+    const int n = text.size();
+    int i = 0;
+
+    while (i < n) {
+        const QChar c = text[i];
+
+        if (IsHan(c)) {
+            // 中文: 相邻两字切分 (单字成词时保留单字)
+            int j = i;
+            while (j < n && IsHan(text[j])) ++j;
+            if (j - i == 1) {
+                tokens << text.mid(i, 1);
+            }
+            for (int k = i; k + 1 < j; ++k) {
+                tokens << text.mid(k, 2);
+            }
+            i = j;
+        } else if (c.isLetter() && c.unicode() < 128) {
+            // ASCII 词: 字母开头, 后接字母/数字/下划线
+            int j = i;
+            while (j < n && text[j].unicode() < 128
+                   && (text[j].isLetterOrNumber() || text[j] == '_')) {
+                ++j;
+            }
+            // 科学计数法指数 (如 1.5e06) 不成词; 只看词本身, 查询和日志行的切分才一致
+            const QStringView word = QStringView(text).mid(i, j - i);
+            if (word.size() >= 2 && !IsExponent(word)) {
+                tokens << word.toString().toLower();
+            }
+            i = j;
+        } else {
+            ++i;
+        }
+    }
+    return tokens;
+}
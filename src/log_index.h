@@ -0,0 +1,66 @@
+// log_index.h - 日志增量索引
+// 行到达时记录类别倒排表, 迭代区间和词项倒排表; 查询只访问候选行
+// 转存到磁盘的行不再保留词项, 类别压缩为每行一个字节, 索引内存随保留上限而不是总行数增长
+
+#ifndef LOG_INDEX_H
+#define LOG_INDEX_H
+
+#include "log_store.h"
+
+#include <QByteArray>
+#include <QMap>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 候选行: 升序且互不重叠的行区间 [first, second), 相邻的行合并为一段
+using LineRanges = QVector<QPair<quint32, quint32>>;
+
+class LogIndex {
+public:
+    // 登记一行 (line 为全局行号, 须递增)
+    void Add(qint64 line, LogTag tag, const QString& message);
+
+    // first_kept_line 之前的行已转存到磁盘: 丢弃其词项, 类别压缩保存
+    void Evict(qint64 first_kept_line);
+
+    void Clear();
+
+    // 按类别和迭代范围筛选候选行
+    // tag_mask: 位 i 对应 LogTag i, 0 表示不限; iter_min/iter_max < 0 表示不限
+    LineRanges Candidates(quint32 tag_mask, int iter_min, int iter_max,
+                          qint64 total_lines) const;
+
+    // 用词项倒排表缩小候选行: 行中须有包含每个查询词的词项 (子串匹配, 结果仍需逐行确认)
+    // 已转存的行没有词项, 保留为候选; 查询中没有可索引的词时返回 false, 候选行保持不变
+    bool FilterByTokens(const QString& text, LineRanges* candidates) const;
+
+    // 候选行总数
+    static qint64 CountLines(const LineRanges& ranges);
+
+    // 行所在的迭代号 (首个 [ITER] 之前为 0)
+    int IterationOf(qint64 line) const;
+
+    // 拆分可索引词项: 字母开头的 ASCII 词转小写, 中文按相邻两字切分;
+    // 查询与日志行按同一规则切分, 行含查询子串时其词项必包含查询的每个词项
+    static QStringList Tokenize(const QString& text);
+
+private:
+    struct IterSpan {
+        int iteration;
+        quint32 first_line;
+    };
+
+    // 未转存的行 (行号 >= indexed_from_)
+    QVector<quint32> tag_lines_[kLogTagCount];
+    QMap<QString, QVector<quint32>> tokens_;
+    quint32 indexed_from_ = 0;
+
+    // 已转存的行, 每行一个字节的类别
+    QByteArray evicted_tags_;
+
+    QVector<IterSpan> iter_spans_;
+};
+
+#endif  // LOG_INDEX_H
@@ -0,0 +1,99 @@
+// log_model.cpp - 日志列表模型实现
+
+#include "log_model.h"
+
+#include <QBrush>
+#include <QColor>
+#include <QVariant>
+#include <QDateTime>
+
+namespace {
+
+// 各类别前景色, 与 LogTag 顺序一致
+// 预先包装成 QVariant, data() 每次调用只复制共享数据
+const QVariant& TagForeground(LogTag tag) {
+    static const QVariant kPalette[kLogTagCount] = {
+        QBrush(QColor("#d4d4d4")),  // kPlain
+        QBrush(QColor("#f44336")),  // kError
+        QBrush(QColor("#ff9800")),  // kWarn
+        QBrush(QColor("#4caf50")),  // kInfo
+        QBrush(QColor("#d4d4d4")),  // kLoad
+        QBrush(QColor("#9c27b0")),  // kGrand
+        QBrush(QColor("#d4d4d4")),  // kIter
+        QBrush(QColor("#d4d4d4")),  // kMP
+        QBrush(QColor("#d4d4d4")),  // kSP
+        QBrush(QColor("#2196f3")),  // kCut
+        QBrush(QColor("#9c27b0")),  // kConverge
+        QBrush(QColor("#9c27b0")),  // kDone
+    };
+    return kPalette[static_cast<int>(tag)];
+}
+
+}  // namespace
+
+LogModel::LogModel(QObject* parent)
+    : QAbstractListModel(parent) {
+}
+
+int LogModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : store_.Size();
+}
+
+QVariant LogModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= store_.Size()) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+    switch (role) {
+    case Qt::DisplayRole:
+        return store_.LineText(row);
+    case Qt::ForegroundRole:
+        return TagForeground(store_.Tag(row));
+    case Qt::ToolTipRole:
+        return QString("#%1  %2")
+            .arg(store_.FirstLineNumber() + row + 1)
+            .arg(QDateTime::fromMSecsSinceEpoch(store_.Timestamp(row)).toString("HH:mm:ss.zzz"));
+    default:
+        return QVariant();
+    }
+}
+
+void LogModel::AppendLines(const QStringList& messages, const QVector<LogTag>& tags) {
+    if (messages.isEmpty()) return;
+    Q_ASSERT(tags.size() == messages.size());
+
+    const int first = store_.Size();
+    const qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    beginInsertRows(QModelIndex(), first, first + static_cast<int>(messages.size()) - 1);
+    for (qsizetype i = 0; i < messages.size(); ++i) {
+        index_.Add(store_.TotalLines(), tags[i], messages[i]);
+        store_.Append(messages[i], tags[i], now);
+    }
+    endInsertRows();
+
+    // 超出保留上限: 最早的行先写入磁盘, 成功后才从列表移除
+    const int spill = store_.PendingSpillCount();
+    if (spill <= 0) {
+        return;
+    }
+    if (store_.WriteSpill(spill)) {
+        beginRemoveRows(QModelIndex(), 0, spill - 1);
+        store_.DropSpilled(spill);
+        index_.Evict(store_.FirstLineNumber());
+        endRemoveRows();
+    } else {
+        // 不丢弃日志: 之后的行全部留在内存中, 并在日志里提示一次
+        AppendLines({QString("[WARN] 日志无法转存到磁盘 (%1), 超出上限的行将保留在内存中")
+                         .arg(store_.SpillError())},
+                    {LogTag::kWarn});
+    }
+}
+
+void LogModel::Clear() {
+    beginResetModel();
+    store_.Clear();
+    index_.Clear();
+    endResetModel();
+}
@@ -0,0 +1,38 @@
+// log_model.h - 日志列表模型
+// 基于 LogStore, 视图只为可见行解码文本
+
+#ifndef LOG_MODEL_H
+#define LOG_MODEL_H
+
+#include "log_index.h"
+#include "log_store.h"
+
+#include <QAbstractListModel>
+#include <QStringList>
+#include <QVector>
+
+class LogModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit LogModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // 批量追加 (一次插入通知), 超出保留上限时转存最早的行
+    void AppendLines(const QStringList& messages, const QVector<LogTag>& tags);
+
+    // 清空
+    void Clear();
+
+    LogStore& Store() { return store_; }
+    const LogStore& Store() const { return store_; }
+    const LogIndex& Index() const { return index_; }
+
+private:
+    LogStore store_;
+    LogIndex index_;
+};
+
+#endif  // LOG_MODEL_H
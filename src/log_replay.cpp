@@ -0,0 +1,114 @@
+// log_replay.cpp - 运行日志后台回放实现
+
+#include "log_replay.h"
+#include "log_sink.h"
+
+#include <QThread>
+
+namespace {
+
+// 每批行数
+constexpr qsizetype kBatchLines = 4096;
+
+// 最多同时在事件队列中等待界面处理的批次数
+constexpr int kMaxBatchesInFlight = 4;
+
+// 等待界面取走批次时检查取消的周期 (毫秒)
+constexpr int kCreditWaitMs = 50;
+
+}  // namespace
+
+LogReplay::LogReplay(QObject* parent)
+    : QObject(parent)
+    , thread_(new QThread(this))
+    , thread_root_(new QObject())
+    , current_request_(0)
+    , credits_(kMaxBatchesInFlight)
+    , next_request_(1) {
+    thread_->setObjectName("LogReplay");
+    thread_root_->moveToThread(thread_);
+    thread_->start();
+}
+
+LogReplay::~LogReplay() {
+    current_request_ = -1;
+    QObject* root = thread_root_;
+    QMetaObject::invokeMethod(root, [root]() { delete root; }, Qt::BlockingQueuedConnection);
+    thread_->quit();
+    thread_->wait();
+}
+
+int LogReplay::Start(const QString& path) {
+    const int request_id = next_request_++;
+    current_request_ = request_id;
+
+    QMetaObject::invokeMethod(thread_root_, [this, request_id, path]() {
+        Run(request_id, path);
+    }, Qt::QueuedConnection);
+    return request_id;
+}
+
+void LogReplay::Cancel() {
+    current_request_ = 0;
+}
+
+void LogReplay::Run(int request_id, const QString& path) {
+    auto cancelled = [this, request_id]() { return current_request_.load() != request_id; };
+
+    QStringList lines;
+    QVector<LogTag> tags;
+
+    // 交出一批; 界面积压的批次达到上限时等待, 期间被取消则放弃
+    auto send = [&]() {
+        while (!credits_.tryAcquire(1, kCreditWaitMs)) {
+            if (cancelled()) return false;
+        }
+        QMetaObject::invokeMethod(this, [this, request_id, lines, tags]() {
+            if (current_request_.load() == request_id) {
+                emit LinesReady(request_id, lines, tags);
+            }
+            credits_.release();
+        }, Qt::QueuedConnection);
+        lines.clear();
+        tags.clear();
+        return !cancelled();
+    };
+
+    auto add = [&](QByteArrayView raw) {
+        raw = raw.trimmed();
+        if (raw.isEmpty()) return;
+        const QString line = QString::fromLocal8Bit(raw);
+        tags.append(ClassifyLogLine(line));
+        lines.append(line);
+    };
+
+    // 块边界不对齐行, 跨块的行先拼到 partial
+    QByteArray partial;
+    const bool ok = LogSink::ReadBlocks(path, [&](const QByteArray& block) {
+        const QByteArrayView view(block);
+        qsizetype start = 0;
+        for (qsizetype end = view.indexOf('\n'); end >= 0; end = view.indexOf('\n', start)) {
+            if (partial.isEmpty()) {
+                add(view.sliced(start, end - start));
+            } else {
+                partial.append(view.sliced(start, end - start));
+                add(partial);
+                partial.clear();
+            }
+            start = end + 1;
+            if (lines.size() >= kBatchLines && !send()) return false;
+        }
+        partial.append(view.sliced(start));
+        return !cancelled();
+    });
+    if (cancelled()) return;
+
+    add(partial);
+    if (!lines.isEmpty() && !send()) return;
+
+    QMetaObject::invokeMethod(this, [this, request_id, ok]() {
+        if (current_request_.load() == request_id) {
+            emit Finished(request_id, ok);
+        }
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,57 @@
+// log_replay.h - 运行日志后台回放
+// 在回放线程上逐块还原运行日志 (含压缩格式), 切分, 解码并分类, 按批交给界面线程追加到日志控件
+// 未被界面取走的批次有上限, 大日志不会一次性堆进事件队列
+
+#ifndef LOG_REPLAY_H
+#define LOG_REPLAY_H
+
+#include "log_tag.h"
+
+#include <QObject>
+#include <QSemaphore>
+#include <QStringList>
+#include <QVector>
+#include <atomic>
+
+class QThread;
+
+class LogReplay : public QObject {
+    Q_OBJECT
+
+public:
+    explicit LogReplay(QObject* parent = nullptr);
+
+    // 取消进行中的回放并停止回放线程
+    ~LogReplay();
+
+    // 开始回放, 之前未完成的回放被取消; 返回请求编号, 之后的信号都带着它
+    int Start(const QString& path);
+
+    // 取消进行中的回放 (已发出的批次不撤回)
+    void Cancel();
+
+signals:
+    // 一批日志行及其类别, 按文件顺序
+    void LinesReady(int request_id, QStringList lines, QVector<LogTag> tags);
+
+    // 回放结束; ok 为 false 表示文件无法读取或已损坏
+    void Finished(int request_id, bool ok);
+
+private:
+    // 在回放线程上执行
+    void Run(int request_id, const QString& path);
+
+    QThread* thread_;
+    QObject* thread_root_;
+
+    // 最新的请求编号; 回放线程看到编号变化即放弃当前请求
+    std::atomic<int> current_request_;
+
+    // 已发出但界面尚未处理的批次数上限
+    QSemaphore credits_;
+
+    // 只在主线程上访问
+    int next_request_;
+};
+
+#endif  // LOG_REPLAY_H
@@ -0,0 +1,256 @@
+// log_search_panel.cpp - 日志搜索面板实现
+
+#include "log_search_panel.h"
+#include "log_model.h"
+
+#include <QAbstractListModel>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QLineEdit>
+#include <QCheckBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QListView>
+#include <QTimer>
+
+namespace {
+
+// 每个分片最多占用主线程的时间 (毫秒)
+constexpr int kScanSliceMs = 8;
+
+// 类别筛选项
+struct TagFilter {
+    const char* label;
+    quint32 mask;
+};
+
+constexpr quint32 TagBit(LogTag tag) {
+    return 1u << static_cast<int>(tag);
+}
+
+const TagFilter kTagFilters[] = {
+    {"全部类别", 0},
+    {"[CUT] 约束", TagBit(LogTag::kCut)},
+    {"[SP] 子问题", TagBit(LogTag::kSP)},
+    {"[MP] 主问题", TagBit(LogTag::kMP)},
+    {"[ITER] 迭代", TagBit(LogTag::kIter)},
+    {"里程碑", TagBit(LogTag::kLoad) | TagBit(LogTag::kGrand)
+               | TagBit(LogTag::kConverge) | TagBit(LogTag::kDone)},
+    {"错误", TagBit(LogTag::kError)},
+    {"警告", TagBit(LogTag::kWarn)},
+    {"普通输出", TagBit(LogTag::kPlain) | TagBit(LogTag::kInfo)},
+};
+
+}  // namespace
+
+// 搜索结果列表模型: 只保存行号, 显示时按需读取文本
+class LogSearchResultModel : public QAbstractListModel {
+public:
+    explicit LogSearchResultModel(const LogStore* store, QObject* parent)
+        : QAbstractListModel(parent), store_(store) {}
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override {
+        return parent.isValid() ? 0 : static_cast<int>(lines_.size());
+    }
+
+    QVariant data(const QModelIndex& index, int role) const override {
+        if (!index.isValid() || role != Qt::DisplayRole) return QVariant();
+        const quint32 line = lines_[index.row()];
+        return QString("%1: %2").arg(line + 1).arg(store_->ReadLine(line));
+    }
+
+    void Append(const QVector<quint32>& lines) {
+        if (lines.isEmpty()) return;
+        const int first = static_cast<int>(lines_.size());
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(lines.size()) - 1);
+        lines_ += lines;
+        endInsertRows();
+    }
+
+    void Clear() {
+        beginResetModel();
+        lines_.clear();
+        endResetModel();
+    }
+
+    quint32 LineAt(int row) const { return lines_[row]; }
+
+private:
+    const LogStore* store_;
+    QVector<quint32> lines_;
+};
+
+LogSearchPanel::LogSearchPanel(LogModel* log_model, QWidget* parent)
+    : QWidget(parent)
+    , log_model_(log_model)
+    , scan_timer_(new QTimer(this))
+    , candidate_count_(0)
+    , scan_range_(0)
+    , scan_line_(0)
+    , scanned_(0)
+    , use_regex_(false) {
+    results_model_ = new LogSearchResultModel(&log_model_->Store(), this);
+    connect(scan_timer_, &QTimer::timeout, this, &LogSearchPanel::OnScanStep);
+    SetupUI();
+}
+
+void LogSearchPanel::SetupUI() {
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 4, 0, 0);
+    layout->setSpacing(4);
+
+    // 查询条件
+    QHBoxLayout* query_row = new QHBoxLayout();
+    query_row->setSpacing(4);
+
+    tag_combo_ = new QComboBox();
+    for (const TagFilter& filter : kTagFilters) {
+        tag_combo_->addItem(filter.label, filter.mask);
+    }
+    query_row->addWidget(tag_combo_);
+
+    query_row->addWidget(new QLabel("迭代"));
+    iter_from_spin_ = new QSpinBox();
+    iter_from_spin_->setRange(-1, 1000000);
+    iter_from_spin_->setSpecialValueText("不限");
+    iter_from_spin_->setValue(-1);
+    query_row->addWidget(iter_from_spin_);
+    query_row->addWidget(new QLabel("-"));
+    iter_to_spin_ = new QSpinBox();
+    iter_to_spin_->setRange(-1, 1000000);
+    iter_to_spin_->setSpecialValueText("不限");
+    iter_to_spin_->setValue(-1);
+    query_row->addWidget(iter_to_spin_);
+
+    query_edit_ = new QLineEdit();
+    query_edit_->setPlaceholderText("搜索日志 (子串, 不区分大小写)...");
+    query_edit_->setClearButtonEnabled(true);
+    query_row->addWidget(query_edit_, 1);
+
+    regex_check_ = new QCheckBox("正则");
+    query_row->addWidget(regex_check_);
+
+    search_button_ = new QPushButton("搜索");
+    query_row->addWidget(search_button_);
+
+    layout->addLayout(query_row);
+
+    status_label_ = new QLabel();
+    status_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    layout->addWidget(status_label_);
+
+    // 结果列表
+    results_view_ = new QListView();
+    results_view_->setModel(results_model_);
+    results_view_->setUniformItemSizes(true);
+    results_view_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    results_view_->setFont(QFont("Consolas", 9));
+    results_view_->setVisible(false);
+    layout->addWidget(results_view_, 1);
+
+    connect(search_button_, &QPushButton::clicked, this, &LogSearchPanel::OnSearch);
+    connect(query_edit_, &QLineEdit::returnPressed, this, &LogSearchPanel::OnSearch);
+    connect(results_view_, &QListView::doubleClicked, this, [this](const QModelIndex& index) {
+        emit LineActivated(results_model_->LineAt(index.row()));
+    });
+}
+
+void LogSearchPanel::Reset() {
+    StopScan();
+    candidates_.clear();
+    candidate_count_ = 0;
+    scan_range_ = 0;
+    scan_line_ = 0;
+    scanned_ = 0;
+    results_model_->Clear();
+    results_view_->setVisible(false);
+    status_label_->clear();
+}
+
+void LogSearchPanel::FocusQuery() {
+    query_edit_->setFocus();
+    query_edit_->selectAll();
+}
+
+void LogSearchPanel::OnSearch() {
+    StopScan();
+    results_model_->Clear();
+    results_view_->setVisible(true);
+    search_clock_.start();
+
+    const LogIndex& index = log_model_->Index();
+    const quint32 mask = tag_combo_->currentData().toUInt();
+    candidates_ = index.Candidates(mask, iter_from_spin_->value(), iter_to_spin_->value(),
+                                   log_model_->Store().TotalLines());
+
+    query_text_ = query_edit_->text().trimmed();
+    use_regex_ = regex_check_->isChecked() && !query_text_.isEmpty();
+
+    if (use_regex_) {
+        query_regex_ = QRegularExpression(query_text_, QRegularExpression::CaseInsensitiveOption);
+        if (!query_regex_.isValid()) {
+            status_label_->setText("正则表达式无效: " + query_regex_.errorString());
+            candidates_.clear();
+            return;
+        }
+        query_regex_.optimize();
+    } else if (!query_text_.isEmpty()) {
+        // 普通文本: 先用词项倒排表缩小范围, 再逐行确认子串
+        index.FilterByTokens(query_text_, &candidates_);
+    }
+
+    // 候选行按区间逐个取出 (不展开成行号表), 无文本条件时候选行即结果
+    candidate_count_ = LogIndex::CountLines(candidates_);
+    scan_range_ = 0;
+    scan_line_ = candidates_.isEmpty() ? 0 : candidates_.first().first;
+    scanned_ = 0;
+    scan_timer_->start(0);
+    UpdateStatus();
+}
+
+void LogSearchPanel::OnScanStep() {
+    const LogStore& store = log_model_->Store();
+    QElapsedTimer slice;
+    slice.start();
+
+    QVector<quint32> matched;
+    while (scan_range_ < candidates_.size() && slice.elapsed() < kScanSliceMs) {
+        const quint32 line = scan_line_++;
+        ++scanned_;
+        if (scan_line_ >= candidates_[scan_range_].second && ++scan_range_ < candidates_.size()) {
+            scan_line_ = candidates_[scan_range_].first;
+        }
+
+        bool hit = true;
+        if (!query_text_.isEmpty()) {
+            const QString text = store.ReadLine(line);
+            hit = use_regex_
+                ? query_regex_.match(text).hasMatch()
+                : text.contains(query_text_, Qt::CaseInsensitive);
+        }
+        if (hit) {
+            matched.append(line);
+        }
+    }
+
+    results_model_->Append(matched);
+    if (scan_range_ >= candidates_.size()) {
+        StopScan();
+    }
+    UpdateStatus();
+}
+
+void LogSearchPanel::StopScan() {
+    scan_timer_->stop();
+}
+
+void LogSearchPanel::UpdateStatus() {
+    const bool scanning = scan_timer_->isActive();
+    status_label_->setText(QString("%1 条匹配 (候选 %2 行%3, %4 ms)")
+        .arg(results_model_->rowCount())
+        .arg(candidate_count_)
+        .arg(scanning ? QString(", 已检查 %1").arg(scanned_) : QString())
+        .arg(search_clock_.elapsed()));
+}
@@ -0,0 +1,75 @@
+// log_search_panel.h - 日志搜索面板
+// 按类别, 迭代范围和文本/正则检索日志; 候选行来自增量索引, 文本校验分片执行
+
+#ifndef LOG_SEARCH_PANEL_H
+#define LOG_SEARCH_PANEL_H
+
+#include "log_index.h"
+
+#include <QWidget>
+#include <QVector>
+#include <QRegularExpression>
+#include <QElapsedTimer>
+
+class QComboBox;
+class QSpinBox;
+class QLineEdit;
+class QCheckBox;
+class QPushButton;
+class QLabel;
+class QListView;
+class QTimer;
+class LogModel;
+class LogSearchResultModel;
+
+class LogSearchPanel : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit LogSearchPanel(LogModel* log_model, QWidget* parent = nullptr);
+
+    // 日志清空时丢弃结果
+    void Reset();
+
+    // 聚焦查询输入框
+    void FocusQuery();
+
+signals:
+    // 双击结果: 定位到全局行号
+    void LineActivated(qint64 line_number);
+
+private slots:
+    void OnSearch();
+    void OnScanStep();
+
+private:
+    void SetupUI();
+    void StopScan();
+    void UpdateStatus();
+
+    LogModel* log_model_;
+
+    QComboBox* tag_combo_;
+    QSpinBox* iter_from_spin_;
+    QSpinBox* iter_to_spin_;
+    QLineEdit* query_edit_;
+    QCheckBox* regex_check_;
+    QPushButton* search_button_;
+    QLabel* status_label_;
+    QListView* results_view_;
+    LogSearchResultModel* results_model_;
+
+    // 分片校验状态
+    QTimer* scan_timer_;
+    LineRanges candidates_;
+    qint64 candidate_count_;
+    int scan_range_;
+    quint32 scan_line_;
+    qint64 scanned_;
+    QString query_text_;
+    QRegularExpression query_regex_;
+    bool use_regex_;
+    QElapsedTimer search_clock_;
+};
+
+#endif  // LOG_SEARCH_PANEL_H
@@ -0,0 +1,349 @@
+// log_sink.cpp - 运行日志落盘实现
+
+#include "log_sink.h"
+
+#include <QDeadlineTimer>
+#include <QFile>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QObject>
+#include <QThread>
+#include <QVector>
+#include <QWaitCondition>
+#include <QtEndian>
+#include <cstring>
+
+namespace {
+
+// 积压达到一块时唤醒写线程
+constexpr qsizetype kBlockBytes = 256 * 1024;
+
+// 积压上限, 超过后调用方暂停读取输出 (见 Backlogged)
+constexpr qsizetype kMaxPendingBytes = 16 * 1024 * 1024;
+
+// 输出稀疏时也定期落盘, 界面崩溃最多丢失这段时间的日志
+constexpr int kFlushIntervalMs = 250;
+
+// 压缩文件格式: 文件头 + 若干块, 每块为 [原始长度][压缩长度][qCompress 数据]
+// 长度均为大端 quint32
+constexpr char kCompressedMagic[8] = {'G', 'M', 'L', 'O', 'G', 'Z', '0', '1'};
+
+bool IsCompressedFile(QFile* file) {
+    char magic[sizeof(kCompressedMagic)];
+    const qint64 n = file->peek(magic, sizeof(magic));
+    return n == static_cast<qint64>(sizeof(magic))
+        && memcmp(magic, kCompressedMagic, sizeof(magic)) == 0;
+}
+
+}  // namespace
+
+// 所有日志共用的写线程: 轮流取走各日志积压满一块, 到期或正在关闭的内容写盘
+// 同时运行多个求解时不为每次运行另开线程
+class LogWriter {
+public:
+    static LogWriter& Instance() {
+        static LogWriter writer;
+        return writer;
+    }
+
+    ~LogWriter() {
+        {
+            QMutexLocker locker(&mutex);
+            stopping_ = true;
+            ready.wakeOne();
+        }
+        if (thread_) {
+            thread_->wait();
+            delete thread_;
+        }
+    }
+
+    // 登记日志 (调用方持有 mutex), 首次登记时启动线程
+    void Add(LogSink* sink) {
+        sinks_.append(sink);
+        if (!thread_) {
+            thread_ = QThread::create([this]() { Loop(); });
+            thread_->setObjectName("LogWriter");
+            thread_->start();
+        }
+        ready.wakeOne();
+    }
+
+    // 保护各 LogSink 的共享状态及登记表
+    QMutex mutex;
+    QWaitCondition ready;    // 有日志需要处理
+    QWaitCondition closed;   // 有日志关闭完成
+
+private:
+    LogWriter() = default;
+
+    // 需要现在处理的日志: 正在关闭, 积压满一块, 或积压内容到了落盘周期
+    static bool Due(const LogSink* sink) {
+        return sink->closing_ || sink->pending_.size() >= kBlockBytes
+            || (!sink->pending_.isEmpty() && sink->flush_clock_.hasExpired(kFlushIntervalMs));
+    }
+
+    void Loop() {
+        QByteArray block;
+        block.reserve(kBlockBytes * 2);
+
+        QMutexLocker locker(&mutex);
+        for (;;) {
+            // 进程退出时各求解已结束, 日志都已关闭
+            if (stopping_) return;
+
+            qsizetype due = -1;
+            for (qsizetype i = 0; i < sinks_.size() && due < 0; ++i) {
+                if (Due(sinks_[i])) due = i;
+            }
+            if (due < 0) {
+                ready.wait(&mutex, QDeadlineTimer(NextFlushMs()));
+                continue;
+            }
+
+            // 处理过的日志移到末尾, 输出多的运行不会饿死其他运行
+            LogSink* sink = sinks_.takeAt(due);
+            const bool closing = sink->closing_;
+            const bool failed = sink->failed_;
+            block.swap(sink->pending_);
+            sink->flush_clock_.restart();
+            if (!closing) {
+                sinks_.append(sink);
+            }
+            locker.unlock();
+
+            // 写失败后不再写入, 剩余内容丢弃, 直到关闭
+            QString error;
+            if (!block.isEmpty() && !failed) {
+                if (sink->WriteBlock(block)) {
+                    sink->bytes_written_ += block.size();
+                } else {
+                    error = sink->file_->errorString();
+                }
+            }
+            // 保留容量: 缓冲区在写线程和日志之间交替使用, 稳定后不再分配
+            block.resize(0);
+
+            if (closing) {
+                sink->file_->close();
+                delete sink->file_;
+                sink->file_ = nullptr;
+                sink->open_ = false;
+            }
+
+            locker.relock();
+            if (!error.isEmpty()) {
+                sink->failed_ = true;
+                sink->error_ = error;
+                sink->pending_.clear();
+            }
+            if (closing) {
+                // 回调只投递事件, 不在写线程上执行调用方的代码; 在置 closed_ 之前投递,
+                // 同步 Close 返回 (随后日志及其 context 可能析构) 时事件已入队
+                if (sink->on_closed_) {
+                    sink->on_closed_();
+                    sink->on_closed_ = nullptr;
+                }
+                sink->closed_ = true;
+                closed.wakeAll();
+            }
+        }
+    }
+
+    // 距最早一份积压到期的毫秒数, 没有积压时为一个落盘周期
+    qint64 NextFlushMs() const {
+        qint64 wait_ms = kFlushIntervalMs;
+        for (const LogSink* sink : sinks_) {
+            if (!sink->pending_.isEmpty()) {
+                wait_ms = qMin(wait_ms, qMax<qint64>(1, kFlushIntervalMs - sink->flush_clock_.elapsed()));
+            }
+        }
+        return wait_ms;
+    }
+
+    QThread* thread_ = nullptr;
+    QVector<LogSink*> sinks_;
+    bool stopping_ = false;
+};
+
+LogSink::LogSink()
+    : compress_(false)
+    , file_(nullptr)
+    , open_(false)
+    , closing_(false)
+    , closed_(true)
+    , failed_(false)
+    , bytes_written_(0) {
+}
+
+LogSink::~LogSink() {
+    Close();
+}
+
+bool LogSink::Open(const QString& path, bool compress) {
+    Close();
+
+    QFile* file = new QFile(path);
+    if (!file->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        LogWriter& writer = LogWriter::Instance();
+        QMutexLocker locker(&writer.mutex);
+        error_ = file->errorString();
+        delete file;
+        return false;
+    }
+    if (compress) {
+        file->write(kCompressedMagic, sizeof(kCompressedMagic));
+    }
+
+    path_ = path;
+    compress_ = compress;
+    file_ = file;
+    bytes_written_ = 0;
+    open_ = true;
+
+    LogWriter& writer = LogWriter::Instance();
+    QMutexLocker locker(&writer.mutex);
+    closing_ = false;
+    closed_ = false;
+    failed_ = false;
+    error_.clear();
+    pending_.clear();
+    pending_.reserve(kBlockBytes * 2);
+    flush_clock_.start();
+    writer.Add(this);
+    return true;
+}
+
+void LogSink::Write(QByteArrayView line) {
+    if (!open_.load()) return;
+
+    LogWriter& writer = LogWriter::Instance();
+    QMutexLocker locker(&writer.mutex);
+    if (failed_ || closing_) return;
+
+    pending_.append(line);
+    pending_.append('\n');
+    if (pending_.size() >= kBlockBytes) {
+        writer.ready.wakeOne();
+    }
+}
+
+bool LogSink::Backlogged() const {
+    if (!open_.load()) return false;
+
+    LogWriter& writer = LogWriter::Instance();
+    QMutexLocker locker(&writer.mutex);
+    return !failed_ && pending_.size() >= kMaxPendingBytes;
+}
+
+void LogSink::Close() {
+    LogWriter& writer = LogWriter::Instance();
+    QMutexLocker locker(&writer.mutex);
+    if (closed_) return;
+
+    closing_ = true;
+    writer.ready.wakeOne();
+    while (!closed_) {
+        writer.closed.wait(&writer.mutex);
+    }
+}
+
+void LogSink::CloseAsync(QObject* context, std::function<void()> done) {
+    LogWriter& writer = LogWriter::Instance();
+    QMutexLocker locker(&writer.mutex);
+    if (closed_) {
+        locker.unlock();
+        done();
+        return;
+    }
+
+    // 写线程关闭文件后把 done 投递回 context 所在线程
+    on_closed_ = [context, done]() {
+        QMetaObject::invokeMethod(context, done, Qt::QueuedConnection);
+    };
+    closing_ = true;
+    writer.ready.wakeOne();
+}
+
+QString LogSink::ErrorString() const {
+    LogWriter& writer = LogWriter::Instance();
+    QMutexLocker locker(&writer.mutex);
+    return error_;
+}
+
+bool LogSink::WriteBlock(const QByteArray& block) {
+    if (compress_) {
+        const QByteArray packed = qCompress(block, 1);
+        uchar header[8];
+        qToBigEndian<quint32>(static_cast<quint32>(block.size()), header);
+        qToBigEndian<quint32>(static_cast<quint32>(packed.size()), header + 4);
+        if (file_->write(reinterpret_cast<const char*>(header), sizeof(header)) != sizeof(header)
+            || file_->write(packed) != packed.size()) {
+            return false;
+        }
+    } else if (file_->write(block) != block.size()) {
+        return false;
+    }
+    // 交给操作系统, 界面进程崩溃后内容仍在
+    return file_->flush();
+}
+
+bool LogSink::ReadBlocks(const QString& path, const std::function<bool(const QByteArray&)>& block) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    if (!IsCompressedFile(&file)) {
+        while (!file.atEnd()) {
+            const QByteArray chunk = file.read(kBlockBytes);
+            if (chunk.isEmpty() || !block(chunk)) return false;
+        }
+        return true;
+    }
+
+    file.skip(sizeof(kCompressedMagic));
+    while (!file.atEnd()) {
+        uchar header[8];
+        if (file.read(reinterpret_cast<char*>(header), sizeof(header)) != sizeof(header)) {
+            return false;
+        }
+        const quint32 raw_size = qFromBigEndian<quint32>(header);
+        const quint32 packed_size = qFromBigEndian<quint32>(header + 4);
+        const QByteArray raw = qUncompress(file.read(packed_size));
+        if (static_cast<quint32>(raw.size()) != raw_size || !block(raw)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LogSink::Expand(const QString& path, QIODevice* device) {
+    return ReadBlocks(path, [device](const QByteArray& block) {
+        return device->write(block) == block.size();
+    });
+}
+
+bool LogSink::Export(const QString& path, const QString& target) {
+    QFile source(path);
+    if (!source.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const bool compressed = IsCompressedFile(&source);
+    source.close();
+
+    if (QFile::exists(target) && !QFile::remove(target)) {
+        return false;
+    }
+    if (!compressed) {
+        return QFile::copy(path, target);
+    }
+
+    QFile out(target);
+    if (!out.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    const bool ok = Expand(path, &out);
+    out.close();
+    return ok;
+}
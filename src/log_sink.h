@@ -0,0 +1,84 @@
+// log_sink.h - 运行日志落盘
+// 求解期间把每一行原始输出追加到本次运行的日志文件; 所有运行共用一个写线程, 按块批量写入
+// 可选按块压缩 (qCompress), 导出时直接复制或逐块解压
+
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QElapsedTimer>
+#include <QString>
+#include <atomic>
+#include <functional>
+
+class QFile;
+class QIODevice;
+class QObject;
+class LogWriter;
+
+class LogSink {
+public:
+    LogSink();
+    ~LogSink();
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    // 创建日志文件并登记到共用写线程; 已打开时先关闭
+    bool Open(const QString& path, bool compress);
+
+    // 追加一行 (自动补换行); 未打开时忽略, 从不阻塞调用方
+    void Write(QByteArrayView line);
+
+    // 写线程积压超过上限; 调用方应暂停产生新行, 稍后再写
+    bool Backlogged() const;
+
+    // 写出剩余内容并关闭文件 (阻塞到写完)
+    void Close();
+
+    // 通知写线程写完剩余内容后关闭文件, 立即返回; 之后在 context 所在线程调用 done
+    // context 须比本对象活得久 (通常本对象是它的成员)
+    void CloseAsync(QObject* context, std::function<void()> done);
+
+    bool IsOpen() const { return open_.load(); }
+    QString Path() const { return path_; }
+    QString ErrorString() const;
+
+    // 已写入磁盘的原始字节数 (压缩前)
+    qint64 BytesWritten() const { return bytes_written_.load(); }
+
+    // 把日志文件逐块还原为纯文本交给 block, block 返回 false 时停止
+    // 块边界不对齐行; 全部读完返回 true
+    static bool ReadBlocks(const QString& path, const std::function<bool(const QByteArray&)>& block);
+
+    // 把日志文件还原为纯文本写入 device (未压缩文件直接复制内容)
+    static bool Expand(const QString& path, QIODevice* device);
+
+    // 导出到 target: 未压缩文件复制, 压缩文件逐块解压
+    static bool Export(const QString& path, const QString& target);
+
+private:
+    friend class LogWriter;
+
+    // 写出一块 (压缩模式下附带块头), 只在写线程上调用
+    bool WriteBlock(const QByteArray& block);
+
+    QString path_;
+    bool compress_;
+    QFile* file_;             // 打开后只由写线程访问, 关闭时由写线程释放
+    std::atomic<bool> open_;
+
+    // 以下由 LogWriter 的互斥锁保护: 调用方写入 pending_, 写线程整块取走
+    QByteArray pending_;
+    QElapsedTimer flush_clock_;   // 距上次取走的时间
+    bool closing_;
+    bool closed_;
+    bool failed_;
+    QString error_;
+    std::function<void()> on_closed_;
+
+    std::atomic<qint64> bytes_written_;
+};
+
+#endif  // LOG_SINK_H
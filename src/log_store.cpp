@@ -0,0 +1,192 @@
+// log_store.cpp - 日志行存储实现
+
+#include "log_store.h"
+
+#include <QDir>
+#include <QIODevice>
+#include <QTemporaryFile>
+
+namespace {
+
+// 超出上限后再积累这么多比例的行才批量转存一次
+constexpr int kSpillSlackDivisor = 4;
+
+// 转存文件偏移表的分块行数
+constexpr qint64 kSpillBlockLines = 256;
+
+}  // namespace
+
+LogStore::LogStore(int max_lines)
+    : first_line_number_(0)
+    , max_lines_(qMax(1000, max_lines))
+    , spill_file_(nullptr)
+    , spill_bytes_(0)
+    , read_cursor_line_(-1)
+    , read_cursor_pos_(0) {
+}
+
+LogStore::~LogStore() {
+    delete spill_file_;
+}
+
+void LogStore::SetMaxLines(int max_lines) {
+    max_lines_ = qMax(1000, max_lines);
+}
+
+void LogStore::Append(const QString& message, LogTag tag, qint64 timestamp_ms) {
+    const QByteArray utf8 = message.toUtf8();
+
+    Entry entry;
+    entry.offset = static_cast<quint32>(text_.size());
+    entry.length = static_cast<quint32>(utf8.size());
+    entry.timestamp_ms = timestamp_ms;
+    entry.tag = tag;
+
+    text_.append(utf8);
+    entries_.append(entry);
+}
+
+int LogStore::PendingSpillCount() const {
+    // 转存失败后不再尝试, 超出上限的行留在内存中
+    const int slack = max_lines_ / kSpillSlackDivisor;
+    if (!spill_error_.isEmpty() || Size() <= max_lines_ + slack) {
+        return 0;
+    }
+    return Size() - max_lines_;
+}
+
+bool LogStore::WriteSpill(int count) {
+    count = qMin(count, Size());
+    if (count <= 0) return true;
+
+    if (!spill_file_) {
+        spill_file_ = new QTemporaryFile(QDir::tempPath() + "/gm-ntg-log-XXXXXX.txt");
+        if (!spill_file_->open()) {
+            spill_error_ = spill_file_->errorString();
+            delete spill_file_;
+            spill_file_ = nullptr;
+            return false;
+        }
+    }
+
+    // 写入失败 (如磁盘已满) 时撤销本批, 文件保持上一次转存后的内容
+    const qint64 old_bytes = spill_bytes_;
+    const qsizetype old_blocks = spill_block_offsets_.size();
+    spill_file_->seek(spill_bytes_);
+    bool ok = true;
+    for (int i = 0; i < count && ok; ++i) {
+        if ((first_line_number_ + i) % kSpillBlockLines == 0) {
+            spill_block_offsets_.append(spill_bytes_);
+        }
+        ok = spill_file_->write(LineBytes(i).data(), entries_[i].length) == qint64(entries_[i].length)
+            && spill_file_->write("\n", 1) == 1;
+        spill_bytes_ += entries_[i].length + 1;
+    }
+    ok = ok && spill_file_->flush();
+    if (!ok) {
+        spill_error_ = spill_file_->errorString();
+        spill_bytes_ = old_bytes;
+        spill_block_offsets_.resize(old_blocks);
+        spill_file_->resize(old_bytes);
+        spill_file_->seek(old_bytes);
+        return false;
+    }
+    return true;
+}
+
+void LogStore::DropSpilled(int count) {
+    count = qMin(count, Size());
+    if (count <= 0) return;
+
+    const Entry& last = entries_[count - 1];
+    const qsizetype cut = last.offset + last.length;
+
+    // 移除已转存的文本, 其余行的偏移整体前移
+    text_.remove(0, cut);
+    entries_.remove(0, count);
+    for (Entry& entry : entries_) {
+        entry.offset -= static_cast<quint32>(cut);
+    }
+    first_line_number_ += count;
+}
+
+void LogStore::Clear() {
+    text_.clear();
+    entries_.clear();
+    first_line_number_ = 0;
+    delete spill_file_;
+    spill_file_ = nullptr;
+    spill_block_offsets_.clear();
+    spill_bytes_ = 0;
+    spill_error_.clear();
+    read_cursor_line_ = -1;
+    read_cursor_pos_ = 0;
+}
+
+QByteArrayView LogStore::LineBytes(int row) const {
+    const Entry& entry = entries_[row];
+    return QByteArrayView(text_.constData() + entry.offset, entry.length);
+}
+
+QString LogStore::LineText(int row) const {
+    return QString::fromUtf8(LineBytes(row));
+}
+
+QString LogStore::ReadLine(qint64 line_number) const {
+    if (line_number >= first_line_number_) {
+        const qint64 row = line_number - first_line_number_;
+        return row < entries_.size() ? LineText(static_cast<int>(row)) : QString();
+    }
+    if (line_number < 0 || !spill_file_ || !spill_file_->isOpen()) {
+        return QString();
+    }
+
+    // 从所在块的起点 (或上次读取位置) 顺序跳到目标行
+    qint64 line = (line_number / kSpillBlockLines) * kSpillBlockLines;
+    qint64 pos = spill_block_offsets_.value(line / kSpillBlockLines, -1);
+    if (pos < 0) {
+        return QString();
+    }
+    if (read_cursor_line_ > line && read_cursor_line_ <= line_number) {
+        line = read_cursor_line_;
+        pos = read_cursor_pos_;
+    }
+
+    spill_file_->seek(pos);
+    QByteArray bytes;
+    while (line <= line_number && !spill_file_->atEnd()) {
+        bytes = spill_file_->readLine();
+        ++line;
+    }
+    read_cursor_line_ = line;
+    read_cursor_pos_ = spill_file_->pos();
+    spill_file_->seek(spill_bytes_);
+
+    if (bytes.endsWith('\n')) {
+        bytes.chop(1);
+    }
+    return QString::fromUtf8(bytes);
+}
+
+bool LogStore::WriteAll(QIODevice* device) const {
+    // 磁盘转存部分按块复制
+    if (spill_file_ && spill_file_->isOpen()) {
+        const qint64 end = spill_bytes_;
+        spill_file_->seek(0);
+        while (spill_file_->pos() < end) {
+            const QByteArray chunk = spill_file_->read(1 << 20);
+            if (chunk.isEmpty() || device->write(chunk) != chunk.size()) {
+                return false;
+            }
+        }
+        spill_file_->seek(end);
+    }
+
+    for (int i = 0; i < Size(); ++i) {
+        if (device->write(LineBytes(i).data(), entries_[i].length) < 0
+            || device->write("\n", 1) != 1) {
+            return false;
+        }
+    }
+    return true;
+}
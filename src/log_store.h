@@ -0,0 +1,87 @@
+// log_store.h - 日志行存储
+// 文本连续存放在一块缓冲区, 每行只记录偏移, 标签类别和时间戳
+// 超过保留上限时把最早的行转存到磁盘
+
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include "log_tag.h"
+
+#include <QByteArray>
+#include <QString>
+#include <QVector>
+
+class QIODevice;
+class QTemporaryFile;
+
+class LogStore {
+public:
+    explicit LogStore(int max_lines = 200000);
+    ~LogStore();
+
+    // 内存中保留的最大行数 (超出部分转存到磁盘)
+    void SetMaxLines(int max_lines);
+    int MaxLines() const { return max_lines_; }
+
+    // 追加一行
+    void Append(const QString& message, LogTag tag, qint64 timestamp_ms);
+
+    // 超出保留上限时需要转存的行数 (按批转存, 避免每行搬移); 转存失败后为 0
+    int PendingSpillCount() const;
+
+    // 把最早的 count 行写入磁盘 (内存不变); 失败时记录原因并返回 false, 这些行留在内存中
+    bool WriteSpill(int count);
+
+    // 从内存移除已写入磁盘的最早 count 行
+    void DropSpilled(int count);
+
+    // 转存失败的原因 (未失败时为空, Clear 后重新尝试)
+    const QString& SpillError() const { return spill_error_; }
+
+    // 清空内存和磁盘中的全部行
+    void Clear();
+
+    // 内存中的行数, 第一行的全局行号, 以及含转存部分的总行数
+    int Size() const { return static_cast<int>(entries_.size()); }
+    qint64 FirstLineNumber() const { return first_line_number_; }
+    qint64 TotalLines() const { return first_line_number_ + entries_.size(); }
+
+    // 第 row 行 (内存内下标)
+    QByteArrayView LineBytes(int row) const;
+    QString LineText(int row) const;
+    LogTag Tag(int row) const { return entries_[row].tag; }
+    qint64 Timestamp(int row) const { return entries_[row].timestamp_ms; }
+
+    // 按全局行号读取一行, 已转存的行从磁盘读取 (顺序读取时复用读取位置)
+    QString ReadLine(qint64 line_number) const;
+
+    // 按顺序写出全部行 (先磁盘转存部分, 再内存部分)
+    bool WriteAll(QIODevice* device) const;
+
+private:
+    struct Entry {
+        quint32 offset;        // 在 text_ 中的字节偏移
+        quint32 length;        // 字节长度 (UTF-8, 不含换行)
+        qint64 timestamp_ms;
+        LogTag tag;
+    };
+
+    QByteArray text_;
+    QVector<Entry> entries_;
+    qint64 first_line_number_;
+    int max_lines_;
+
+    // 转存文件 (首次转存时创建, 析构时删除)
+    QTemporaryFile* spill_file_;
+
+    // 转存文件中每 kSpillBlockLines 行记录一次起始偏移, 用于随机读取
+    QVector<qint64> spill_block_offsets_;
+    qint64 spill_bytes_;
+    QString spill_error_;
+
+    // 最近一次读取转存行后的位置
+    mutable qint64 read_cursor_line_;
+    mutable qint64 read_cursor_pos_;
+};
+
+#endif  // LOG_STORE_H
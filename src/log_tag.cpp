@@ -0,0 +1,48 @@
+// log_tag.cpp - 日志行类别判断
+
+#include "log_tag.h"
+
+#include <QString>
+
+namespace {
+
+// 行首标签
+struct TagPrefix {
+    QLatin1String prefix;
+    LogTag tag;
+};
+
+const TagPrefix kTagPrefixes[] = {
+    {QLatin1String("[ERROR]"), LogTag::kError},
+    {QLatin1String("[WARN]"), LogTag::kWarn},
+    {QLatin1String("[INFO]"), LogTag::kInfo},
+    {QLatin1String("[LOAD:"), LogTag::kLoad},
+    {QLatin1String("[GRAND:"), LogTag::kGrand},
+    {QLatin1String("[ITER:"), LogTag::kIter},
+    {QLatin1String("[MP:"), LogTag::kMP},
+    {QLatin1String("[SP:"), LogTag::kSP},
+    {QLatin1String("[CUT:"), LogTag::kCut},
+    {QLatin1String("[CONVERGE:"), LogTag::kConverge},
+    {QLatin1String("[DONE:"), LogTag::kDone},
+};
+
+}  // namespace
+
+LogTag ClassifyLogLine(QStringView message) {
+    if (message.startsWith(u'[')) {
+        for (const TagPrefix& p : kTagPrefixes) {
+            if (message.startsWith(p.prefix)) {
+                return p.tag;
+            }
+        }
+    }
+
+    if (message.contains(u"[ERROR]") || message.contains(u"错误")) {
+        return LogTag::kError;
+    } else if (message.contains(u"[WARN]") || message.contains(u"警告")) {
+        return LogTag::kWarn;
+    } else if (message.contains(u"[INFO]")) {
+        return LogTag::kInfo;
+    }
+    return LogTag::kPlain;
+}
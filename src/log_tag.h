@@ -0,0 +1,32 @@
+// log_tag.h - 日志行类别
+// 求解器线程在解析时确定类别, 随日志行一起投递, 界面按类别着色和筛选
+
+#ifndef LOG_TAG_H
+#define LOG_TAG_H
+
+#include <QStringView>
+#include <QtGlobal>
+
+// 日志行类别 (决定显示颜色, 也用于索引筛选)
+enum class LogTag : quint8 {
+    kPlain,
+    kError,     // [ERROR] / 错误
+    kWarn,      // [WARN] / 警告
+    kInfo,      // [INFO]
+    kLoad,      // [LOAD:...]
+    kGrand,     // [GRAND:...]
+    kIter,      // [ITER:...]
+    kMP,        // [MP:...]
+    kSP,        // [SP:...]
+    kCut,       // [CUT:...]
+    kConverge,  // [CONVERGE:...]
+    kDone,      // [DONE:...]
+    kCount
+};
+
+constexpr int kLogTagCount = static_cast<int>(LogTag::kCount);
+
+// 按行首标签和关键字判断类别 (状态码行由解析器直接给出类别, 无需调用)
+LogTag ClassifyLogLine(QStringView message);
+
+#endif  // LOG_TAG_H
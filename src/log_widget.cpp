@@ -1,59 +1,111 @@
 // log_widget.cpp - 日志显示控件实现
+// 列表视图只绘制可见行, 行数超过保留上限后最早的行转存到磁盘
 
 #include "log_widget.h"
+#include "log_model.h"
+#include "log_search_panel.h"
 
 #include <QVBoxLayout>
-#include <QTextEdit>
+#include <QListView>
 #include <QFile>
-#include <QTextStream>
 #include <QScrollBar>
+#include <QTimer>
+#include <QSplitter>
+#include <QShortcut>
 
 LogWidget::LogWidget(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , scroll_pending_(false) {
     QVBoxLayout* layout = new QVBoxLayout(this);
     layout->setContentsMargins(0, 0, 0, 0);
 
-    text_edit_ = new QTextEdit();
-    text_edit_->setReadOnly(true);
-    text_edit_->setLineWrapMode(QTextEdit::NoWrap);
-    text_edit_->setFont(QFont("Consolas", 9));
-    text_edit_->setStyleSheet(
-        "QTextEdit {"
+    model_ = new LogModel(this);
+
+    list_view_ = new QListView();
+    list_view_->setModel(model_);
+    list_view_->setUniformItemSizes(true);
+    list_view_->setWordWrap(false);
+    list_view_->setTextElideMode(Qt::ElideNone);
+    list_view_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    list_view_->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    list_view_->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+    list_view_->setFont(QFont("Consolas", 9));
+    list_view_->setStyleSheet(
+        "QListView {"
         "  background-color: #1e1e1e;"
         "  color: #d4d4d4;"
         "  border: 1px solid #3c3c3c;"
         "}");
 
-    layout->addWidget(text_edit_);
+    search_panel_ = new LogSearchPanel(model_);
+    connect(search_panel_, &LogSearchPanel::LineActivated, this, &LogWidget::ScrollToLine);
+
+    splitter_ = new QSplitter(Qt::Vertical);
+    splitter_->addWidget(list_view_);
+    splitter_->addWidget(search_panel_);
+    splitter_->setStretchFactor(0, 3);
+    splitter_->setStretchFactor(1, 1);
+    layout->addWidget(splitter_);
+
+    // Ctrl+F 聚焦搜索框
+    QShortcut* find_shortcut = new QShortcut(QKeySequence::Find, this);
+    find_shortcut->setContext(Qt::WidgetWithChildrenShortcut);
+    connect(find_shortcut, &QShortcut::activated, search_panel_, &LogSearchPanel::FocusQuery);
 }
 
 void LogWidget::Append(const QString& message) {
-    // 根据消息类型设置颜色
-    QString colored_message = message;
-
-    if (message.contains("[ERROR]") || message.contains("错误")) {
-        colored_message = QString("<span style='color:#f44336;'>%1</span>").arg(message.toHtmlEscaped());
-    } else if (message.contains("[WARN]") || message.contains("警告")) {
-        colored_message = QString("<span style='color:#ff9800;'>%1</span>").arg(message.toHtmlEscaped());
-    } else if (message.contains("[INFO]")) {
-        colored_message = QString("<span style='color:#4caf50;'>%1</span>").arg(message.toHtmlEscaped());
-    } else if (message.contains("[CUT]")) {
-        colored_message = QString("<span style='color:#2196f3;'>%1</span>").arg(message.toHtmlEscaped());
-    } else if (message.contains("[GRAND]") || message.contains("[CONVERGE]") || message.contains("[DONE]")) {
-        colored_message = QString("<span style='color:#9c27b0;'>%1</span>").arg(message.toHtmlEscaped());
-    } else {
-        colored_message = message.toHtmlEscaped();
+    AppendLines(QStringList{message});
+}
+
+void LogWidget::AppendLines(const QStringList& messages) {
+    QVector<LogTag> tags;
+    tags.reserve(messages.size());
+    for (const QString& message : messages) {
+        tags.append(ClassifyLogLine(message));
+    }
+    AppendLines(messages, tags);
+}
+
+void LogWidget::AppendLines(const QStringList& messages, const QVector<LogTag>& tags) {
+    if (messages.isEmpty()) return;
+
+    // 只有停留在底部时才跟随滚动
+    QScrollBar* scrollbar = list_view_->verticalScrollBar();
+    const bool at_bottom = scrollbar->value() >= scrollbar->maximum();
+
+    model_->AppendLines(messages, tags);
+
+    if (at_bottom) {
+        RequestScrollToBottom();
     }
+}
 
-    text_edit_->append(colored_message);
+void LogWidget::RequestScrollToBottom() {
+    if (scroll_pending_) return;
 
-    // 滚动到底部
-    QScrollBar* scrollbar = text_edit_->verticalScrollBar();
-    scrollbar->setValue(scrollbar->maximum());
+    scroll_pending_ = true;
+    QTimer::singleShot(0, this, [this]() {
+        scroll_pending_ = false;
+        list_view_->scrollToBottom();
+    });
 }
 
 void LogWidget::Clear() {
-    text_edit_->clear();
+    search_panel_->Reset();
+    model_->Clear();
+}
+
+void LogWidget::ScrollToLine(qint64 line_number) {
+    const qint64 row = line_number - model_->Store().FirstLineNumber();
+    if (row < 0 || row >= model_->rowCount()) return;
+
+    const QModelIndex index = model_->index(static_cast<int>(row));
+    list_view_->setCurrentIndex(index);
+    list_view_->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
+
+void LogWidget::SetRetention(int max_lines) {
+    model_->Store().SetMaxLines(max_lines);
 }
 
 bool LogWidget::ExportToFile(const QString& filepath) {
@@ -62,12 +114,17 @@ bool LogWidget::ExportToFile(const QString& filepath) {
         return false;
     }
 
-    QTextStream stream(&file);
-    stream << text_edit_->toPlainText();
+    const bool ok = model_->Store().WriteAll(&file);
     file.close();
-    return true;
+    return ok;
 }
 
 QString LogWidget::GetText() const {
-    return text_edit_->toPlainText();
+    const LogStore& store = model_->Store();
+    QStringList lines;
+    lines.reserve(store.Size());
+    for (int i = 0; i < store.Size(); ++i) {
+        lines << store.LineText(i);
+    }
+    return lines.join('\n');
 }
@@ -3,9 +3,16 @@
 #ifndef LOG_WIDGET_H
 #define LOG_WIDGET_H
 
+#include "log_tag.h"
+
 #include <QWidget>
+#include <QStringList>
+#include <QVector>
 
-class QTextEdit;
+class QListView;
+class QSplitter;
+class LogModel;
+class LogSearchPanel;
 
 class LogWidget : public QWidget {
     Q_OBJECT
@@ -16,17 +23,34 @@ public:
     // 添加日志消息
     void Append(const QString& message);
 
+    // 批量添加日志消息 (一次插入, 一次滚动); 未给出类别时按内容判断
+    void AppendLines(const QStringList& messages);
+    void AppendLines(const QStringList& messages, const QVector<LogTag>& tags);
+
     // 清空日志
     void Clear();
 
+    // 内存中保留的最大行数, 更早的行转存到磁盘
+    void SetRetention(int max_lines);
+
     // 导出到文件
     bool ExportToFile(const QString& filepath);
 
-    // 获取全部文本
+    // 获取内存中的全部文本
     QString GetText() const;
 
+    // 定位到全局行号 (已转存到磁盘的行无法定位)
+    void ScrollToLine(qint64 line_number);
+
 private:
-    QTextEdit* text_edit_;
+    // 合并滚动请求, 每次重绘前最多滚动一次
+    void RequestScrollToBottom();
+
+    QSplitter* splitter_;
+    QListView* list_view_;
+    LogModel* model_;
+    LogSearchPanel* search_panel_;
+    bool scroll_pending_;
 };
 
 #endif  // LOG_WIDGET_H
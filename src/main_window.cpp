@@ -4,9 +4,16 @@
 #include "parameter_widget.h"
 #include "log_widget.h"
 #include "results_widget.h"
-#include "solver_worker.h"
+#include "solver_supervisor.h"
+#include "job_queue.h"
+#include "job_queue_panel.h"
+#include "sweep_widget.h"
 #include "analysis_widget.h"
 #include "generator_widget.h"
+#include "update_scheduler.h"
+#include "log_sink.h"
+#include "log_replay.h"
+#include "result_file.h"
 
 #include <QApplication>
 #include <QMenuBar>
@@ -20,22 +27,125 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
-#include <QSpinBox>
+#include <QCheckBox>
 #include <QSplitter>
 #include <QTabWidget>
 #include <QFileInfo>
 #include <QDir>
-#include <QJsonDocument>
 #include <QJsonArray>
 #include <QFile>
 #include <QTextStream>
+#include <QDateTime>
+#include <QTimer>
+#include <QProcess>
+
+namespace {
+
+// 求解器事件批次窗口 (毫秒)
+constexpr int kSolverBatchMinMs = 16;
+constexpr int kSolverBatchMaxMs = 50;
+
+// 求解 Tab 每秒最多刷新次数
+constexpr int kSolveViewMaxFps = 30;
+
+// 日志在内存中保留的行数, 更早的行转存到磁盘
+constexpr int kLogRetentionLines = 200000;
+
+// 运行日志目录 (相对于工作目录)
+constexpr char kRunLogDir[] = "logs";
+
+// 每次运行的结果输出目录 (相对于工作目录), 其下按运行日志名分子目录 (--output-dir)
+constexpr char kRunResultDir[] = "results";
+
+// 求解器不支持 --output-dir 时的默认结果 JSON 输出目录, 以及按任务起止时间挑选文件的余量 (毫秒)
+constexpr char kSolverResultDir[] = "D:/YM-Code/GM-NTG-Core/results";
+constexpr qint64 kFileTimeSlackMs = 2000;
+
+// 探测求解器命令行选项的超时 (毫秒)
+constexpr int kSolverProbeTimeoutMs = 5000;
+
+// 结果缓存目录 (相对于工作目录) 及淘汰条件
+constexpr char kResultCacheDir[] = "cache/results";
+constexpr qint64 kResultCacheMaxBytes = 2LL * 1024 * 1024 * 1024;
+constexpr int kResultCacheMaxDays = 30;
+
+// 约束池目录 (相对于工作目录), 热启动文件写在其下的 warm/
+constexpr char kCutPoolDir[] = "cache/cuts";
+
+// 检查点目录 (相对于工作目录) 及写盘周期
+constexpr char kCheckpointDir[] = "checkpoints";
+constexpr int kCheckpointIntervalMs = 30000;
+
+// 哈希线程上为新任务准备的内容
+struct JobPreparation {
+    QString cache_key;
+    QString instance_key;
+    QString cuts_file;      // 写出的初始约束文件, 没有时为空
+    bool output_dir = false;    // 求解器支持 --output-dir
+    CutPool::WarmStart warm_mode = CutPool::WarmStart::kNone;
+    int warm_count = 0;
+};
+
+// 求解器的 --help 输出是否列出 --output-dir; 按程序路径和修改时间缓存结果
+// 只在哈希线程 (单线程) 上调用, 缓存不加锁
+bool SolverSupportsOutputDir(const QString& solver_path) {
+    static QHash<QString, bool> cache;
+    const QFileInfo info(solver_path);
+    const QString key = info.absoluteFilePath() + '|' + QString::number(info.lastModified().toMSecsSinceEpoch());
+    const auto it = cache.constFind(key);
+    if (it != cache.constEnd()) {
+        return it.value();
+    }
+
+    QProcess process;
+    process.setProcessChannelMode(QProcess::MergedChannels);
+    process.start(solver_path, {"--help"});
+    bool supported = false;
+    if (process.waitForFinished(kSolverProbeTimeoutMs)) {
+        supported = process.readAll().contains("--output-dir");
+    } else {
+        process.kill();
+        process.waitForFinished();
+    }
+    cache.insert(key, supported);
+    return supported;
+}
+
+// 运行的阶段计时表与运行日志同名
+QString TimingCsvPath(const QString& log_file) {
+    const QFileInfo info(log_file);
+    return info.dir().filePath(info.completeBaseName() + ".timing.csv");
+}
+
+// 运行的资源采样序列与运行日志同名
+QString ResourcesCsvPath(const QString& log_file) {
+    const QFileInfo info(log_file);
+    return info.dir().filePath(info.completeBaseName() + ".resources.csv");
+}
+
+}  // namespace
 
 MainWindow::MainWindow(QWidget* parent)
     : QMainWindow(parent)
-    , solver_thread_(nullptr)
-    , solver_worker_(nullptr)
+    , solver_supervisor_(new SolverSupervisor(this))
+    , job_queue_(new JobQueue(solver_supervisor_, this))
+    , followed_job_id_(0)
+    , followed_state_(JobState::kQueued)
+    , run_log_seq_(0)
+    , result_cache_(QDir(QDir::currentPath()).filePath(kResultCacheDir))
+    , cut_pool_(QDir(QDir::currentPath()).filePath(kCutPoolDir))
+    , checkpoint_timer_(new QTimer(this))
     , is_running_(false)
-    , num_plants_(0) {
+    , log_replay_(new LogReplay(this))
+    , log_replay_request_(0)
+    , num_plants_(0)
+    , solve_view_scheduler_(new UpdateScheduler(kSolveViewMaxFps, this)) {
+    result_cache_.SetLimits(kResultCacheMaxBytes, kResultCacheMaxDays);
+    result_cache_.Evict();
+    // 同一文件的哈希只算一次, 后续请求命中缓存; 单线程也让约束池的读写按提交顺序进行
+    hash_pool_.setMaxThreadCount(1);
+    checkpoint_timer_->setInterval(kCheckpointIntervalMs);
+
     SetupUI();
     SetupMenuBar();
     SetupConnections();
@@ -46,13 +156,10 @@ MainWindow::MainWindow(QWidget* parent)
 }
 
 MainWindow::~MainWindow() {
-    if (solver_thread_ && solver_thread_->isRunning()) {
-        if (solver_worker_) {
-            solver_worker_->RequestCancel();
-        }
-        solver_thread_->quit();
-        solver_thread_->wait(3000);
-    }
+    // 先断开队列信号: 取消排队任务会同步发出 JobFinished, 析构期间不再弹窗或写缓存/检查点
+    // 进程由 solver_supervisor_ 析构时结束
+    job_queue_->disconnect(this);
+    job_queue_->CancelAll();
 }
 
 void MainWindow::SetupUI() {
@@ -67,10 +174,12 @@ void MainWindow::SetupUI() {
     main_tab_widget_ = new QTabWidget();
 
     SetupSolveTab();
+    SetupSweepTab();
     SetupAnalysisTab();
     SetupGeneratorTab();
 
     main_tab_widget_->addTab(solve_tab_, "求解");
+    main_tab_widget_->addTab(sweep_tab_, "参数扫描");
     main_tab_widget_->addTab(analysis_tab_, "分析");
     main_tab_widget_->addTab(generator_tab_, "算例生成");
 
@@ -87,6 +196,10 @@ void MainWindow::SetupMenuBar() {
     connect(open_action, &QAction::triggered, this, &MainWindow::OnBrowseFile);
     file_menu->addAction(open_action);
 
+    QAction* resume_action = new QAction("从检查点继续(&R)...", this);
+    connect(resume_action, &QAction::triggered, this, &MainWindow::OnResumeFromCheckpoint);
+    file_menu->addAction(resume_action);
+
     QAction* export_action = new QAction("导出日志(&E)...", this);
     export_action->setShortcut(QKeySequence::Save);
     connect(export_action, &QAction::triggered, this, &MainWindow::OnExportLog);
@@ -165,10 +278,23 @@ void MainWindow::SetupSolveTab() {
     start_button_->setStyleSheet("font-weight: bold;");
     cancel_button_ = new QPushButton("取消");
     cancel_button_->setMinimumHeight(32);
+    resume_button_ = new QPushButton("继续...");
+    resume_button_->setMinimumHeight(32);
+    resume_button_->setToolTip("从检查点继续中断的运行");
     button_row->addWidget(start_button_);
     button_row->addWidget(cancel_button_);
+    button_row->addWidget(resume_button_);
     control_layout->addLayout(button_row);
 
+    force_resolve_check_ = new QCheckBox("强制重新求解");
+    force_resolve_check_->setToolTip("忽略结果缓存, 相同实例和参数也重新运行求解器");
+    control_layout->addWidget(force_resolve_check_);
+
+    warm_start_check_ = new QCheckBox("约束池热启动");
+    warm_start_check_->setChecked(true);
+    warm_start_check_->setToolTip("把此前运行发现的联盟约束作为初始约束集传给求解器 (--cuts-file)");
+    control_layout->addWidget(warm_start_check_);
+
     status_label_ = new QLabel("就绪");
     status_label_->setAlignment(Qt::AlignCenter);
     status_label_->setStyleSheet("color: #666;");
@@ -181,8 +307,13 @@ void MainWindow::SetupSolveTab() {
     left_layout->addWidget(results_widget_);
 
     // 导出按钮
+    QHBoxLayout* export_layout = new QHBoxLayout();
     export_log_button_ = new QPushButton("导出日志...");
-    left_layout->addWidget(export_log_button_);
+    export_layout->addWidget(export_log_button_, 1);
+    compress_log_check_ = new QCheckBox("压缩");
+    compress_log_check_->setToolTip("运行日志按块压缩存储, 导出时自动解压");
+    export_layout->addWidget(compress_log_check_);
+    left_layout->addLayout(export_layout);
 
     left_layout->addStretch();
 
@@ -192,37 +323,24 @@ void MainWindow::SetupSolveTab() {
     right_layout->setSpacing(8);
     right_layout->setContentsMargins(0, 0, 0, 0);
 
-    // CPLEX 设置
-    QGroupBox* cplex_group = new QGroupBox("CPLEX");
-    QHBoxLayout* cplex_layout = new QHBoxLayout(cplex_group);
-    cplex_layout->setContentsMargins(8, 12, 8, 8);
-    cplex_layout->setSpacing(12);
-
-    cplex_layout->addWidget(new QLabel("线程"));
-    cplex_threads_spin_ = new QSpinBox();
-    cplex_threads_spin_->setRange(0, 64);
-    cplex_threads_spin_->setValue(0);
-    cplex_threads_spin_->setSpecialValueText("自动");
-    cplex_threads_spin_->setFixedWidth(90);
-    cplex_layout->addWidget(cplex_threads_spin_);
-
-    cplex_layout->addWidget(new QLabel("内存"));
-    cplex_memory_spin_ = new QSpinBox();
-    cplex_memory_spin_->setRange(512, 65536);
-    cplex_memory_spin_->setValue(4096);
-    cplex_memory_spin_->setSuffix(" MB");
-    cplex_memory_spin_->setSingleStep(512);
-    cplex_memory_spin_->setFixedWidth(90);
-    cplex_layout->addWidget(cplex_memory_spin_);
-
-    cplex_layout->addStretch();
-    right_layout->addWidget(cplex_group);
+    // 求解队列 (资源预算 + 任务列表)
+    QGroupBox* queue_group = new QGroupBox("求解队列");
+    QVBoxLayout* queue_layout = new QVBoxLayout(queue_group);
+    queue_layout->setContentsMargins(8, 12, 8, 8);
+    job_queue_panel_ = new JobQueuePanel(job_queue_);
+    job_queue_panel_->setMaximumHeight(230);
+    queue_layout->addWidget(job_queue_panel_);
+    resource_label_ = new QLabel("资源: -");
+    resource_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    queue_layout->addWidget(resource_label_);
+    right_layout->addWidget(queue_group);
 
     // 运行日志
     QGroupBox* log_group = new QGroupBox("运行日志");
     QVBoxLayout* log_layout = new QVBoxLayout(log_group);
     log_layout->setContentsMargins(8, 12, 8, 8);
     log_widget_ = new LogWidget();
+    log_widget_->SetRetention(kLogRetentionLines);
     log_layout->addWidget(log_widget_);
     right_layout->addWidget(log_group, 1);
 
@@ -271,6 +389,16 @@ void MainWindow::SetupSolveTab() {
     tab_layout->addWidget(solve_splitter_);
 }
 
+void MainWindow::SetupSweepTab() {
+    sweep_tab_ = new QWidget();
+    QVBoxLayout* layout = new QVBoxLayout(sweep_tab_);
+    layout->setContentsMargins(8, 8, 8, 8);
+
+    sweep_widget_ = new SweepWidget(job_queue_);
+    sweep_widget_->SetBaseParameters(parameter_widget_->GetParameters());
+    layout->addWidget(sweep_widget_);
+}
+
 void MainWindow::SetupAnalysisTab() {
     analysis_tab_ = new QWidget();
     QVBoxLayout* layout = new QVBoxLayout(analysis_tab_);
@@ -281,6 +409,9 @@ void MainWindow::SetupAnalysisTab() {
     QHBoxLayout* toolbar = new QHBoxLayout();
     load_result_button_ = new QPushButton("加载结果文件...");
     toolbar->addWidget(load_result_button_);
+    convert_result_button_ = new QPushButton("转换格式...");
+    convert_result_button_->setToolTip("结果 JSON 与二进制结果文件 (.gmr) 互相转换");
+    toolbar->addWidget(convert_result_button_);
     toolbar->addStretch();
     layout->addLayout(toolbar);
 
@@ -302,30 +433,100 @@ void MainWindow::SetupConnections() {
     // 文件操作
     connect(browse_button_, &QPushButton::clicked, this, &MainWindow::OnBrowseFile);
     connect(load_result_button_, &QPushButton::clicked, this, &MainWindow::OnLoadResultFile);
+    connect(convert_result_button_, &QPushButton::clicked, this, &MainWindow::OnConvertResultFiles);
+
+    // 缓存日志回放: 只接收当前请求的批次
+    connect(log_replay_, &LogReplay::LinesReady, this,
+            [this](int request_id, const QStringList& lines, const QVector<LogTag>& tags) {
+        if (request_id == log_replay_request_) {
+            log_widget_->AppendLines(lines, tags);
+        }
+    });
+    connect(log_replay_, &LogReplay::Finished, this, [this](int request_id, bool ok) {
+        if (request_id != log_replay_request_) return;
+        log_replay_request_ = 0;
+        if (!ok) {
+            log_widget_->Append("[WARN] 缓存的运行日志无法完整读取");
+        }
+    });
 
     // 运行控制
     connect(start_button_, &QPushButton::clicked, this, &MainWindow::OnStartSolver);
     connect(cancel_button_, &QPushButton::clicked, this, &MainWindow::OnCancelSolver);
+    connect(resume_button_, &QPushButton::clicked, this, &MainWindow::OnResumeFromCheckpoint);
+    connect(checkpoint_timer_, &QTimer::timeout, this, &MainWindow::SaveCheckpoints);
 
     // 导出日志
     connect(export_log_button_, &QPushButton::clicked, this, &MainWindow::OnExportLog);
 
     // Tab 切换
     connect(main_tab_widget_, &QTabWidget::currentChanged, this, &MainWindow::OnTabChanged);
+
+    // 参数扫描
+    connect(sweep_widget_, &SweepWidget::SweepRequested, this, &MainWindow::OnSweepRequested);
+
+    // 结果文件在后台加载, 失败时提示
+    connect(analysis_widget_, &AnalysisWidget::LoadFailed, this,
+            [this](const QString& /*path*/, const QString& error) {
+        QMessageBox::warning(this, "错误", error);
+    });
+
+    // 求解队列: 界面只跟随一个任务
+    connect(job_queue_panel_, &JobQueuePanel::AddFilesRequested, this, &MainWindow::OnAddJobFiles);
+    connect(job_queue_panel_, &JobQueuePanel::JobActivated, this, &MainWindow::FollowJob);
+    connect(job_queue_, &JobQueue::JobEvents, this,
+            [this](int job_id, const QVector<SolverEvent>& events) {
+        // 所有任务的进度都记入检查点, 约束结束时并入约束池
+        auto record = job_records_.find(job_id);
+        if (record != job_records_.end()) {
+            if (record->checkpoint.Apply(events)) {
+                record->checkpoint_dirty = true;
+            }
+            record->timing.Apply(events);
+        }
+        if (job_id == followed_job_id_) {
+            OnSolverEvents(events);
+        }
+    });
+    connect(job_queue_, &JobQueue::JobChanged, this, [this](int job_id) {
+        // 只在状态切换时更新按钮和状态栏, 迭代进度由 FlushSolveView 显示
+        const SolveJob* job = job_queue_->Job(job_id);
+        if (job_id == followed_job_id_ && job && job->IsActive() && job->state != followed_state_) {
+            followed_state_ = job->state;
+            UpdateUIState(true);
+        }
+        if (job_id == followed_job_id_) {
+            UpdateResourceLabel();
+        }
+    });
+    connect(job_queue_, &JobQueue::JobFinished, this, [this](int job_id) {
+        if (job_id == followed_job_id_) {
+            followed_timing_ = job_records_.value(job_id).timing;
+        }
+        FinishJobRecord(job_id);
+        const SolveJob* job = job_queue_->Job(job_id);
+        if (job_id == followed_job_id_ && job) {
+            OnSolverFinished(job->state == JobState::kSucceeded, job->message,
+                             job->final_v, job->iterations, job->runtime);
+        }
+    });
+
+    // 求解 Tab 按帧刷新
+    connect(solve_view_scheduler_, &UpdateScheduler::UpdateDue, this, &MainWindow::FlushSolveView);
 }
 
 void MainWindow::UpdateUIState(bool is_running) {
     is_running_ = is_running;
 
-    browse_button_->setEnabled(!is_running);
-    parameter_widget_->setEnabled(!is_running);
-    start_button_->setEnabled(!is_running && !current_file_.isEmpty());
+    // 新任务总是可以加入队列; 取消和导出针对当前跟随的任务
+    start_button_->setEnabled(!current_file_.isEmpty());
     cancel_button_->setEnabled(is_running);
     export_log_button_->setEnabled(!is_running);
 
     if (is_running) {
-        status_label_->setText("运行中...");
-        statusBar()->showMessage("运行中...");
+        const QString text = (followed_state_ == JobState::kQueued) ? "排队中..." : "运行中...";
+        status_label_->setText(text);
+        statusBar()->showMessage(text);
     } else {
         status_label_->setText("就绪");
         statusBar()->showMessage("就绪");
@@ -369,7 +570,7 @@ void MainWindow::OnBrowseFile() {
             .arg(info.fileName()).arg(info.size() / 1024));
         file_info_label_->setStyleSheet("color: black; font-size: 9pt;");
 
-        UpdateUIState(false);
+        UpdateUIState(is_running_);
         log_widget_->Append("文件: " + file);
     }
 }
@@ -382,31 +583,43 @@ void MainWindow::OnLoadResultFile() {
 
     QString file = QFileDialog::getOpenFileName(
         this, "选择结果文件", default_dir,
-        "JSON 文件 (*.json);;所有文件 (*)");
+        "结果文件 (*.json *.gmr);;所有文件 (*)");
 
-    if (!file.isEmpty() && LoadResultJson(file)) {
-        analysis_widget_->LoadResult(current_result_);
+    if (!file.isEmpty()) {
+        analysis_widget_->LoadFile(file);
     }
 }
 
-bool MainWindow::LoadResultJson(const QString& filepath) {
-    QFile file(filepath);
-    if (!file.open(QIODevice::ReadOnly)) {
-        QMessageBox::warning(this, "错误", "无法打开文件: " + filepath);
-        return false;
+void MainWindow::OnConvertResultFiles() {
+    QString default_dir = "D:/YM-Code/GM-NTG-Core/results";
+    if (!QDir(default_dir).exists()) {
+        default_dir = QDir::currentPath();
     }
 
-    QJsonParseError error;
-    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &error);
-    file.close();
-
-    if (error.error != QJsonParseError::NoError) {
-        QMessageBox::warning(this, "错误", "JSON 解析错误: " + error.errorString());
-        return false;
+    const QStringList files = QFileDialog::getOpenFileNames(
+        this, "选择要转换的结果文件", default_dir,
+        "结果文件 (*.json *.gmr);;所有文件 (*)");
+    if (files.isEmpty()) return;
+
+    // 逐个转换, 已存在的同名目标文件不覆盖
+    int converted = 0;
+    QStringList errors;
+    for (const QString& file : files) {
+        const QString target = ResultFile::ConvertedPath(file);
+        QString error;
+        if (QFileInfo::exists(target)) {
+            errors.append(QFileInfo(file).fileName() + ": 目标文件已存在");
+        } else if (ResultFile::Convert(file, target, &error)) {
+            ++converted;
+        } else {
+            errors.append(QFileInfo(file).fileName() + ": " + error);
+        }
     }
 
-    current_result_ = doc.object();
-    return true;
+    statusBar()->showMessage(QString("已转换 %1 个结果文件").arg(converted));
+    if (!errors.isEmpty()) {
+        QMessageBox::warning(this, "转换失败", errors.join("\n"));
+    }
 }
 
 void MainWindow::OnStartSolver() {
@@ -415,16 +628,361 @@ void MainWindow::OnStartSolver() {
         return;
     }
 
+    // 相同实例, 参数和求解器已有结果时直接显示; 键在哈希线程上计算, 算完再决定是否入队
+    const QString solver_path = GetSolverExePath();
+    if (!force_resolve_check_->isChecked() && !solver_path.isEmpty()) {
+        const QString data_file = current_file_;
+        statusBar()->showMessage("检查结果缓存...");
+        ComputeCacheKey(data_file, JobParameters(), solver_path, [this, data_file](const QString& key) {
+            ResultCache::Entry entry;
+            if (!key.isEmpty() && result_cache_.Lookup(key, &entry)) {
+                ShowCachedResult(entry);
+                return;
+            }
+            const int job_id = EnqueueJob(data_file);
+            if (job_id > 0) {
+                FollowJob(job_id);
+            }
+        });
+        return;
+    }
+
+    const int job_id = EnqueueJob(current_file_);
+    if (job_id > 0) {
+        FollowJob(job_id);
+    }
+}
+
+void MainWindow::ComputeCacheKey(const QString& data_file, const QVariantMap& params,
+                                 const QString& solver_path, std::function<void(const QString&)> done) {
+    hash_pool_.start([this, data_file, params, solver_path, done]() {
+        const QString key = result_cache_.Key(data_file, params, solver_path);
+        QMetaObject::invokeMethod(this, [done, key]() { done(key); }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::ShowCachedResult(const ResultCache::Entry& entry) {
+    followed_job_id_ = 0;
+    run_log_path_ = entry.log_file;
+    followed_timing_.Clear();
+    ResetSolveView();
+    UpdateUIState(false);
+
+    log_widget_->Append(QString("命中结果缓存 (%1 求解)").arg(entry.created.toString("yyyy-MM-dd HH:mm:ss")));
+    if (!entry.log_file.isEmpty()) {
+        // 日志在回放线程上还原和分类, 按批追加, 界面线程不等整个文件
+        log_replay_request_ = log_replay_->Start(entry.log_file);
+    }
+
+    v_star_label_->setText(QString::number(entry.final_v, 'f', 6));
+    iterations_label_->setText(QString("%1 次 / %2 s").arg(entry.iterations).arg(entry.runtime, 0, 'f', 2));
+    UpdateCoreStatus(entry.final_v);
+    status_label_->setText("完成 (缓存)");
+    statusBar()->showMessage("已加载缓存结果");
+
+    if (!entry.result_file.isEmpty()) {
+        analysis_widget_->LoadFile(entry.result_file);
+        main_tab_widget_->setCurrentWidget(analysis_tab_);
+    }
+}
+
+void MainWindow::FinishJobRecord(int job_id) {
+    JobRecord record = job_records_.take(job_id);
+    const SolveJob* job = job_queue_->Job(job_id);
+    if (!job) return;
+
+    if (!record.warm_start_file.isEmpty()) {
+        QFile::remove(record.warm_start_file);
+    }
+
+    if (!record.timing.IsEmpty() && !job->log_file.isEmpty()) {
+        record.timing.WriteCsv(TimingCsvPath(job->log_file));
+    }
+    if (!job->resources.isEmpty() && !job->log_file.isEmpty()) {
+        ResourceSampler::WriteCsv(ResourcesCsvPath(job->log_file), job->resources, job->usage);
+    }
+
+    // 失败或取消的运行发现的约束同样有效; 约束池只在哈希线程上访问
+    if (!record.instance_key.isEmpty() && !record.checkpoint.cuts.isEmpty()) {
+        hash_pool_.start([this, instance_key = record.instance_key, data_file = job->data_file,
+                          cuts = record.checkpoint.cuts]() {
+            cut_pool_.Add(instance_key, data_file, cuts);
+        });
+    }
+
+    if (job->state != JobState::kSucceeded) {
+        // 中断的运行保留最终检查点, 之后可以继续
+        if (record.checkpoint.iteration > 0 && record.checkpoint.Save(record.checkpoint_file)) {
+            if (job_id == followed_job_id_) {
+                OnLogMessage("检查点已保存: " + record.checkpoint_file);
+            }
+        }
+        return;
+    }
+
+    QFile::remove(record.checkpoint_file);
+    if (!record.resumed_from.isEmpty()) {
+        QFile::remove(record.resumed_from);
+    }
+    if (record.cache_key.isEmpty()) return;
+
+    ResultCache::Entry entry;
+    entry.key = record.cache_key;
+    entry.result_file = FindResultFile(*job);
+    entry.log_file = job->log_file;
+    entry.data_file = job->data_file;
+    entry.final_v = job->final_v;
+    entry.iterations = job->iterations;
+    entry.runtime = job->runtime;
+    if (!entry.result_file.isEmpty()) {
+        result_cache_.Store(entry);
+    }
+}
+
+QString MainWindow::FindResultFile(const SolveJob& job) const {
+    // 本次运行自己的目录, 其他并发任务的结果不会混进来
+    const QString result_dir = job.params.value("result_dir").toString();
+    if (!result_dir.isEmpty()) {
+        const QFileInfoList files = QDir(result_dir).entryInfoList({"result_*.json"}, QDir::Files, QDir::Time);
+        if (!files.isEmpty()) {
+            return files.first().absoluteFilePath();
+        }
+    }
+
+    // 求解器不支持 --output-dir (或没有写到那里): 在默认目录中取任务起止时间之间最新的结果
+    const qint64 finished_ms = job.finished_ms > 0 ? job.finished_ms : QDateTime::currentMSecsSinceEpoch();
+    const QFileInfoList files = QDir(kSolverResultDir).entryInfoList({"result_*.json"}, QDir::Files, QDir::Time);
+    for (const QFileInfo& info : files) {
+        const qint64 modified_ms = info.lastModified().toMSecsSinceEpoch();
+        if (modified_ms > finished_ms + kFileTimeSlackMs) continue;
+        if (modified_ms + kFileTimeSlackMs < job.started_ms) break;
+        return info.absoluteFilePath();
+    }
+    return QString();
+}
+
+void MainWindow::OnAddJobFiles() {
+    const QStringList files = QFileDialog::getOpenFileNames(
+        this, "添加数据文件到队列", QDir::currentPath(),
+        "CSV 文件 (*.csv);;所有文件 (*)");
+
+    // 批量添加的任务按后台任务运行 (预算设置了后台 nice 时降低优先级)
+    const QVariantMap background{{"background", true}};
+    for (const QString& file : files) {
+        if (EnqueueJob(file, background) <= 0) break;
+    }
+}
+
+void MainWindow::OnSweepRequested(const QString& data_file, const QVector<QVariantMap>& combos) {
+    int added = 0;
+    for (const QVariantMap& combo : combos) {
+        QVariantMap overrides = combo;
+        overrides["background"] = true;
+        // 各组合从相同起点比较计时: 不用约束池热启动, 否则先结束的组合会加速后面的组合
+        const int job_id = EnqueueJob(data_file, overrides, nullptr, false);
+        if (job_id <= 0) break;
+        sweep_widget_->AddRun(job_id, combo);
+        ++added;
+    }
+    statusBar()->showMessage(QString("参数扫描: %1 个组合已加入队列").arg(added));
+}
+
+int MainWindow::EnqueueJob(const QString& data_file, const QVariantMap& overrides,
+                           const SolveCheckpoint* resume, bool warm_start) {
     QString solver_path = GetSolverExePath();
     if (solver_path.isEmpty()) {
         QMessageBox::critical(this, "错误",
             "找不到求解器 GM-NTG-Core.exe\n"
             "请确保已编译 GM-NTG-Core 项目");
+        return 0;
+    }
+
+    QVariantMap params = JobParameters(overrides);
+    const QString log_file = NewRunLogPath(params["log_compress"].toBool());
+
+    // 缓存键在任务结束时才用到, 与实例键一起由哈希线程算好后补进记录
+    const QVariantMap key_params = params;
+    JobRecord record;
+
+    // 检查点与运行日志同名
+    QDir dir(QDir::currentPath());
+    const QString run_name = QFileInfo(log_file).completeBaseName();
+    if (dir.mkpath(kCheckpointDir)) {
+        record.checkpoint_file = dir.filePath(QString(kCheckpointDir) + "/" + run_name + ".ckpt");
+    }
+    record.checkpoint.data_file = QFileInfo(data_file).absoluteFilePath();
+    record.checkpoint.params = params;
+
+    // 结果输出到本次运行自己的目录, 结束时缓存和加载的正是这次的结果
+    // 求解器是否支持 --output-dir 在哈希线程上探测, 支持时才随放行加入参数
+    const QString result_dir = QString(kRunResultDir) + "/" + run_name;
+    const QString result_path = run_name.isEmpty() ? QString() : dir.filePath(result_dir);
+
+    // 初始约束文件与运行日志同名
+    const QString warm_dir = QString(kCutPoolDir) + "/warm";
+    const QString warm_path = dir.filePath(warm_dir + "/" + run_name + ".cuts");
+
+    // 续算: 检查点的约束作为初始约束, 进度接着检查点; 否则按设置用约束池热启动
+    QVector<CutPool::Cut> resume_cuts;
+    QString resume_key;
+    if (resume) {
+        record.checkpoint.iteration = resume->iteration;
+        record.checkpoint.v = resume->v;
+        record.checkpoint.allocation = resume->allocation;
+        record.checkpoint.cuts = resume->cuts;
+        params["iteration_offset"] = resume->iteration;
+        resume_cuts = resume->cuts;
+        resume_key = resume->instance_key;
+    }
+    const bool use_pool = !resume && warm_start && warm_start_check_->isChecked();
+    const bool want_cuts = (use_pool || !resume_cuts.isEmpty()) && dir.mkpath(warm_dir);
+
+    // 任务先挂起入队 (队列面板立即可见, 可以取消); 哈希和初始约束文件在哈希线程上准备好后才放行
+    const int job_id = job_queue_->Enqueue(solver_path, data_file, params, log_file, true);
+    job_records_.insert(job_id, record);
+    hash_pool_.start([this, job_id, data_file, key_params, solver_path, result_path,
+                      cuts_path = want_cuts ? warm_path : QString(), resume_cuts, resume_key]() {
+        JobPreparation prep;
+        prep.cache_key = result_cache_.Key(data_file, key_params, solver_path);
+        prep.instance_key = CutPool::InstanceKey(data_file);
+        prep.output_dir = !result_path.isEmpty() && SolverSupportsOutputDir(solver_path)
+                          && QDir().mkpath(result_path);
+        if (!cuts_path.isEmpty() && !resume_cuts.isEmpty()) {
+            // 实例已改动时只给联盟
+            if (CutPool::WriteCutsFile(cuts_path, resume_cuts, resume_key == prep.instance_key)) {
+                prep.cuts_file = cuts_path;
+            }
+        } else if (!cuts_path.isEmpty() && !prep.instance_key.isEmpty()) {
+            prep.warm_mode = cut_pool_.WriteWarmStart(prep.instance_key, data_file, cuts_path, &prep.warm_count);
+            if (prep.warm_mode != CutPool::WarmStart::kNone) {
+                prep.cuts_file = cuts_path;
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, job_id, prep, result_path]() {
+            auto it = job_records_.find(job_id);
+            if (it == job_records_.end()) {
+                // 挂起期间已取消, 记录已移除
+                if (!prep.cuts_file.isEmpty()) {
+                    QFile::remove(prep.cuts_file);
+                }
+                return;
+            }
+            it->cache_key = prep.cache_key;
+            it->instance_key = prep.instance_key;
+            it->checkpoint.instance_key = prep.instance_key;
+            it->warm_start_file = prep.cuts_file;
+
+            QVariantMap ready;
+            if (!prep.cuts_file.isEmpty()) {
+                ready["cuts_file"] = prep.cuts_file;
+            }
+            if (prep.output_dir) {
+                ready["result_dir"] = result_path;
+            }
+            if (prep.warm_mode != CutPool::WarmStart::kNone) {
+                statusBar()->showMessage(QString("约束池热启动: %1 条%2").arg(prep.warm_count)
+                    .arg(prep.warm_mode == CutPool::WarmStart::kExact ? "" : " (实例已改动, 成本由求解器重算)"));
+            }
+            job_queue_->Release(job_id, ready);
+        }, Qt::QueuedConnection);
+    });
+    if (!checkpoint_timer_->isActive()) {
+        checkpoint_timer_->start();
+    }
+    return job_id;
+}
+
+void MainWindow::SaveCheckpoints() {
+    for (JobRecord& record : job_records_) {
+        if (record.checkpoint_dirty && !record.checkpoint_file.isEmpty()) {
+            record.checkpoint.Save(record.checkpoint_file);
+            record.checkpoint_dirty = false;
+        }
+    }
+    if (job_records_.isEmpty()) {
+        checkpoint_timer_->stop();
+    }
+}
+
+void MainWindow::OnResumeFromCheckpoint() {
+    const QString file = QFileDialog::getOpenFileName(
+        this, "选择检查点", QDir(QDir::currentPath()).filePath(kCheckpointDir),
+        "检查点 (*.ckpt);;所有文件 (*)");
+    if (file.isEmpty()) return;
+
+    SolveCheckpoint checkpoint;
+    QString error;
+    if (!SolveCheckpoint::Load(file, &checkpoint, &error)) {
+        QMessageBox::warning(this, "错误", "无法读取检查点: " + error);
+        return;
+    }
+    if (!QFileInfo::exists(checkpoint.data_file)) {
+        QMessageBox::warning(this, "错误", "数据文件不存在: " + checkpoint.data_file);
         return;
     }
 
+    const int job_id = EnqueueJob(checkpoint.data_file, checkpoint.params, &checkpoint);
+    if (job_id <= 0) return;
+    job_records_[job_id].resumed_from = file;
+    FollowJob(job_id);
+
+    // 先显示检查点时的分配和约束, 之后由新进程的事件接着更新
+    if (!checkpoint.allocation.isEmpty()) {
+        results_widget_->SetProblemSize(static_cast<int>(checkpoint.allocation.size()));
+        results_widget_->SetAllocation(checkpoint.allocation);
+        v_star_label_->setText(QString::number(checkpoint.v, 'f', 6));
+        UpdateCoreStatus(checkpoint.v);
+    }
+    QVector<ResultsWidget::CutRow> rows;
+    rows.reserve(checkpoint.cuts.size());
+    for (const CutPool::Cut& cut : std::as_const(checkpoint.cuts)) {
+        rows.append(ResultsWidget::CutRow{cut.first, cut.second, 0.0});
+    }
+    results_widget_->AddCoalitionCuts(rows);
+    log_widget_->Append(QString("从检查点继续: 迭代 %1, %2 条约束, v = %3")
+        .arg(checkpoint.iteration).arg(checkpoint.cuts.size()).arg(checkpoint.v, 0, 'f', 6));
+}
+
+QVariantMap MainWindow::JobParameters(const QVariantMap& overrides) const {
+    // 线程数和内存由队列按资源预算分配
+    QVariantMap params = parameter_widget_->GetParameters();
+    for (auto it = overrides.cbegin(); it != overrides.cend(); ++it) {
+        params.insert(it.key(), it.value());
+    }
+    // 事件批次窗口
+    params["batch_min_ms"] = kSolverBatchMinMs;
+    params["batch_max_ms"] = kSolverBatchMaxMs;
+    // 运行日志
+    params["log_compress"] = compress_log_check_->isChecked();
+    return params;
+}
+
+void MainWindow::FollowJob(int job_id) {
+    const SolveJob* job = job_queue_->Job(job_id);
+    if (!job) return;
+
+    followed_job_id_ = job_id;
+    followed_state_ = job->state;
+    run_log_path_ = job->log_file;
+    followed_timing_.Clear();
+    ResetSolveView();
+
+    log_widget_->Append(QString("跟随任务 #%1: %2").arg(job_id).arg(job->data_file));
+    if (job->state == JobState::kSucceeded) {
+        v_star_label_->setText(QString::number(job->final_v, 'f', 6));
+        iterations_label_->setText(QString("%1 次 / %2 s")
+            .arg(job->iterations).arg(job->runtime, 0, 'f', 2));
+        UpdateCoreStatus(job->final_v);
+    }
+    UpdateUIState(job->IsActive());
+}
+
+void MainWindow::ResetSolveView() {
+    log_replay_->Cancel();
+    log_replay_request_ = 0;
     log_widget_->Clear();
     results_widget_->Clear();
+    pending_view_ = PendingSolveView();
 
     // 清空摘要
     grand_cost_label_->setText("-");
@@ -432,49 +990,52 @@ void MainWindow::OnStartSolver() {
     core_status_label_->setText("-");
     core_status_label_->setStyleSheet("");
     iterations_label_->setText("-");
-
-    solver_thread_ = new QThread(this);
-    solver_worker_ = new SolverWorker();
-    solver_worker_->moveToThread(solver_thread_);
-
-    connect(solver_thread_, &QThread::started, solver_worker_, [this, solver_path]() {
-        QVariantMap params = parameter_widget_->GetParameters();
-        // 添加 CPLEX 参数
-        params["cplex_threads"] = cplex_threads_spin_->value();
-        params["cplex_memory"] = cplex_memory_spin_->value();
-        solver_worker_->Run(solver_path, current_file_, params);
-    });
-    connect(solver_worker_, &SolverWorker::DataLoaded, this, &MainWindow::OnDataLoaded);
-    connect(solver_worker_, &SolverWorker::GrandCoalitionComputed, this, &MainWindow::OnGrandCoalitionComputed);
-    connect(solver_worker_, &SolverWorker::IterationStarted, this, &MainWindow::OnIterationStarted);
-    connect(solver_worker_, &SolverWorker::MPSolved, this, &MainWindow::OnMPSolved);
-    connect(solver_worker_, &SolverWorker::SPResult, this, &MainWindow::OnSPResult);
-    connect(solver_worker_, &SolverWorker::Converged, this, &MainWindow::OnConverged);
-    connect(solver_worker_, &SolverWorker::CutAdded, this, &MainWindow::OnCutAdded);
-    connect(solver_worker_, &SolverWorker::Finished, this, &MainWindow::OnSolverFinished);
-    connect(solver_worker_, &SolverWorker::LogMessage, this, &MainWindow::OnLogMessage);
-
-    connect(solver_worker_, &SolverWorker::Finished, solver_thread_, &QThread::quit);
-    connect(solver_thread_, &QThread::finished, solver_worker_, &QObject::deleteLater);
-    connect(solver_thread_, &QThread::finished, solver_thread_, &QObject::deleteLater);
-    connect(solver_thread_, &QThread::finished, this, [this]() {
-        solver_thread_ = nullptr;
-        solver_worker_ = nullptr;
-    });
-
-    UpdateUIState(true);
-    log_widget_->Append("开始求解...");
-    solver_thread_->start();
+    resource_label_->setText("资源: -");
 }
 
 void MainWindow::OnCancelSolver() {
-    if (solver_worker_) {
-        solver_worker_->RequestCancel();
+    const SolveJob* job = job_queue_->Job(followed_job_id_);
+    if (job && job->IsActive()) {
+        job_queue_->Cancel(followed_job_id_);
         status_label_->setText("取消中...");
         statusBar()->showMessage("取消中...");
     }
 }
 
+void MainWindow::OnSolverEvents(const QVector<SolverEvent>& events) {
+    for (const SolverEvent& event : events) {
+        switch (event.type) {
+        case SolverEventType::kDataLoaded:
+            OnDataLoaded(event.ints[0], event.ints[1], event.ints[2], event.ints[3]);
+            break;
+        case SolverEventType::kGrandCoalition:
+            OnGrandCoalitionComputed(event.values[0], event.values[1]);
+            break;
+        case SolverEventType::kIterationStarted:
+            OnIterationStarted(event.ints[0]);
+            break;
+        case SolverEventType::kMPSolved:
+            OnMPSolved(event.pi, event.values[0], event.values[1]);
+            break;
+        case SolverEventType::kSPResult:
+            OnSPResult(event.coalition, event.values[0], event.values[1]);
+            break;
+        case SolverEventType::kCutAdded:
+            OnCutAdded(event.coalition, event.values[0]);
+            break;
+        case SolverEventType::kConverged:
+            OnConverged(event.values[0]);
+            break;
+        case SolverEventType::kLog:
+            break;
+        }
+
+        if (!event.message.isEmpty()) {
+            OnLogMessage(event.message, event.log_tag);
+        }
+    }
+}
+
 void MainWindow::OnDataLoaded(int plants, int items, int families, int periods) {
     num_plants_ = plants;
     file_info_label_->setText(QString("P=%1 N=%2 G=%3 T=%4")
@@ -485,21 +1046,67 @@ void MainWindow::OnDataLoaded(int plants, int items, int families, int periods)
 
 void MainWindow::OnGrandCoalitionComputed(double cost, double runtime) {
     grand_cost_label_->setText(QString::number(cost, 'f', 2));
-    log_widget_->Append(QString("大联盟成本 c(P) = %1 (用时 %2s)")
+    OnLogMessage(QString("大联盟成本 c(P) = %1 (用时 %2s)")
         .arg(cost, 0, 'f', 2).arg(runtime, 0, 'f', 2));
 }
 
 void MainWindow::OnIterationStarted(int iteration) {
-    status_label_->setText(QString("迭代 %1...").arg(iteration));
-    statusBar()->showMessage(QString("迭代 %1...").arg(iteration));
+    pending_view_.status_text = QString("迭代 %1...").arg(iteration);
+    solve_view_scheduler_->RequestUpdate();
 }
 
 void MainWindow::OnMPSolved(const QVector<double>& pi, double v, double runtime) {
     Q_UNUSED(runtime);
-    results_widget_->SetAllocation(pi);
-    v_star_label_->setText(QString::number(v, 'f', 6));
+    // 只保留最新分配, 下一帧统一刷新
+    pending_view_.allocation_dirty = true;
+    pending_view_.allocation = pi;
+    pending_view_.v = v;
+    solve_view_scheduler_->RequestUpdate();
+}
+
+void MainWindow::OnSPResult(const Coalition& coalition, double cost, double violation) {
+    pending_view_.cuts.append(ResultsWidget::CutRow{coalition, cost, violation});
+    solve_view_scheduler_->RequestUpdate();
+}
+
+void MainWindow::OnConverged(double epsilon) {
+    OnLogMessage(QString("算法收敛 (epsilon = %1)").arg(epsilon, 0, 'e', 2));
+}
+
+void MainWindow::OnCutAdded(const Coalition& coalition, double cost) {
+    OnLogMessage(QString("添加联盟约束 S=%1, c(S)=%2")
+        .arg(coalition.ToString()).arg(cost, 0, 'f', 2));
+}
+
+void MainWindow::FlushSolveView() {
+    PendingSolveView& pending = pending_view_;
+
+    if (pending.allocation_dirty) {
+        results_widget_->SetAllocation(pending.allocation);
+        v_star_label_->setText(QString::number(pending.v, 'f', 6));
+        UpdateCoreStatus(pending.v);
+        pending.allocation_dirty = false;
+    }
+
+    if (!pending.status_text.isEmpty()) {
+        status_label_->setText(pending.status_text);
+        statusBar()->showMessage(pending.status_text);
+        pending.status_text.clear();
+    }
 
-    // 更新核状态
+    if (!pending.cuts.isEmpty()) {
+        results_widget_->AddCoalitionCuts(pending.cuts);
+        pending.cuts.clear();
+    }
+
+    if (!pending.log_lines.isEmpty()) {
+        log_widget_->AppendLines(pending.log_lines, pending.log_tags);
+        pending.log_lines.clear();
+        pending.log_tags.clear();
+    }
+}
+
+void MainWindow::UpdateCoreStatus(double v) {
     const double eps = 1e-6;
     if (v <= eps) {
         core_status_label_->setText("核非空");
@@ -510,22 +1117,33 @@ void MainWindow::OnMPSolved(const QVector<double>& pi, double v, double runtime)
     }
 }
 
-void MainWindow::OnSPResult(const QString& coalition, double cost, double violation) {
-    results_widget_->AddCoalitionCut(coalition, cost, violation);
-}
-
-void MainWindow::OnConverged(double epsilon) {
-    log_widget_->Append(QString("算法收敛 (epsilon = %1)").arg(epsilon, 0, 'e', 2));
-}
-
-void MainWindow::OnCutAdded(const QString& coalition, double cost) {
-    log_widget_->Append(QString("添加联盟约束 S=%1, c(S)=%2")
-        .arg(coalition).arg(cost, 0, 'f', 2));
+void MainWindow::UpdateResourceLabel() {
+    const SolveJob* job = job_queue_->Job(followed_job_id_);
+    if (!job) return;
+
+    if (job->state == JobState::kRunning && !job->resources.isEmpty()) {
+        const ResourceSample& sample = job->resources.last();
+        resource_label_->setText(QString("资源: CPU %1% · 内存 %2 · 读 %3/s · 写 %4/s · %5 线程")
+            .arg(sample.cpu_percent, 0, 'f', 0)
+            .arg(FormatBytes(sample.rss_kb * 1024.0))
+            .arg(FormatBytes(sample.read_bps), FormatBytes(sample.write_bps))
+            .arg(sample.threads));
+    } else if (!job->IsActive() && job->usage.samples > 0) {
+        const ResourceUsage& usage = job->usage;
+        resource_label_->setText(QString("资源合计: CPU 用户 %1 s / 系统 %2 s · 峰值内存 %3 · 读 %4 · 写 %5")
+            .arg(usage.user_s, 0, 'f', 1)
+            .arg(usage.system_s, 0, 'f', 1)
+            .arg(FormatBytes(usage.peak_rss_kb * 1024.0))
+            .arg(FormatBytes(usage.read_bytes), FormatBytes(usage.write_bytes)));
+    }
 }
 
 void MainWindow::OnSolverFinished(bool success, const QString& message,
                                    double final_v, int iterations, double runtime) {
+    // 先刷新积压内容, 避免覆盖最终摘要
+    solve_view_scheduler_->FlushNow();
     UpdateUIState(false);
+    UpdateResourceLabel();
 
     if (success) {
         status_label_->setText("完成");
@@ -536,26 +1154,27 @@ void MainWindow::OnSolverFinished(bool success, const QString& message,
         iterations_label_->setText(QString("%1 次 / %2 s").arg(iterations).arg(runtime, 0, 'f', 2));
 
         // 更新核状态
-        const double eps = 1e-6;
-        if (final_v <= eps) {
-            core_status_label_->setText("核非空");
-            core_status_label_->setStyleSheet("color: #4CAF50; font-weight: bold;");
-        } else {
-            core_status_label_->setText(QString("核为空 (v*=%1)").arg(final_v, 0, 'f', 4));
-            core_status_label_->setStyleSheet("color: #FB8C00; font-weight: bold;");
-        }
-
-        // 自动加载最新结果到分析面板
-        QString results_dir = "D:/YM-Code/GM-NTG-Core/results";
-        QDir dir(results_dir);
-        QStringList filters;
-        filters << "result_*.json";
-        QFileInfoList files = dir.entryInfoList(filters, QDir::Files, QDir::Time);
-        if (!files.isEmpty()) {
-            if (LoadResultJson(files.first().absoluteFilePath())) {
-                analysis_widget_->LoadResult(current_result_);
+        UpdateCoreStatus(final_v);
+
+        // 自动加载本次运行的结果到分析面板
+        const SolveJob* job = job_queue_->Job(followed_job_id_);
+        const QString result_file = job ? FindResultFile(*job) : QString();
+        if (!result_file.isEmpty()) {
+            // 附上本次运行的阶段计时, 迭代面板据此画用时图
+            QJsonObject extra;
+            if (!followed_timing_.IsEmpty()) {
+                extra["phase_timing"] = followed_timing_.ToJson();
+            }
+            if (job->usage.samples > 0) {
+                extra["resource_usage"] = job->usage.ToJson();
             }
+            analysis_widget_->LoadFile(result_file, extra);
         }
+    } else if (const SolveJob* job = job_queue_->Job(followed_job_id_);
+               job && job->state == JobState::kCancelled) {
+        // 用户取消的任务不弹窗
+        status_label_->setText("已取消");
+        statusBar()->showMessage(message);
     } else {
         status_label_->setText("失败");
         statusBar()->showMessage("优化失败");
@@ -563,8 +1182,10 @@ void MainWindow::OnSolverFinished(bool success, const QString& message,
     }
 }
 
-void MainWindow::OnLogMessage(const QString& message) {
-    log_widget_->Append(message);
+void MainWindow::OnLogMessage(const QString& message, LogTag tag) {
+    pending_view_.log_lines.append(message);
+    pending_view_.log_tags.append(tag);
+    solve_view_scheduler_->RequestUpdate();
 }
 
 void MainWindow::OnExportLog() {
@@ -574,15 +1195,54 @@ void MainWindow::OnExportLog() {
         "文本文件 (*.txt)");
 
     if (!file.isEmpty()) {
-        if (log_widget_->ExportToFile(file)) {
-            QMessageBox::information(this, "导出成功",
-                QString("日志已导出到: %1").arg(file));
+        // 有运行日志时直接复制, 否则导出界面中的内容
+        const bool ok = (!run_log_path_.isEmpty() && QFile::exists(run_log_path_))
+            ? LogSink::Export(run_log_path_, file)
+            : log_widget_->ExportToFile(file);
+        if (ok) {
+            // 阶段计时表和资源采样随日志一并导出
+            QString message = QString("日志已导出到: %1").arg(file);
+            const QString timing_file = run_log_path_.isEmpty() ? QString() : TimingCsvPath(run_log_path_);
+            if (!timing_file.isEmpty() && QFile::exists(timing_file)) {
+                const QString target = TimingCsvPath(file);
+                QFile::remove(target);
+                if (QFile::copy(timing_file, target)) {
+                    message += QString("\n阶段计时: %1").arg(target);
+                }
+            }
+            const QString resources_file = run_log_path_.isEmpty() ? QString() : ResourcesCsvPath(run_log_path_);
+            if (!resources_file.isEmpty() && QFile::exists(resources_file)) {
+                const QString target = ResourcesCsvPath(file);
+                QFile::remove(target);
+                if (QFile::copy(resources_file, target)) {
+                    message += QString("\n资源采样: %1").arg(target);
+                }
+            }
+            QMessageBox::information(this, "导出成功", message);
         } else {
             QMessageBox::warning(this, "导出失败", "无法写入文件");
         }
     }
 }
 
+QString MainWindow::NewRunLogPath(bool compress) {
+    QDir dir(QDir::currentPath());
+    if (!dir.mkpath(kRunLogDir)) {
+        return QString();
+    }
+    // 压缩日志不是纯文本, 用 .logz 区分
+    // 同一秒内加入的多个任务用序号区分
+    const QString name = QString("solver_%1_%2.%3")
+        .arg(QDateTime::currentDateTime().toString("yyyyMMdd_HHmmss"))
+        .arg(++run_log_seq_)
+        .arg(compress ? "logz" : "log");
+    return dir.filePath(QString(kRunLogDir) + "/" + name);
+}
+
 void MainWindow::OnTabChanged(int index) {
-    Q_UNUSED(index);
+    // 参数扫描以求解 Tab 的当前设置为基准
+    if (main_tab_widget_->widget(index) == sweep_tab_) {
+        sweep_widget_->SetBaseParameters(parameter_widget_->GetParameters());
+        sweep_widget_->SetDataFile(current_file_);
+    }
 }
@@ -1,25 +1,40 @@
 // main_window.h - 主窗口
-// Tab 结构: 求解 | 分析 | 实例生成
+// Tab 结构: 求解 | 参数扫描 | 分析 | 实例生成
 
 #ifndef MAIN_WINDOW_H
 #define MAIN_WINDOW_H
 
+#include "results_widget.h"
+#include "solver_event.h"
+#include "job_queue.h"
+#include "result_cache.h"
+#include "cut_pool.h"
+#include "checkpoint.h"
+#include "phase_timing.h"
+
 #include <QMainWindow>
-#include <QThread>
+#include <QHash>
 #include <QJsonObject>
+#include <QThreadPool>
+#include <functional>
 
 class QTabWidget;
 class QLineEdit;
 class QPushButton;
+class QCheckBox;
 class QLabel;
 class QSplitter;
-class QSpinBox;
+class QTimer;
 class ParameterWidget;
 class LogWidget;
-class ResultsWidget;
-class SolverWorker;
+class SolverSupervisor;
+class JobQueue;
+class JobQueuePanel;
+class UpdateScheduler;
+class SweepWidget;
 class AnalysisWidget;
 class GeneratorWidget;
+class LogReplay;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -33,21 +48,40 @@ private slots:
     void OnBrowseFile();
     void OnLoadResultFile();
 
-    // 运行控制
+    // 结果文件在 JSON 和二进制格式之间转换 (输出到同目录)
+    void OnConvertResultFiles();
+
+    // 运行控制: 运行 = 当前文件加入队列并跟随该任务
     void OnStartSolver();
     void OnCancelSolver();
 
-    // 求解器信号响应
+    // 从检查点继续: 带着已有约束重新启动, 迭代号接着编号
+    void OnResumeFromCheckpoint();
+
+    // 写出有变化的运行中任务检查点
+    void SaveCheckpoints();
+
+    // 求解队列
+    void OnAddJobFiles();
+    void FollowJob(int job_id);
+
+    // 参数扫描: 每个组合以当前参数为基准加入队列
+    void OnSweepRequested(const QString& data_file, const QVector<QVariantMap>& combos);
+
+    // 求解器事件批次, 按顺序分派到下列响应函数
+    void OnSolverEvents(const QVector<SolverEvent>& events);
+
+    // 求解器事件响应
     void OnDataLoaded(int plants, int items, int families, int periods);
     void OnGrandCoalitionComputed(double cost, double runtime);
     void OnIterationStarted(int iteration);
     void OnMPSolved(const QVector<double>& pi, double v, double runtime);
-    void OnSPResult(const QString& coalition, double cost, double violation);
+    void OnSPResult(const Coalition& coalition, double cost, double violation);
     void OnConverged(double epsilon);
-    void OnCutAdded(const QString& coalition, double cost);
+    void OnCutAdded(const Coalition& coalition, double cost);
     void OnSolverFinished(bool success, const QString& message,
                           double final_v, int iterations, double runtime);
-    void OnLogMessage(const QString& message);
+    void OnLogMessage(const QString& message, LogTag tag = LogTag::kPlain);
 
     // 日志导出
     void OnExportLog();
@@ -55,11 +89,15 @@ private slots:
     // Tab 切换
     void OnTabChanged(int index);
 
+    // 按帧刷新求解 Tab (合并期间的分配, 摘要, 约束行和日志)
+    void FlushSolveView();
+
 private:
     // 初始化界面
     void SetupUI();
     void SetupMenuBar();
     void SetupSolveTab();
+    void SetupSweepTab();
     void SetupAnalysisTab();
     void SetupGeneratorTab();
     void SetupConnections();
@@ -68,8 +106,41 @@ private:
     // 获取求解器路径
     QString GetSolverExePath() const;
 
-    // 加载结果 JSON
-    bool LoadResultJson(const QString& filepath);
+    // 为新任务生成运行日志路径
+    QString NewRunLogPath(bool compress);
+
+    // 当前参数 (及覆盖值) 加上界面的批次/日志设置
+    QVariantMap JobParameters(const QVariantMap& overrides = QVariantMap()) const;
+
+    // 以当前参数 (及覆盖值) 把数据文件加入队列, 失败返回 0
+    // resume 非空时以检查点的约束作为初始约束, 并接着检查点的迭代号
+    // warm_start 为 false 时不使用约束池热启动 (参数扫描)
+    // 任务先挂起入队, 缓存键, 实例键和初始约束文件在哈希线程上准备好后才放行调度
+    int EnqueueJob(const QString& data_file, const QVariantMap& overrides = QVariantMap(),
+                   const SolveCheckpoint* resume = nullptr, bool warm_start = true);
+
+    // 清空求解 Tab 的日志, 表格和摘要
+    void ResetSolveView();
+
+    // 在哈希线程上计算缓存键 (实例文件和求解器程序的内容哈希), 完成后在界面线程调用 done
+    void ComputeCacheKey(const QString& data_file, const QVariantMap& params,
+                         const QString& solver_path, std::function<void(const QString&)> done);
+
+    // 缓存命中: 直接显示缓存的日志和结果, 不启动求解器
+    void ShowCachedResult(const ResultCache::Entry& entry);
+
+    // 任务结束: 成功时结果存入缓存并删除检查点, 否则写出最终检查点; 发现的约束并入约束池
+    void FinishJobRecord(int job_id);
+
+    // 任务写出的结果 JSON: 先找运行结果目录 (任务参数 result_dir),
+    // 再在求解器默认目录中按任务起止时间挑选, 都没有时返回空串
+    QString FindResultFile(const SolveJob& job) const;
+
+    // 更新核状态标签
+    void UpdateCoreStatus(double v);
+
+    // 跟随任务的资源占用: 运行中为最近一次采样, 结束后为合计
+    void UpdateResourceLabel();
 
     // 主 Tab 控件
     QTabWidget* main_tab_widget_;
@@ -85,13 +156,17 @@ private:
     ParameterWidget* parameter_widget_;
     QPushButton* start_button_;
     QPushButton* cancel_button_;
+    QPushButton* resume_button_;
+    QCheckBox* force_resolve_check_;
+    QCheckBox* warm_start_check_;
     QLabel* status_label_;
     QPushButton* export_log_button_;
+    QCheckBox* compress_log_check_;
     ResultsWidget* results_widget_;
 
     // 右侧面板
-    QSpinBox* cplex_threads_spin_;
-    QSpinBox* cplex_memory_spin_;
+    JobQueuePanel* job_queue_panel_;
+    QLabel* resource_label_;
     LogWidget* log_widget_;
 
     // 求解结果摘要
@@ -101,26 +176,76 @@ private:
     QLabel* iterations_label_;
     QLabel* runtime_label_;
 
+    // ========== 参数扫描 Tab ==========
+    QWidget* sweep_tab_;
+    SweepWidget* sweep_widget_;
+
     // ========== 分析 Tab ==========
     QWidget* analysis_tab_;
     AnalysisWidget* analysis_widget_;
     QPushButton* load_result_button_;
+    QPushButton* convert_result_button_;
 
     // ========== 实例生成 Tab ==========
     QWidget* generator_tab_;
     GeneratorWidget* generator_widget_;
 
-    // 求解器线程
-    QThread* solver_thread_;
-    SolverWorker* solver_worker_;
+    // 求解进程管理 (I/O 线程), 任务队列及界面跟随的任务
+    SolverSupervisor* solver_supervisor_;
+    JobQueue* job_queue_;
+    int followed_job_id_;
+    JobState followed_state_;
+    int run_log_seq_;
+
+    // 结果缓存和约束池
+    ResultCache result_cache_;
+    CutPool cut_pool_;
+
+    // 哈希线程: 缓存键, 实例键和热启动文件都在这里算, 约束池只在这个线程上访问
+    // 声明在 result_cache_ 和 cut_pool_ 之后, 析构时先等哈希任务结束
+    QThreadPool hash_pool_;
+
+    // 各任务的检查点及结束时要存入缓存/约束池的内容
+    struct JobRecord {
+        QString cache_key;
+        QString instance_key;
+        QString warm_start_file;
+        SolveCheckpoint checkpoint;
+        PhaseTiming timing;
+        QString checkpoint_file;
+        bool checkpoint_dirty = false;
+        QString resumed_from;    // 续算来源的检查点, 成功后删除
+    };
+    QHash<int, JobRecord> job_records_;
+    QTimer* checkpoint_timer_;
 
     // 状态
     bool is_running_;
     QString current_file_;
 
-    // 当前结果数据 (用于分析)
-    QJsonObject current_result_;
+    // 跟随任务的运行日志文件及结束时的阶段计时
+    QString run_log_path_;
+    PhaseTiming followed_timing_;
+
+    // 缓存命中时后台回放缓存的运行日志
+    LogReplay* log_replay_;
+    int log_replay_request_;
+
+    // 当前实例的工厂数
     int num_plants_;
+
+    // 求解 Tab 待刷新内容, 由 solve_view_scheduler_ 按帧合并刷新
+    struct PendingSolveView {
+        bool allocation_dirty = false;
+        QVector<double> allocation;
+        double v = 0.0;
+        QString status_text;
+        QVector<ResultsWidget::CutRow> cuts;
+        QStringList log_lines;
+        QVector<LogTag> log_tags;
+    };
+    PendingSolveView pending_view_;
+    UpdateScheduler* solve_view_scheduler_;
 };
 
 #endif  // MAIN_WINDOW_H
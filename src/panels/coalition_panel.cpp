@@ -5,16 +5,53 @@
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QHeaderView>
 #include <QLabel>
 #include <QGroupBox>
 #include <QComboBox>
-#include <QJsonArray>
+
+namespace {
+
+// 约束表格: 列顺序与 CutStore::SortKey 一致, 直接使用其预先排好的下标
+ColumnTable BuildCutTable(const CutStore& store) {
+    ColumnTable table(store.Count());
+    table.AddInteger("迭代", store.Iterations());
+    table.AddCoalition("联盟 S", store.Masks(), store.WideCoalitions());
+    table.AddInteger("规模 |S|", store.Sizes());
+    table.AddDouble("联盟成本 c(S)", store.Costs(), 2);
+    table.AddDouble("分配之和", store.AllocSums(), 2);
+    const int slack_column = table.AddDouble("松弛量", store.Slacks(), 4);
+
+    for (int key = 0; key < CutStore::kSortKeyCount; ++key) {
+        table.SetOrder(key, store.Order(static_cast<CutStore::SortKey>(key)));
+    }
+
+    // 紧约束标注并着橙色, 违反红色, 其余绿色
+    table.SetColumnRoles(slack_column, [store](int row, int role) -> QVariant {
+        if (role == Qt::DisplayRole && store.IsTight(row)) {
+            return QString::number(store.Slack(row), 'f', 4) + " (紧)";
+        }
+        if (role == Qt::ForegroundRole) {
+            if (store.IsTight(row)) return QColor("#FB8C00");
+            return QColor(store.Slack(row) < 0 ? "#e53935" : "#4CAF50");
+        }
+        return QVariant();
+    });
+    return table;
+}
+
+}  // namespace
 
 CoalitionPanel::CoalitionPanel(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , cut_model_(new ColumnTableModel(this))
+    , cut_proxy_(new ColumnSortFilterProxy(this))
+    , v_star_(0.0)
+    , loaded_(false) {
+    // 没有数据时也保留各列, 列宽不随换表重置
+    cut_model_->SetTable(BuildCutTable(store_));
+    cut_proxy_->setSourceModel(cut_model_);
     SetupUI();
 }
 
@@ -28,11 +65,11 @@ void CoalitionPanel::SetupUI() {
 
     QLabel* filter_label = new QLabel("筛选:");
     filter_combo_ = new QComboBox();
+    // 顺序与 CutStore::Filter 一致; 排序点击表头
     filter_combo_->addItems({
         "全部联盟",
         "仅违反约束",
-        "仅紧约束",
-        "按规模排序"
+        "仅紧约束"
     });
     connect(filter_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &CoalitionPanel::OnFilterChanged);
@@ -47,21 +84,23 @@ void CoalitionPanel::SetupUI() {
     QGroupBox* table_group = new QGroupBox("约束联盟列表");
     QVBoxLayout* table_layout = new QVBoxLayout(table_group);
 
-    coalition_table_ = new QTableWidget();
-    coalition_table_->setColumnCount(6);
-    coalition_table_->setHorizontalHeaderLabels({
-        "迭代", "联盟 S", "规模 |S|", "联盟成本 c(S)",
-        "分配之和", "松弛量"
-    });
+    coalition_table_ = new QTableView();
+    coalition_table_->setModel(cut_proxy_);
 
     coalition_table_->horizontalHeader()->setStretchLastSection(true);
     coalition_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
+    coalition_table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     coalition_table_->setColumnWidth(0, 60);
     coalition_table_->setColumnWidth(1, 150);
     coalition_table_->setColumnWidth(2, 60);
     coalition_table_->setAlternatingRowColors(true);
+    coalition_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
     coalition_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
 
+    // 初始按加入顺序显示, 点击表头按该列排序 (预先排好的下标)
+    coalition_table_->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    coalition_table_->setSortingEnabled(true);
+
     table_layout->addWidget(coalition_table_);
     main_layout->addWidget(table_group);
 
@@ -84,116 +123,25 @@ void CoalitionPanel::SetupUI() {
     main_layout->addStretch();
 }
 
-void CoalitionPanel::LoadData(const QJsonObject& result) {
-    current_result_ = result;
-    UpdateTable();
+void CoalitionPanel::LoadData(const CoalitionData& data) {
+    // 约束的列, 松弛量和排序下标已在加载线程上准备好, 这里只换模型的数据
+    store_ = data.cuts;
+    cut_model_->SetTable(BuildCutTable(store_));
+    cut_proxy_->SetRowFilter(store_.FilterBits(static_cast<CutStore::Filter>(filter_combo_->currentIndex())));
+    v_star_ = data.v_star;
+    loaded_ = true;
+    UpdateStats();
 }
 
-void CoalitionPanel::OnFilterChanged(int /*index*/) {
-    UpdateTable();
+void CoalitionPanel::OnFilterChanged(int index) {
+    cut_proxy_->SetRowFilter(store_.FilterBits(static_cast<CutStore::Filter>(index)));
+    UpdateStats();
 }
 
-void CoalitionPanel::UpdateTable() {
-    if (current_result_.isEmpty()) return;
-
-    // 获取联盟约束列表
-    QJsonArray cuts = current_result_["cuts"].toArray();
-    QJsonArray alloc_array = current_result_["allocation_array"].toArray();
-    double v_star = current_result_["least_core_slack"].toDouble();
-
-    int filter = filter_combo_->currentIndex();
-
-    // 收集要显示的联盟
-    struct CoalitionInfo {
-        int iteration;
-        QJsonArray members;
-        double cost;
-        double alloc_sum;
-        double slack;
-    };
-    QVector<CoalitionInfo> display_list;
-
-    for (int i = 0; i < cuts.size(); ++i) {
-        QJsonObject cut = cuts[i].toObject();
-        QJsonArray members = cut["coalition"].toArray();
-        double cost = cut["cost"].toDouble();
-
-        // 计算分配之和
-        double alloc_sum = 0;
-        for (int j = 0; j < members.size(); ++j) {
-            int u = members[j].toInt();
-            if (u < alloc_array.size()) {
-                alloc_sum += alloc_array[u].toDouble();
-            }
-        }
-
-        double slack = cost + v_star - alloc_sum;
-
-        CoalitionInfo info;
-        info.iteration = cut["iteration"].toInt(i + 1);
-        info.members = members;
-        info.cost = cost;
-        info.alloc_sum = alloc_sum;
-        info.slack = slack;
-
-        // 根据筛选条件决定是否显示
-        bool show = true;
-        if (filter == 1) {
-            // 仅违反约束 (slack < 0)
-            show = (slack < -1e-6);
-        } else if (filter == 2) {
-            // 仅紧约束 (slack ~= 0)
-            show = (qAbs(slack) < 1e-4);
-        }
-
-        if (show) {
-            display_list.append(info);
-        }
-    }
-
-    // 按规模排序
-    if (filter == 3) {
-        std::sort(display_list.begin(), display_list.end(),
-            [](const CoalitionInfo& a, const CoalitionInfo& b) {
-                return a.members.size() > b.members.size();
-            });
-    }
+void CoalitionPanel::UpdateStats() {
+    if (!loaded_) return;
 
-    // 填充表格
-    coalition_table_->setRowCount(display_list.size());
-
-    int tight_count = 0;
-    int violated_count = 0;
-
-    for (int i = 0; i < display_list.size(); ++i) {
-        const CoalitionInfo& info = display_list[i];
-
-        // 联盟成员字符串
-        QStringList member_strs;
-        for (int j = 0; j < info.members.size(); ++j) {
-            member_strs << QString::number(info.members[j].toInt());
-        }
-        QString coalition_str = "{" + member_strs.join(", ") + "}";
-
-        coalition_table_->setItem(i, 0, new QTableWidgetItem(QString::number(info.iteration)));
-        coalition_table_->setItem(i, 1, new QTableWidgetItem(coalition_str));
-        coalition_table_->setItem(i, 2, new QTableWidgetItem(QString::number(info.members.size())));
-        coalition_table_->setItem(i, 3, new QTableWidgetItem(QString::number(info.cost, 'f', 2)));
-        coalition_table_->setItem(i, 4, new QTableWidgetItem(QString::number(info.alloc_sum, 'f', 2)));
-
-        QTableWidgetItem* slack_item = new QTableWidgetItem(QString::number(info.slack, 'f', 4));
-        if (qAbs(info.slack) < 1e-4) {
-            slack_item->setForeground(QColor("#FB8C00"));
-            slack_item->setText(QString::number(info.slack, 'f', 4) + " (紧)");
-            tight_count++;
-        } else if (info.slack < 0) {
-            slack_item->setForeground(QColor("#e53935"));
-            violated_count++;
-        } else {
-            slack_item->setForeground(QColor("#4CAF50"));
-        }
-        coalition_table_->setItem(i, 5, slack_item);
-    }
+    const CutStore::Filter filter = static_cast<CutStore::Filter>(filter_combo_->currentIndex());
 
     // 统计信息
     stats_label_->setText(QString(
@@ -201,10 +149,10 @@ void CoalitionPanel::UpdateTable() {
         "紧约束数: %2\n"
         "当前显示: %3\n"
         "最小核松弛 v* = %4")
-        .arg(cuts.size())
-        .arg(tight_count)
-        .arg(display_list.size())
-        .arg(v_star, 0, 'f', 6));
+        .arg(store_.Count())
+        .arg(store_.TightCount(filter))
+        .arg(store_.FilteredCount(filter))
+        .arg(v_star_, 0, 'f', 6));
 
     // 解释说明
     explanation_label_->setText(
@@ -216,8 +164,11 @@ void CoalitionPanel::UpdateTable() {
 }
 
 void CoalitionPanel::Clear() {
-    current_result_ = QJsonObject();
-    coalition_table_->setRowCount(0);
+    store_.Clear();
+    cut_model_->SetTable(BuildCutTable(store_));
+    cut_proxy_->SetRowFilter(QVector<quint64>());
+    v_star_ = 0.0;
+    loaded_ = false;
     stats_label_->setText("");
     explanation_label_->setText("");
 }
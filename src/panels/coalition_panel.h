@@ -1,13 +1,15 @@
 // coalition_panel.h - 联盟分析面板
-// 显示所有添加的约束联盟、违反量分析
+// 显示所有添加的约束联盟、违反量分析; 表格为 CutStore 各列的 ColumnTable, 筛选和按列排序只切换下标视图
 
 #ifndef COALITION_PANEL_H
 #define COALITION_PANEL_H
 
+#include "../analysis_data.h"
+#include "../column_table_model.h"
+
 #include <QWidget>
-#include <QJsonObject>
 
-class QTableWidget;
+class QTableView;
 class QLabel;
 class QComboBox;
 
@@ -17,7 +19,7 @@ class CoalitionPanel : public QWidget {
 public:
     explicit CoalitionPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& result);
+    void LoadData(const CoalitionData& data);
     void Clear();
 
 private slots:
@@ -25,15 +27,18 @@ private slots:
 
 private:
     void SetupUI();
-    void UpdateTable();
+    void UpdateStats();
 
     QComboBox* filter_combo_;
-    QTableWidget* coalition_table_;
+    QTableView* coalition_table_;
+    ColumnTableModel* cut_model_;
+    ColumnSortFilterProxy* cut_proxy_;
     QLabel* stats_label_;
     QLabel* explanation_label_;
 
-    // 缓存数据
-    QJsonObject current_result_;
+    CutStore store_;
+    double v_star_;
+    bool loaded_;
 };
 
 #endif  // COALITION_PANEL_H
@@ -2,21 +2,100 @@
 // 显示迭代过程、收敛情况、每次迭代的详细信息
 
 #include "iteration_panel.h"
+#include "phase_timeline_chart.h"
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QSplitter>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QHeaderView>
 #include <QLabel>
 #include <QGroupBox>
 #include <QProgressBar>
-#include <QJsonArray>
 #include <cmath>
 
+namespace {
+
+enum Column {
+    kColumnIteration,
+    kColumnVHat,
+    kColumnDelta,
+    kColumnCoalition,
+    kColumnCost,
+    kColumnMp,
+    kColumnSp,
+    kColumnPlanning,
+    kColumnStatus,
+    kColumnCount
+};
+
+enum Status { kStatusConverged, kStatusAddCut, kStatusContinue };
+
+// 列顺序与 Column 一致; 没有计时的迭代阶段用时为 NaN (显示 "-")
+ColumnTable BuildIterationTable(const IterationData& iterations) {
+    const PhaseTiming& timing = iterations.timing;
+    const int num_iters = static_cast<int>(iterations.rows.size());
+    QVector<int> ids(num_iters);
+    QVector<double> v_hats(num_iters);
+    QVector<double> deltas(num_iters);
+    QVector<quint64> masks(num_iters);
+    QHash<int, Coalition> wide;
+    QVector<double> costs(num_iters);
+    QVector<double> mp(num_iters, std::nan(""));
+    QVector<double> sp(num_iters, std::nan(""));
+    QVector<double> planning(num_iters, std::nan(""));
+    QVector<int> status(num_iters);
+
+    for (int i = 0; i < num_iters; ++i) {
+        const IterationRow& row = iterations.rows[i];
+        ids[i] = i + 1;
+        v_hats[i] = row.v_hat;
+        deltas[i] = row.delta;
+        masks[i] = row.coalition.Mask();
+        if (row.coalition.IsWide()) {
+            wide.insert(i, row.coalition);
+        }
+        costs[i] = row.cost;
+
+        if (row.timing_row >= 0) {
+            const IterationTiming& t = timing.Rows()[row.timing_row];
+            mp[i] = t.mp;
+            sp[i] = t.sp;
+            planning[i] = t.planning;
+        }
+
+        if (row.converged) {
+            status[i] = kStatusConverged;
+        } else if (row.delta > row.v_hat + 1e-6) {
+            status[i] = kStatusAddCut;
+        } else {
+            status[i] = kStatusContinue;
+        }
+    }
+
+    ColumnTable table(num_iters);
+    table.AddInteger("迭代", ids);
+    table.AddDouble("v_hat", v_hats, 6);
+    table.AddDouble("Delta", deltas, 6);
+    table.AddCoalition("违反联盟", masks, wide);
+    table.AddDouble("联盟成本", costs, 2);
+    table.AddDouble("MP (s)", mp, 3);
+    table.AddDouble("SP (s)", sp, 3);
+    table.AddDouble("规划 (s)", planning, 3);
+    table.AddCategory("状态", status, {"收敛", "添加约束", "继续"},
+                      {QColor("#4CAF50"), QColor("#FB8C00"), QColor("#666")});
+    return table;
+}
+
+}  // namespace
+
 IterationPanel::IterationPanel(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , iteration_model_(new ColumnTableModel(this))
+    , iteration_proxy_(new ColumnSortFilterProxy(this)) {
+    // 没有数据时也保留各列, 列宽不随换表重置
+    iteration_model_->SetTable(BuildIterationTable(IterationData()));
+    iteration_proxy_->setSourceModel(iteration_model_);
     SetupUI();
 }
 
@@ -68,23 +147,36 @@ void IterationPanel::SetupUI() {
 
     main_layout->addWidget(chart_group);
 
+    // ========== 阶段用时 ==========
+    QGroupBox* timing_group = new QGroupBox("阶段用时 (每轮迭代)");
+    QVBoxLayout* timing_layout = new QVBoxLayout(timing_group);
+
+    timeline_chart_ = new PhaseTimelineChart();
+    timing_layout->addWidget(timeline_chart_);
+
+    timing_label_ = new QLabel();
+    timing_label_->setStyleSheet("color: #666;");
+    timing_layout->addWidget(timing_label_);
+
+    main_layout->addWidget(timing_group);
+
     // ========== 迭代详情表格 ==========
     QGroupBox* table_group = new QGroupBox("迭代详情");
     QVBoxLayout* table_layout = new QVBoxLayout(table_group);
 
-    iteration_table_ = new QTableWidget();
-    iteration_table_->setColumnCount(6);
-    iteration_table_->setHorizontalHeaderLabels({
-        "迭代", "v_hat", "Delta", "违反联盟",
-        "联盟成本", "状态"
-    });
+    iteration_table_ = new QTableView();
+    iteration_table_->setModel(iteration_proxy_);
 
     iteration_table_->horizontalHeader()->setStretchLastSection(true);
     iteration_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-    iteration_table_->setColumnWidth(0, 50);
-    iteration_table_->setColumnWidth(3, 120);
+    iteration_table_->setColumnWidth(kColumnIteration, 50);
+    iteration_table_->setColumnWidth(kColumnCoalition, 120);
+    iteration_table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     iteration_table_->setAlternatingRowColors(true);
+    iteration_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
     iteration_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    iteration_table_->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    iteration_table_->setSortingEnabled(true);
 
     table_layout->addWidget(iteration_table_);
     main_layout->addWidget(table_group);
@@ -96,64 +188,43 @@ void IterationPanel::SetupUI() {
     main_layout->addWidget(summary_label_);
 }
 
-void IterationPanel::LoadData(const QJsonObject& result) {
-    // 获取迭代历史
-    QJsonArray history = result["iteration_history"].toArray();
-    int num_iters = history.size();
+void IterationPanel::LoadData(const IterationData& iterations) {
+    // 迭代历史及对应的阶段计时已在加载线程上解析
+    const PhaseTiming& timing = iterations.timing;
+    const int num_iters = static_cast<int>(iterations.rows.size());
 
     v_history_.clear();
     delta_history_.clear();
+    v_history_.reserve(num_iters);
+    delta_history_.reserve(num_iters);
 
-    iteration_table_->setRowCount(num_iters);
-
-    double max_v = 0;
-    for (int i = 0; i < num_iters; ++i) {
-        QJsonObject iter = history[i].toObject();
-
-        double v_hat = iter["v_hat"].toDouble();
-        double delta = iter["delta"].toDouble();
-        QJsonArray coalition = iter["coalition"].toArray();
-        double coalition_cost = iter["coalition_cost"].toDouble();
-        bool converged = iter["converged"].toBool(false);
-
-        v_history_.append(v_hat);
-        delta_history_.append(delta);
-        max_v = qMax(max_v, v_hat);
-
-        // 联盟成员字符串
-        QStringList member_strs;
-        for (int j = 0; j < coalition.size(); ++j) {
-            member_strs << QString::number(coalition[j].toInt());
-        }
-        QString coalition_str = "{" + member_strs.join(", ") + "}";
-
-        // 填充表格
-        iteration_table_->setItem(i, 0, new QTableWidgetItem(QString::number(i + 1)));
-        iteration_table_->setItem(i, 1, new QTableWidgetItem(QString::number(v_hat, 'f', 6)));
-        iteration_table_->setItem(i, 2, new QTableWidgetItem(QString::number(delta, 'f', 6)));
-        iteration_table_->setItem(i, 3, new QTableWidgetItem(coalition_str));
-        iteration_table_->setItem(i, 4, new QTableWidgetItem(QString::number(coalition_cost, 'f', 2)));
-
-        QTableWidgetItem* status_item = new QTableWidgetItem();
-        if (converged) {
-            status_item->setText("收敛");
-            status_item->setForeground(QColor("#4CAF50"));
-        } else if (delta > v_hat + 1e-6) {
-            status_item->setText("添加约束");
-            status_item->setForeground(QColor("#FB8C00"));
-        } else {
-            status_item->setText("继续");
-            status_item->setForeground(QColor("#666"));
-        }
-        iteration_table_->setItem(i, 5, status_item);
+    for (const IterationRow& row : iterations.rows) {
+        v_history_.append(row.v_hat);
+        delta_history_.append(row.delta);
     }
+    iteration_model_->SetTable(BuildIterationTable(iterations));
 
     // 更新收敛曲线可视化
     UpdateConvergenceChart();
 
+    // 阶段用时图和合计
+    timeline_chart_->SetTiming(timing);
+    if (!timing.IsEmpty()) {
+        const IterationTiming totals = timing.Totals();
+        const double total = qMax(totals.Total(), 1e-9);
+        timing_label_->setText(QString(
+            "MP %1 s (%2%), SP %3 s (%4%), 规划 %5 s (%6%), 其他 %7 s (%8%)")
+            .arg(totals.mp, 0, 'f', 2).arg(totals.mp / total * 100, 0, 'f', 1)
+            .arg(totals.sp, 0, 'f', 2).arg(totals.sp / total * 100, 0, 'f', 1)
+            .arg(totals.planning, 0, 'f', 2).arg(totals.planning / total * 100, 0, 'f', 1)
+            .arg(totals.other, 0, 'f', 2).arg(totals.other / total * 100, 0, 'f', 1));
+    } else {
+        timing_label_->setText("");
+    }
+
     // 汇总信息
-    double final_v = result["least_core_slack"].toDouble();
-    double runtime = result["runtime_seconds"].toDouble();
+    const double final_v = iterations.final_v;
+    const double runtime = iterations.runtime;
 
     QString status_str;
     if (final_v < 1e-6) {
@@ -240,9 +311,11 @@ void IterationPanel::UpdateConvergenceChart() {
 void IterationPanel::Clear() {
     v_history_.clear();
     delta_history_.clear();
-    iteration_table_->setRowCount(0);
+    iteration_model_->SetTable(BuildIterationTable(IterationData()));
     summary_label_->setText("");
     convergence_label_->setText("");
+    timeline_chart_->Clear();
+    timing_label_->setText("");
 
     // 隐藏所有条形图
     QVBoxLayout* bars_layout = qobject_cast<QVBoxLayout*>(chart_placeholder_->layout());
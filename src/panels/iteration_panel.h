@@ -1,15 +1,18 @@
 // iteration_panel.h - 迭代历史面板
-// 显示迭代过程、收敛曲线、每次迭代的详细信息
+// 显示迭代过程、收敛曲线、每次迭代的详细信息及阶段用时
 
 #ifndef ITERATION_PANEL_H
 #define ITERATION_PANEL_H
 
+#include "../analysis_data.h"
+#include "../column_table_model.h"
+
 #include <QWidget>
-#include <QJsonObject>
 
-class QTableWidget;
+class QTableView;
 class QLabel;
 class QCustomPlot;
+class PhaseTimelineChart;
 
 class IterationPanel : public QWidget {
     Q_OBJECT
@@ -17,16 +20,20 @@ class IterationPanel : public QWidget {
 public:
     explicit IterationPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& result);
+    void LoadData(const IterationData& iterations);
     void Clear();
 
 private:
     void SetupUI();
     void UpdateConvergenceChart();
 
-    QTableWidget* iteration_table_;
+    QTableView* iteration_table_;
+    ColumnTableModel* iteration_model_;
+    ColumnSortFilterProxy* iteration_proxy_;
     QWidget* chart_placeholder_;  // 收敛曲线占位 (可扩展为 QCustomPlot)
     QLabel* convergence_label_;
+    PhaseTimelineChart* timeline_chart_;
+    QLabel* timing_label_;
     QLabel* summary_label_;
 
     // 缓存数据
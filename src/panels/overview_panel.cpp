@@ -9,7 +9,6 @@
 #include <QFrame>
 #include <QProgressBar>
 #include <QGroupBox>
-#include <QJsonArray>
 
 OverviewPanel::OverviewPanel(QWidget* parent)
     : QWidget(parent) {
@@ -132,30 +131,27 @@ QFrame* OverviewPanel::CreateMetricCard(const QString& title, QLabel*& value_lab
     return card;
 }
 
-void OverviewPanel::LoadData(const QJsonObject& result) {
-    // 加载指标
-    double grand_cost = result["grand_coalition_cost"].toDouble();
-    double v_star = result["least_core_slack"].toDouble();
-    int iterations = result["iterations"].toInt();
-    double runtime = result["runtime_seconds"].toDouble();
+void OverviewPanel::LoadData(const AnalysisData& data) {
+    const OverviewData& overview = data.overview;
 
-    grand_cost_value_->setText(QString::number(grand_cost, 'f', 2));
-    v_star_value_->setText(QString::number(v_star, 'f', 6));
-    iterations_value_->setText(QString::number(iterations));
-    runtime_value_->setText(QString("%1 s").arg(runtime, 0, 'f', 2));
+    // 加载指标
+    grand_cost_value_->setText(QString::number(overview.grand_cost, 'f', 2));
+    v_star_value_->setText(QString::number(overview.v_star, 'f', 6));
+    iterations_value_->setText(QString::number(overview.iterations));
+    runtime_value_->setText(QString("%1 s").arg(overview.runtime, 0, 'f', 2));
 
     // 加载分配
-    QJsonArray alloc_array = result["allocation_array"].toArray();
-    int num_plants = alloc_array.size();
+    const QVector<double>& allocation = overview.allocation;
+    const int num_plants = static_cast<int>(allocation.size());
 
     double total = 0;
-    for (int i = 0; i < num_plants; ++i) {
-        total += alloc_array[i].toDouble();
+    for (double pi : allocation) {
+        total += pi;
     }
 
     for (int i = 0; i < allocation_bars_.size(); ++i) {
         if (i < num_plants) {
-            double pi = alloc_array[i].toDouble();
+            double pi = allocation[i];
             double ratio = (total > 0) ? (pi / total * 100.0) : 0.0;
 
             allocation_labels_[i]->setVisible(true);
@@ -170,10 +166,8 @@ void OverviewPanel::LoadData(const QJsonObject& result) {
     }
 
     // 稳定性分析
-    QJsonObject interp = result["interpretation"].toObject();
-    QString core_status = interp["core_status"].toString();
-
-    if (core_status == "non-empty") {
+    const double v_star = overview.v_star;
+    if (overview.core_nonempty) {
         stability_title_->setText("核非空 - 分配稳定");
         stability_title_->setStyleSheet("color: #4CAF50;");
         stability_desc_->setText(
@@ -188,12 +182,11 @@ void OverviewPanel::LoadData(const QJsonObject& result) {
     }
 
     // 问题信息
-    QJsonObject problem_size = result["problem_size"].toObject();
     problem_info_->setText(QString("问题规模: P=%1 工厂, N=%2 产品, G=%3 产品大类, T=%4 周期")
-        .arg(problem_size["num_plants"].toInt())
-        .arg(problem_size["num_items"].toInt())
-        .arg(problem_size["num_families"].toInt())
-        .arg(problem_size["num_periods"].toInt()));
+        .arg(overview.num_plants)
+        .arg(overview.num_items)
+        .arg(overview.num_families)
+        .arg(overview.num_periods));
 }
 
 void OverviewPanel::Clear() {
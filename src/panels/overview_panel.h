@@ -4,8 +4,9 @@
 #ifndef OVERVIEW_PANEL_H
 #define OVERVIEW_PANEL_H
 
+#include "../analysis_data.h"
+
 #include <QWidget>
-#include <QJsonObject>
 
 class QLabel;
 class QProgressBar;
@@ -17,7 +18,7 @@ class OverviewPanel : public QWidget {
 public:
     explicit OverviewPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& result);
+    void LoadData(const AnalysisData& data);
     void Clear();
 
 private:
@@ -0,0 +1,169 @@
+// phase_timeline_chart.cpp - 迭代阶段用时图实现
+
+#include "phase_timeline_chart.h"
+
+#include <QPainter>
+#include <QMouseEvent>
+#include <QToolTip>
+
+namespace {
+
+constexpr int kLegendHeight = 20;
+constexpr int kAxisWidth = 48;
+constexpr int kMargin = 6;
+
+// 阶段颜色与名称, 顺序即堆叠顺序 (自下而上)
+struct PhaseStyle {
+    const char* name;
+    QColor color;
+};
+
+const PhaseStyle kPhases[] = {
+    {"MP", QColor("#1976D2")},
+    {"SP", QColor("#FB8C00")},
+    {"规划", QColor("#4CAF50")},
+    {"其他", QColor("#BDBDBD")},
+};
+
+double PhaseValue(const IterationTiming& row, int phase) {
+    switch (phase) {
+    case 0: return row.mp;
+    case 1: return row.sp;
+    case 2: return row.planning;
+    default: return row.other;
+    }
+}
+
+}  // namespace
+
+PhaseTimelineChart::PhaseTimelineChart(QWidget* parent)
+    : QWidget(parent)
+    , max_total_(0.0) {
+    setMouseTracking(true);
+    setMinimumHeight(140);
+}
+
+QSize PhaseTimelineChart::sizeHint() const {
+    return QSize(400, 180);
+}
+
+void PhaseTimelineChart::SetTiming(const PhaseTiming& timing) {
+    rows_ = timing.Rows();
+    max_total_ = 0.0;
+    for (const IterationTiming& row : rows_) {
+        max_total_ = qMax(max_total_, row.Total());
+    }
+    update();
+}
+
+void PhaseTimelineChart::Clear() {
+    rows_.clear();
+    max_total_ = 0.0;
+    update();
+}
+
+QRect PhaseTimelineChart::PlotRect() const {
+    return rect().adjusted(kAxisWidth, kLegendHeight + kMargin, -kMargin, -kMargin);
+}
+
+bool PhaseTimelineChart::ColumnRange(int x, int* first, int* last) const {
+    const QRect plot = PlotRect();
+    if (rows_.isEmpty() || plot.width() <= 0 || x < plot.left() || x > plot.right()) {
+        return false;
+    }
+    const qint64 n = rows_.size();
+    const qint64 offset = x - plot.left();
+    *first = static_cast<int>(offset * n / plot.width());
+    *last = static_cast<int>(qMax<qint64>(*first + 1, (offset + 1) * n / plot.width()));
+    return *first < n;
+}
+
+void PhaseTimelineChart::paintEvent(QPaintEvent* event) {
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::white);
+
+    // 图例
+    int legend_x = kAxisWidth;
+    for (const PhaseStyle& phase : kPhases) {
+        painter.fillRect(legend_x, 6, 10, 10, phase.color);
+        painter.setPen(QColor("#555"));
+        painter.drawText(legend_x + 14, 15, phase.name);
+        legend_x += 14 + painter.fontMetrics().horizontalAdvance(phase.name) + 16;
+    }
+
+    const QRect plot = PlotRect();
+    painter.setPen(QColor("#e0e0e0"));
+    painter.drawRect(plot.adjusted(0, 0, -1, -1));
+
+    if (rows_.isEmpty() || max_total_ <= 0.0 || plot.width() <= 0) {
+        painter.setPen(QColor("#999"));
+        painter.drawText(plot, Qt::AlignCenter, "无阶段计时 (仅在本程序中运行的求解有记录)");
+        return;
+    }
+
+    // 纵轴: 单轮最长用时
+    painter.setPen(QColor("#555"));
+    painter.drawText(QRect(0, plot.top() - 6, kAxisWidth - 4, 12), Qt::AlignRight | Qt::AlignVCenter,
+                     QString("%1 s").arg(max_total_, 0, 'g', 3));
+    painter.drawText(QRect(0, plot.bottom() - 6, kAxisWidth - 4, 12), Qt::AlignRight | Qt::AlignVCenter,
+                     "0");
+
+    // 每个像素列取所含迭代各阶段的最大值, 窄列也能看出慢迭代
+    const qint64 n = rows_.size();
+    const double scale = plot.height() / max_total_;
+    const int columns = static_cast<int>(qMin<qint64>(n, plot.width()));
+    for (int c = 0; c < columns; ++c) {
+        const int first = static_cast<int>(c * n / columns);
+        const int last = static_cast<int>(qMax<qint64>(first + 1, (c + 1) * n / columns));
+        const int x0 = plot.left() + c * plot.width() / columns;
+        const int x1 = plot.left() + (c + 1) * plot.width() / columns;
+        const int width = qMax(1, x1 - x0 - (columns < plot.width() / 3 ? 1 : 0));
+
+        double values[4] = {0.0, 0.0, 0.0, 0.0};
+        double total = 0.0;
+        for (int i = first; i < last; ++i) {
+            if (rows_[i].Total() > total) {
+                total = rows_[i].Total();
+                for (int p = 0; p < 4; ++p) {
+                    values[p] = PhaseValue(rows_[i], p);
+                }
+            }
+        }
+
+        double y = plot.bottom();
+        for (int p = 0; p < 4; ++p) {
+            const double height = values[p] * scale;
+            if (height <= 0.0) continue;
+            painter.fillRect(QRectF(x0, y - height, width, height), kPhases[p].color);
+            y -= height;
+        }
+    }
+}
+
+void PhaseTimelineChart::mouseMoveEvent(QMouseEvent* event) {
+    int first = 0;
+    int last = 0;
+    if (!ColumnRange(event->position().toPoint().x(), &first, &last)) {
+        QToolTip::hideText();
+        return;
+    }
+
+    IterationTiming sum;
+    for (int i = first; i < last; ++i) {
+        sum.mp += rows_[i].mp;
+        sum.sp += rows_[i].sp;
+        sum.planning += rows_[i].planning;
+        sum.other += rows_[i].other;
+    }
+    const QString title = (last - first == 1)
+        ? QString("迭代 %1").arg(rows_[first].iteration)
+        : QString("迭代 %1 - %2").arg(rows_[first].iteration).arg(rows_[last - 1].iteration);
+    QToolTip::showText(event->globalPosition().toPoint(), QString(
+        "%1\nMP: %2 s\nSP: %3 s\n规划: %4 s\n其他: %5 s")
+        .arg(title)
+        .arg(sum.mp, 0, 'f', 3)
+        .arg(sum.sp, 0, 'f', 3)
+        .arg(sum.planning, 0, 'f', 3)
+        .arg(sum.other, 0, 'f', 3), this);
+}
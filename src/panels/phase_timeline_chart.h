@@ -0,0 +1,37 @@
+// phase_timeline_chart.h - 迭代阶段用时图
+// 每轮迭代一列, 按 MP / SP / 规划 / 其他堆叠; 迭代数超过像素宽度时相邻迭代合并为一列
+
+#ifndef PHASE_TIMELINE_CHART_H
+#define PHASE_TIMELINE_CHART_H
+
+#include "../phase_timing.h"
+
+#include <QWidget>
+
+class PhaseTimelineChart : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit PhaseTimelineChart(QWidget* parent = nullptr);
+
+    void SetTiming(const PhaseTiming& timing);
+    void Clear();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+
+private:
+    // 绘图区 (去掉图例和坐标轴)
+    QRect PlotRect() const;
+
+    // 绘图区内横坐标对应的迭代下标范围 [first, last)
+    bool ColumnRange(int x, int* first, int* last) const;
+
+    QVector<IterationTiming> rows_;
+    double max_total_;
+};
+
+#endif  // PHASE_TIMELINE_CHART_H
@@ -5,16 +5,61 @@
 
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QTableWidget>
-#include <QTableWidgetItem>
+#include <QTableView>
 #include <QHeaderView>
 #include <QLabel>
 #include <QGroupBox>
-#include <QJsonArray>
-#include <QJsonObject>
+
+namespace {
+
+// 节省率超过此值 (%) 的行高亮
+constexpr double kHighlightSavingsRate = 20.0;
+
+ColumnTable BuildPlantTable(const PlantData& plants) {
+    const int num_plants = static_cast<int>(plants.rows.size());
+    QVector<int> ids(num_plants);
+    QVector<double> singleton_costs(num_plants);
+    QVector<double> allocations(num_plants);
+    QVector<double> savings(num_plants);
+    QVector<double> savings_rates(num_plants);
+    QVector<int> status(num_plants);
+    for (int u = 0; u < num_plants; ++u) {
+        const PlantRow& row = plants.rows[u];
+        ids[u] = u;
+        singleton_costs[u] = row.singleton_cost;
+        allocations[u] = row.allocation;
+        savings[u] = row.savings;
+        savings_rates[u] = row.savings_rate;
+        status[u] = row.rational ? 0 : 1;
+    }
+
+    ColumnTable table(num_plants);
+    table.AddInteger("工厂", ids, "工厂 ");
+    table.AddDouble("独立成本 c({u})", singleton_costs, 2);
+    table.AddDouble("分配 pi_u", allocations, 2);
+    table.AddDouble("节省额", savings, 2);
+    table.AddDouble("节省率", savings_rates, 1, "%");
+    // 状态列 - 个体理性检查
+    table.AddCategory("状态", status, {"满足", "违反"}, {QColor("#4CAF50"), QColor("#F44336")});
+
+    // 高亮节省率最高的行
+    table.SetRowRoles([savings_rates](int row, int role) -> QVariant {
+        if (role == Qt::BackgroundRole && savings_rates[row] > kHighlightSavingsRate) {
+            return QColor("#E8F5E9");
+        }
+        return QVariant();
+    });
+    return table;
+}
+
+}  // namespace
 
 PlantPanel::PlantPanel(QWidget* parent)
-    : QWidget(parent) {
+    : QWidget(parent)
+    , plant_model_(new ColumnTableModel(this))
+    , plant_proxy_(new ColumnSortFilterProxy(this)) {
+    plant_model_->SetTable(BuildPlantTable(PlantData()));
+    plant_proxy_->setSourceModel(plant_model_);
     SetupUI();
 }
 
@@ -27,17 +72,17 @@ void PlantPanel::SetupUI() {
     QGroupBox* table_group = new QGroupBox("工厂分配详情");
     QVBoxLayout* table_layout = new QVBoxLayout(table_group);
 
-    plant_table_ = new QTableWidget();
-    plant_table_->setColumnCount(6);
-    plant_table_->setHorizontalHeaderLabels({
-        "工厂", "独立成本 c({u})", "分配 pi_u",
-        "节省额", "节省率", "状态"
-    });
+    plant_table_ = new QTableView();
+    plant_table_->setModel(plant_proxy_);
 
     plant_table_->horizontalHeader()->setStretchLastSection(true);
     plant_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    plant_table_->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
     plant_table_->setAlternatingRowColors(true);
+    plant_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
     plant_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    plant_table_->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    plant_table_->setSortingEnabled(true);
 
     table_layout->addWidget(plant_table_);
     main_layout->addWidget(table_group);
@@ -61,62 +106,15 @@ void PlantPanel::SetupUI() {
     main_layout->addStretch();
 }
 
-void PlantPanel::LoadData(const QJsonObject& result) {
-    // 获取分配数组和单独联盟成本
-    QJsonArray alloc_array = result["allocation_array"].toArray();
-    QJsonObject singleton_costs = result["singleton_costs"].toObject();
-    double grand_cost = result["grand_coalition_cost"].toDouble();
-
-    int num_plants = alloc_array.size();
-    plant_table_->setRowCount(num_plants);
-
-    double total_alloc = 0;
-    double total_singleton = 0;
-    bool all_rational = true;
-
-    for (int u = 0; u < num_plants; ++u) {
-        double pi_u = alloc_array[u].toDouble();
-        // 单独联盟成本 c({u})
-        QString key = QString::number(u);
-        double c_singleton = singleton_costs.contains(key)
-            ? singleton_costs[key].toDouble()
-            : 0.0;
-
-        double savings = c_singleton - pi_u;
-        double savings_rate = (c_singleton > 0) ? (savings / c_singleton * 100.0) : 0.0;
-        bool is_rational = (pi_u <= c_singleton + 1e-6);
-
-        total_alloc += pi_u;
-        total_singleton += c_singleton;
-        if (!is_rational) all_rational = false;
-
-        // 填充表格
-        plant_table_->setItem(u, 0, new QTableWidgetItem(QString("工厂 %1").arg(u)));
-        plant_table_->setItem(u, 1, new QTableWidgetItem(QString::number(c_singleton, 'f', 2)));
-        plant_table_->setItem(u, 2, new QTableWidgetItem(QString::number(pi_u, 'f', 2)));
-        plant_table_->setItem(u, 3, new QTableWidgetItem(QString::number(savings, 'f', 2)));
-        plant_table_->setItem(u, 4, new QTableWidgetItem(QString("%1%").arg(savings_rate, 0, 'f', 1)));
-
-        // 状态列 - 检查个体理性
-        QTableWidgetItem* status_item = new QTableWidgetItem();
-        if (is_rational) {
-            status_item->setText("满足");
-            status_item->setForeground(QColor("#4CAF50"));
-        } else {
-            status_item->setText("违反");
-            status_item->setForeground(QColor("#F44336"));
-        }
-        plant_table_->setItem(u, 5, status_item);
-
-        // 高亮节省率最高的行
-        if (savings_rate > 20) {
-            for (int col = 0; col < 6; ++col) {
-                plant_table_->item(u, col)->setBackground(QColor("#E8F5E9"));
-            }
-        }
-    }
+void PlantPanel::LoadData(const AnalysisData& data) {
+    // 节省额, 节省率和个体理性已在加载时算好
+    const PlantData& plants = data.plants;
+    const int num_plants = static_cast<int>(plants.rows.size());
+    plant_model_->SetTable(BuildPlantTable(plants));
 
     // 汇总信息
+    const double total_singleton = plants.total_singleton;
+    const double grand_cost = plants.grand_cost;
     double total_savings = total_singleton - grand_cost;
     double overall_savings_rate = (total_singleton > 0)
         ? (total_savings / total_singleton * 100.0) : 0.0;
@@ -132,10 +130,10 @@ void PlantPanel::LoadData(const QJsonObject& result) {
         .arg(grand_cost, 0, 'f', 2)
         .arg(total_savings, 0, 'f', 2)
         .arg(overall_savings_rate, 0, 'f', 1)
-        .arg(total_alloc, 0, 'f', 2));
+        .arg(plants.total_allocation, 0, 'f', 2));
 
     // 个体理性检查结果
-    if (all_rational) {
+    if (plants.all_rational) {
         rationality_label_->setText("个体理性: 全部满足");
         rationality_label_->setStyleSheet("padding: 8px; color: #4CAF50;");
     } else {
@@ -145,7 +143,7 @@ void PlantPanel::LoadData(const QJsonObject& result) {
 }
 
 void PlantPanel::Clear() {
-    plant_table_->setRowCount(0);
+    plant_model_->SetTable(BuildPlantTable(PlantData()));
     summary_label_->setText("");
     rationality_label_->setText("");
     rationality_label_->setStyleSheet("padding: 8px;");
@@ -4,10 +4,12 @@
 #ifndef PLANT_PANEL_H
 #define PLANT_PANEL_H
 
+#include "../analysis_data.h"
+#include "../column_table_model.h"
+
 #include <QWidget>
-#include <QJsonObject>
 
-class QTableWidget;
+class QTableView;
 class QLabel;
 
 class PlantPanel : public QWidget {
@@ -16,13 +18,15 @@ class PlantPanel : public QWidget {
 public:
     explicit PlantPanel(QWidget* parent = nullptr);
 
-    void LoadData(const QJsonObject& result);
+    void LoadData(const AnalysisData& data);
     void Clear();
 
 private:
     void SetupUI();
 
-    QTableWidget* plant_table_;
+    QTableView* plant_table_;
+    ColumnTableModel* plant_model_;
+    ColumnSortFilterProxy* plant_proxy_;
     QLabel* summary_label_;
     QLabel* rationality_label_;
 };
@@ -0,0 +1,117 @@
+// phase_timing.cpp - 迭代阶段计时实现
+
+#include "phase_timing.h"
+
+#include <QFile>
+#include <QJsonObject>
+#include <QTextStream>
+
+void PhaseTiming::Apply(const QVector<SolverEvent>& events) {
+    for (const SolverEvent& event : events) {
+        if (event.time <= 0.0) continue;
+
+        const double elapsed = event.time - last_time_;
+        last_time_ = event.time;
+
+        if (event.type == SolverEventType::kIterationStarted) {
+            // 上一轮的收尾计入其他
+            if (!rows_.isEmpty()) {
+                rows_.last().other += elapsed;
+            }
+            IterationTiming row;
+            row.iteration = event.ints[0];
+            row.start = event.time;
+            rows_.append(row);
+            continue;
+        }
+
+        // 第一轮迭代之前 (数据加载, 大联盟) 不计
+        if (rows_.isEmpty()) continue;
+
+        IterationTiming& row = rows_.last();
+        switch (event.type) {
+        case SolverEventType::kMPSolved:
+            row.mp += elapsed;
+            break;
+        case SolverEventType::kSPResult:
+            row.sp += elapsed;
+            break;
+        case SolverEventType::kCutAdded:
+            row.planning += elapsed;
+            break;
+        default:
+            row.other += elapsed;
+            break;
+        }
+    }
+}
+
+void PhaseTiming::Clear() {
+    rows_.clear();
+    last_time_ = 0.0;
+}
+
+IterationTiming PhaseTiming::Totals() const {
+    IterationTiming totals;
+    totals.iteration = static_cast<int>(rows_.size());
+    for (const IterationTiming& row : rows_) {
+        totals.mp += row.mp;
+        totals.sp += row.sp;
+        totals.planning += row.planning;
+        totals.other += row.other;
+    }
+    return totals;
+}
+
+bool PhaseTiming::WriteCsv(const QString& path) const {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << "iteration,start_s,mp_s,sp_s,planning_s,other_s,total_s\n";
+    for (const IterationTiming& row : rows_) {
+        out << row.iteration << ","
+            << QString::number(row.start, 'f', 6) << ","
+            << QString::number(row.mp, 'f', 6) << ","
+            << QString::number(row.sp, 'f', 6) << ","
+            << QString::number(row.planning, 'f', 6) << ","
+            << QString::number(row.other, 'f', 6) << ","
+            << QString::number(row.Total(), 'f', 6) << "\n";
+    }
+    return true;
+}
+
+QJsonArray PhaseTiming::ToJson() const {
+    QJsonArray rows;
+    for (const IterationTiming& row : rows_) {
+        QJsonObject obj;
+        obj["iteration"] = row.iteration;
+        obj["start"] = row.start;
+        obj["mp"] = row.mp;
+        obj["sp"] = row.sp;
+        obj["planning"] = row.planning;
+        obj["other"] = row.other;
+        rows.append(obj);
+    }
+    return rows;
+}
+
+PhaseTiming PhaseTiming::FromJson(const QJsonArray& rows) {
+    PhaseTiming timing;
+    for (const QJsonValue& value : rows) {
+        const QJsonObject obj = value.toObject();
+        IterationTiming row;
+        row.iteration = obj["iteration"].toInt();
+        row.start = obj["start"].toDouble();
+        row.mp = obj["mp"].toDouble();
+        row.sp = obj["sp"].toDouble();
+        row.planning = obj["planning"].toDouble();
+        row.other = obj["other"].toDouble();
+        timing.rows_.append(row);
+    }
+    if (!timing.rows_.isEmpty()) {
+        timing.last_time_ = timing.rows_.last().start + timing.rows_.last().Total();
+    }
+    return timing;
+}
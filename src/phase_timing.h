@@ -0,0 +1,50 @@
+// phase_timing.h - 迭代阶段计时
+// 由状态码到达时刻推出每轮迭代的 MP / SP / 规划子问题用时, 每次运行一张表
+
+#ifndef PHASE_TIMING_H
+#define PHASE_TIMING_H
+
+#include "solver_event.h"
+
+#include <QJsonArray>
+#include <QString>
+#include <QVector>
+
+// 一轮迭代的阶段用时 (秒)
+// 两个相邻状态码之间的间隔记到后一个状态码的阶段:
+// 到 MP 为主问题, 到 SP 为分离子问题, 到 CUT 为计算 c(S) 的规划子问题, 其余为其他
+struct IterationTiming {
+    int iteration = 0;
+    double start = 0.0;      // 迭代开始时刻 (自进程启动)
+    double mp = 0.0;
+    double sp = 0.0;
+    double planning = 0.0;
+    double other = 0.0;
+
+    double Total() const { return mp + sp + planning + other; }
+};
+
+class PhaseTiming {
+public:
+    // 按事件批次累计 (只看带到达时刻的状态码事件)
+    void Apply(const QVector<SolverEvent>& events);
+
+    void Clear();
+
+    const QVector<IterationTiming>& Rows() const { return rows_; }
+    bool IsEmpty() const { return rows_.isEmpty(); }
+
+    // 各阶段合计 (iteration 为迭代数)
+    IterationTiming Totals() const;
+
+    // 导出: CSV 每轮一行; JSON 附在结果对象的 "phase_timing" 中
+    bool WriteCsv(const QString& path) const;
+    QJsonArray ToJson() const;
+    static PhaseTiming FromJson(const QJsonArray& rows);
+
+private:
+    QVector<IterationTiming> rows_;
+    double last_time_ = 0.0;
+};
+
+#endif  // PHASE_TIMING_H
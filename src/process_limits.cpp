@@ -0,0 +1,325 @@
+// process_limits.cpp - 求解进程资源限制实现
+
+#include "process_limits.h"
+
+#include <QAtomicInt>
+#include <QCoreApplication>
+#include <QDeadlineTimer>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QProcess>
+#include <QStringList>
+#include <QThread>
+#include <QTimer>
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef Q_OS_LINUX
+
+// cgroup cpu.max 的周期 (微秒)
+constexpr int kCpuPeriodUs = 100000;
+
+// cgroup.kill 之后由定时器等待进程退出再删除; 程序退出时在当前线程等待, 最多 kShutdownWaitMs
+constexpr int kRemoveRetryMs = 200;
+constexpr int kRemoveRetryCount = 25;
+constexpr int kKillPollMs = 5;
+constexpr int kShutdownWaitMs = 500;
+
+// 可指定 cgroup 父目录的环境变量 (需已委托给当前用户, 且在 subtree_control 中开启 memory/cpu)
+constexpr char kCgroupRootEnv[] = "GMNTG_CGROUP_ROOT";
+
+QByteArray ReadFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+bool WriteFile(const QString& path, const QByteArray& value) {
+    QFile file(path);
+    return file.open(QIODevice::WriteOnly) && file.write(value) == value.size();
+}
+
+// "key value" 形式的统计行 (memory.events, cpu.stat), 没有时返回 0
+qint64 StatValue(const QByteArray& text, const QByteArray& key) {
+    for (const QByteArray& line : text.split('\n')) {
+        const QList<QByteArray> fields = line.split(' ');
+        if (fields.size() == 2 && fields[0] == key) {
+            return fields[1].toLongLong();
+        }
+    }
+    return 0;
+}
+
+// cgroup 父目录: 环境变量指定, 否则为本进程所在 cgroup 的上一级
+// (本进程所在的 cgroup 本身有进程, 不能再给子 cgroup 开启控制器)
+QString CgroupRoot() {
+    const QString configured = qEnvironmentVariable(kCgroupRootEnv);
+    if (!configured.isEmpty()) {
+        return configured;
+    }
+    const QByteArray self = ReadFile("/proc/self/cgroup");
+    for (const QByteArray& line : self.split('\n')) {
+        if (line.startsWith("0::")) {
+            const QString path = "/sys/fs/cgroup" + QString::fromLocal8Bit(line.mid(3)).trimmed();
+            return QFileInfo(path).path();
+        }
+    }
+    return QString();
+}
+
+// cgroup 中已没有进程 (cgroup.events 的 populated 为 0)
+bool CgroupEmpty(const QString& dir) {
+    const QByteArray events = ReadFile(dir + "/cgroup.events");
+    return events.isEmpty() || StatValue(events, "populated") == 0;
+}
+
+// 已写入 cgroup.kill, 等待进程退出后删除: 等到 populated 0 或超时, 再最后删除一次
+bool RemoveCgroupNow(const QString& dir) {
+    const QDeadlineTimer deadline(kShutdownWaitMs);
+    while (!CgroupEmpty(dir) && !deadline.hasExpired()) {
+        QThread::msleep(kKillPollMs);
+    }
+    return QDir().rmdir(dir);
+}
+
+// 等待定时器删除的 cgroup; 程序退出时定时器不再触发, 由退出例程同步删除
+QMutex pending_mutex;
+QStringList pending_cgroups;
+
+void RemovePendingCgroups() {
+    const QMutexLocker locker(&pending_mutex);
+    for (const QString& dir : std::as_const(pending_cgroups)) {
+        RemoveCgroupNow(dir);
+    }
+    pending_cgroups.clear();
+}
+
+// 进程退出需要一点时间, 期间 rmdir 返回 EBUSY; 在当前线程的事件循环中稍后重试, 不阻塞调用方
+void RemoveCgroupLater(const QString& dir, int attempts_left) {
+    {
+        const QMutexLocker locker(&pending_mutex);
+        static const bool registered = (qAddPostRoutine(RemovePendingCgroups), true);
+        Q_UNUSED(registered);
+        if (!pending_cgroups.contains(dir)) {
+            pending_cgroups.append(dir);
+        }
+    }
+    QTimer::singleShot(kRemoveRetryMs, [dir, attempts_left]() {
+        const bool removed = CgroupEmpty(dir) && QDir().rmdir(dir);
+        if (!removed && attempts_left > 1) {
+            RemoveCgroupLater(dir, attempts_left - 1);
+            return;
+        }
+        const QMutexLocker locker(&pending_mutex);
+        pending_cgroups.removeAll(dir);
+    });
+}
+
+QString CpuListText(const QVector<int>& cpus) {
+    QStringList parts;
+    for (int cpu : cpus) {
+        parts << QString::number(cpu);
+    }
+    return parts.join(',');
+}
+
+#endif
+
+}  // namespace
+
+ProcessLimits ProcessLimits::FromParams(const QVariantMap& params) {
+    ProcessLimits limits;
+    limits.memory_mb = qMax(0, params.value("limit_memory_mb", 0).toInt());
+    limits.cpu_cores = qMax(0, params.value("limit_cpu_cores", 0).toInt());
+    for (const QVariant& cpu : params.value("cpu_affinity").toList()) {
+        limits.cpus.append(cpu.toInt());
+    }
+    limits.nice = qBound(0, params.value("nice", 0).toInt(), 19);
+    return limits;
+}
+
+ProcessLimiter::~ProcessLimiter() {
+    // 析构发生在 I/O 线程停止或程序退出时, 事件循环可能已不再运行, 不能交给定时器删除
+    RemoveCgroup(true);
+}
+
+bool ProcessLimiter::IsSupported() {
+#ifdef Q_OS_LINUX
+    return true;
+#else
+    return false;
+#endif
+}
+
+QString ProcessLimiter::Apply(const ProcessLimits& limits, QProcess* process, QString* warning) {
+    limits_ = limits;
+    memory_by_cgroup_ = false;
+    out_of_memory_seen_ = false;
+    oom_kills_ = 0;
+
+#ifdef Q_OS_LINUX
+    QStringList applied;
+    QStringList problems;
+
+    // cgroup: 内存按实际占用 (含页缓存) 计, 不允许换出; CPU 按配额限流
+    if (limits_.memory_mb > 0 || limits_.cpu_cores > 0) {
+        static QAtomicInt sequence;
+        const QString root = CgroupRoot();
+        const QList<QByteArray> controllers = ReadFile(root + "/cgroup.subtree_control").trimmed().split(' ');
+        const bool has_memory = controllers.contains("memory");
+        const bool has_cpu = controllers.contains("cpu");
+        const QString dir = QString("%1/gm-ntg-%2-%3").arg(root)
+            .arg(QCoreApplication::applicationPid()).arg(sequence.fetchAndAddRelaxed(1) + 1);
+
+        if (root.isEmpty() || !(has_memory || has_cpu)) {
+            problems << QString("cgroup %1 未开启 memory/cpu 控制器").arg(root.isEmpty() ? "-" : root);
+        } else if (!QDir().mkdir(dir)) {
+            problems << QString("无法创建 cgroup %1 (可用 %2 指定已委托的目录)").arg(dir, QLatin1String(kCgroupRootEnv));
+        } else {
+            cgroup_dir_ = dir;
+            if (limits_.memory_mb > 0 && has_memory) {
+                const qint64 bytes = static_cast<qint64>(limits_.memory_mb) * 1024 * 1024;
+                memory_by_cgroup_ = WriteFile(dir + "/memory.max", QByteArray::number(bytes));
+                if (memory_by_cgroup_) {
+                    // 没有开启 swap 记账时该文件不存在, 不影响内存上限
+                    WriteFile(dir + "/memory.swap.max", "0");
+                    applied << QString("内存 %1 MB (cgroup)").arg(limits_.memory_mb);
+                }
+            }
+            if (limits_.cpu_cores > 0) {
+                const QByteArray quota = QByteArray::number(static_cast<qint64>(limits_.cpu_cores) * kCpuPeriodUs)
+                    + ' ' + QByteArray::number(kCpuPeriodUs);
+                if (has_cpu && WriteFile(dir + "/cpu.max", quota)) {
+                    applied << QString("CPU %1 核 (cgroup)").arg(limits_.cpu_cores);
+                } else {
+                    problems << "无法设置 CPU 配额";
+                }
+            }
+        }
+    }
+
+    // 没有 cgroup 时内存退回 RLIMIT_DATA (堆和私有匿名映射, 不含共享库和文件映射)
+    rlim_t data_limit = 0;
+    if (limits_.memory_mb > 0 && !memory_by_cgroup_) {
+        data_limit = static_cast<rlim_t>(limits_.memory_mb) * 1024 * 1024;
+        applied << QString("内存 %1 MB (setrlimit)").arg(limits_.memory_mb);
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    bool pin = false;
+    for (int cpu : std::as_const(limits_.cpus)) {
+        if (cpu >= 0 && cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpu_set);
+            pin = true;
+        }
+    }
+    if (pin) {
+        applied << QString("绑定 CPU %1").arg(CpuListText(limits_.cpus));
+    }
+
+    const int nice = limits_.nice;
+    if (nice > 0) {
+        applied << QString("nice %1").arg(nice);
+    }
+
+    // 以下在 fork 之后, exec 之前的子进程中执行, 只能使用异步信号安全的调用;
+    // 内存限制做不到时启动失败, 绑定 CPU 和 nice 失败时忽略
+    const QByteArray procs_path = cgroup_dir_.isEmpty() ? QByteArray()
+                                : QFile::encodeName(cgroup_dir_ + "/cgroup.procs");
+    process->setChildProcessModifier([procs_path, data_limit, pin, cpu_set, nice]() {
+        if (!procs_path.isEmpty()) {
+            // 写入 0 表示把写入者自己移入该 cgroup
+            const int fd = ::open(procs_path.constData(), O_WRONLY | O_CLOEXEC);
+            if (fd < 0 || ::write(fd, "0", 1) != 1) {
+                QProcess::failChildProcessModifier("无法加入 cgroup", errno);
+            }
+            ::close(fd);
+        }
+        if (data_limit > 0) {
+            const struct rlimit limit = {data_limit, data_limit};
+            if (::setrlimit(RLIMIT_DATA, &limit) != 0) {
+                QProcess::failChildProcessModifier("setrlimit(RLIMIT_DATA) 失败", errno);
+            }
+        }
+        if (pin) {
+            ::sched_setaffinity(0, sizeof(cpu_set), &cpu_set);
+        }
+        if (nice > 0) {
+            ::setpriority(PRIO_PROCESS, 0, nice);
+        }
+    });
+
+    if (warning) {
+        *warning = problems.join("; ");
+    }
+    return applied.join(", ");
+#else
+    Q_UNUSED(process);
+    if (warning && !limits_.IsEmpty()) {
+        *warning = "当前平台不支持强制资源限制, 仅向求解器传递 --threads / --memory";
+    }
+    return QString();
+#endif
+}
+
+QString ProcessLimiter::Release() {
+    QString summary;
+#ifdef Q_OS_LINUX
+    if (cgroup_dir_.isEmpty()) {
+        return summary;
+    }
+
+    oom_kills_ = StatValue(ReadFile(cgroup_dir_ + "/memory.events"), "oom_kill");
+    const QByteArray cpu_stat = ReadFile(cgroup_dir_ + "/cpu.stat");
+    const qint64 throttled = StatValue(cpu_stat, "nr_throttled");
+    if (throttled > 0) {
+        summary = QString("CPU 配额限流 %1 次, 共 %2 s")
+            .arg(throttled)
+            .arg(StatValue(cpu_stat, "throttled_usec") / 1e6, 0, 'f', 1);
+    }
+
+    RemoveCgroup(QCoreApplication::closingDown());
+#endif
+    return summary;
+}
+
+void ProcessLimiter::RemoveCgroup(bool synchronous) {
+#ifdef Q_OS_LINUX
+    if (cgroup_dir_.isEmpty()) {
+        return;
+    }
+    // 求解器留下的子进程一并结束, 否则 cgroup 不能删除
+    // 结束是异步的: 等 cgroup.events 显示 populated 0 后再删除
+    if (!QDir().rmdir(cgroup_dir_)) {
+        WriteFile(cgroup_dir_ + "/cgroup.kill", "1");
+        if (synchronous) {
+            RemoveCgroupNow(cgroup_dir_);
+        } else {
+            RemoveCgroupLater(cgroup_dir_, kRemoveRetryCount);
+        }
+    }
+    cgroup_dir_.clear();
+#else
+    Q_UNUSED(synchronous);
+#endif
+}
+
+bool ProcessLimiter::MemoryExceeded() const {
+    if (limits_.memory_mb <= 0) {
+        return false;
+    }
+    return memory_by_cgroup_ ? oom_kills_ > 0 : out_of_memory_seen_;
+}
@@ -0,0 +1,62 @@
+// process_limits.h - 求解进程资源限制
+// Linux 上强制执行任务分得的内存/CPU: 优先放入独立的 cgroup v2, 不可用时内存退回 setrlimit; 另可绑定 CPU 和调整 nice
+
+#ifndef PROCESS_LIMITS_H
+#define PROCESS_LIMITS_H
+
+#include <QString>
+#include <QVariantMap>
+#include <QVector>
+
+class QProcess;
+
+// 一次运行的限制, 由任务参数 limit_memory_mb / limit_cpu_cores / cpu_affinity / nice 给出
+struct ProcessLimits {
+    int memory_mb = 0;       // 内存上限, 0 表示不限
+    int cpu_cores = 0;       // CPU 配额 (核数), 0 表示不限; 只有 cgroup 能限制
+    QVector<int> cpus;       // 绑定的逻辑 CPU, 空表示不绑定
+    int nice = 0;            // 大于 0 时降低调度优先级
+
+    static ProcessLimits FromParams(const QVariantMap& params);
+    bool IsEmpty() const { return memory_mb <= 0 && cpu_cores <= 0 && cpus.isEmpty() && nice <= 0; }
+};
+
+class ProcessLimiter {
+public:
+    ProcessLimiter() = default;
+    ~ProcessLimiter();
+
+    ProcessLimiter(const ProcessLimiter&) = delete;
+    ProcessLimiter& operator=(const ProcessLimiter&) = delete;
+
+    // 当前平台能否强制执行限制 (仅 Linux)
+    static bool IsSupported();
+
+    // 在 process->start() 之前调用: 准备 cgroup 并设置子进程在 exec 前执行的限制;
+    // 返回实际生效的限制说明, 做不到的部分写入 *warning
+    QString Apply(const ProcessLimits& limits, QProcess* process, QString* warning);
+
+    // 求解器输出中出现内存不足的报告 (setrlimit 下的超限表现)
+    void NoteOutOfMemory() { out_of_memory_seen_ = true; }
+    bool HasMemoryLimit() const { return limits_.memory_mb > 0; }
+    int MemoryLimitMb() const { return limits_.memory_mb; }
+
+    // 进程结束后调用: 读取 cgroup 的 OOM 和限流统计并删除 cgroup; 返回限流说明 (没有时为空)
+    QString Release();
+
+    // 进程是否因超出内存上限而结束 (在 Release 之后判断)
+    bool MemoryExceeded() const;
+
+private:
+    // 结束 cgroup 中残留的进程并删除 cgroup; synchronous 为 false 时由当前线程的定时器等待进程退出,
+    // 为 true 时 (事件循环正在停止) 在这里短暂等待后最后删除一次
+    void RemoveCgroup(bool synchronous);
+
+    ProcessLimits limits_;
+    QString cgroup_dir_;
+    bool memory_by_cgroup_ = false;
+    bool out_of_memory_seen_ = false;
+    qint64 oom_kills_ = 0;
+};
+
+#endif  // PROCESS_LIMITS_H
@@ -0,0 +1,258 @@
+// resource_sampler.cpp - 求解进程资源采样实现
+
+#include "resource_sampler.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#ifdef Q_OS_UNIX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+#ifdef Q_OS_LINUX
+
+// /proc/<pid>/stat 中用到的字段
+struct StatFields {
+    qint64 ppid = 0;
+    qint64 user_ticks = 0;
+    qint64 system_ticks = 0;
+    int threads = 0;
+};
+
+QByteArray ReadProcFile(const QString& path) {
+    // /proc 文件大小报告为 0, readAll 读到 EOF 为止
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QByteArray();
+    }
+    return file.readAll();
+}
+
+bool ParseStat(const QByteArray& text, StatFields* out) {
+    // 进程名可能含空格和括号, 从最后一个 ')' 之后开始按空格切分 (字段 3 起)
+    const qsizetype close = text.lastIndexOf(')');
+    if (close < 0) return false;
+    const QList<QByteArray> fields = text.mid(close + 2).split(' ');
+    if (fields.size() < 18) return false;
+
+    out->ppid = fields[1].toLongLong();
+    out->user_ticks = fields[11].toLongLong();
+    out->system_ticks = fields[12].toLongLong();
+    out->threads = fields[17].toInt();
+    return true;
+}
+
+// "Key:   value ..." 形式的行, 没有时返回 -1
+qint64 FindValue(const QByteArray& text, const QByteArray& key) {
+    const qsizetype pos = text.indexOf("\n" + key + ":");
+    const qsizetype start = text.startsWith(key + ":") ? key.size() + 1
+                          : (pos < 0 ? -1 : pos + key.size() + 2);
+    if (start < 0) return -1;
+    const qsizetype end = text.indexOf('\n', start);
+    QByteArray value = text.mid(start, end < 0 ? -1 : end - start).trimmed();
+    const qsizetype space = value.indexOf(' ');
+    if (space > 0) value.truncate(space);
+    bool ok = false;
+    const qint64 result = value.toLongLong(&ok);
+    return ok ? result : -1;
+}
+
+#endif
+
+}  // namespace
+
+QString FormatBytes(double bytes) {
+    static const char* const kUnits[] = {"B", "KB", "MB", "GB", "TB"};
+    int unit = 0;
+    while (bytes >= 1024.0 && unit < 4) {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    return QString("%1 %2").arg(bytes, 0, 'f', unit == 0 ? 0 : 1).arg(kUnits[unit]);
+}
+
+QJsonObject ResourceUsage::ToJson() const {
+    QJsonObject obj;
+    obj["user_s"] = user_s;
+    obj["system_s"] = system_s;
+    obj["peak_rss_kb"] = peak_rss_kb;
+    obj["read_bytes"] = read_bytes;
+    obj["write_bytes"] = write_bytes;
+    obj["samples"] = samples;
+    if (has_rusage) {
+        QJsonObject rusage;
+        rusage["exclusive"] = rusage_exclusive;
+        rusage["user_s"] = rusage_user_s;
+        rusage["system_s"] = rusage_system_s;
+        rusage["max_rss_kb"] = rusage_max_rss_kb;
+        rusage["in_blocks"] = rusage_in_blocks;
+        rusage["out_blocks"] = rusage_out_blocks;
+        obj["rusage"] = rusage;
+    }
+    return obj;
+}
+
+bool ChildRusage::Read(ChildRusage* out) {
+#ifdef Q_OS_UNIX
+    struct rusage usage;
+    if (getrusage(RUSAGE_CHILDREN, &usage) != 0) {
+        return false;
+    }
+    out->user_s = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6;
+    out->system_s = usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    out->max_rss_kb = usage.ru_maxrss;
+    out->in_blocks = usage.ru_inblock;
+    out->out_blocks = usage.ru_oublock;
+    return true;
+#else
+    Q_UNUSED(out);
+    return false;
+#endif
+}
+
+bool ResourceSampler::IsSupported() {
+#ifdef Q_OS_LINUX
+    return QFile::exists("/proc/self/stat");
+#else
+    return false;
+#endif
+}
+
+void ResourceSampler::Start(qint64 pid) {
+    root_pid_ = pid;
+    counters_.clear();
+    usage_ = ResourceUsage();
+    last_time_ = 0.0;
+    last_cpu_ticks_ = 0;
+    last_read_bytes_ = 0;
+    last_write_bytes_ = 0;
+}
+
+bool ResourceSampler::Sample(double time, ResourceSample* out) {
+#ifdef Q_OS_LINUX
+    if (root_pid_ <= 0) return false;
+
+    // 扫描全部进程, 建立父子关系
+    QHash<qint64, StatFields> stats;
+    QHash<qint64, QVector<qint64>> children;
+    const QStringList entries = QDir("/proc").entryList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QString& entry : entries) {
+        bool ok = false;
+        const qint64 pid = entry.toLongLong(&ok);
+        if (!ok) continue;
+        StatFields fields;
+        if (!ParseStat(ReadProcFile(QString("/proc/%1/stat").arg(pid)), &fields)) continue;
+        stats.insert(pid, fields);
+        children[fields.ppid].append(pid);
+    }
+    if (!stats.contains(root_pid_)) {
+        return false;
+    }
+
+    ResourceSample sample;
+    sample.time = time;
+
+    QVector<qint64> tree{root_pid_};
+    for (int i = 0; i < tree.size(); ++i) {
+        const qint64 pid = tree[i];
+        tree += children.value(pid);
+
+        const StatFields& fields = stats[pid];
+        ProcessCounters& counters = counters_[pid];
+        counters.user_ticks = fields.user_ticks;
+        counters.system_ticks = fields.system_ticks;
+        sample.threads += fields.threads;
+        ++sample.processes;
+
+        const QByteArray status = ReadProcFile(QString("/proc/%1/status").arg(pid));
+        const qint64 rss_kb = FindValue(status, "VmRSS");
+        if (rss_kb > 0) sample.rss_kb += rss_kb;
+        if (pid == root_pid_) {
+            usage_.peak_rss_kb = qMax(usage_.peak_rss_kb, FindValue(status, "VmHWM"));
+        }
+
+        // 内核未开启 I/O 统计或无权读取时保留上次的值
+        const QByteArray io = ReadProcFile(QString("/proc/%1/io").arg(pid));
+        const qint64 read_bytes = FindValue(io, "read_bytes");
+        const qint64 write_bytes = FindValue(io, "write_bytes");
+        if (read_bytes >= 0) counters.read_bytes = read_bytes;
+        if (write_bytes >= 0) counters.write_bytes = write_bytes;
+    }
+
+    // 合计包含已退出的子进程 (取其最后一次读到的值)
+    qint64 user_ticks = 0;
+    qint64 system_ticks = 0;
+    qint64 read_total = 0;
+    qint64 write_total = 0;
+    for (const ProcessCounters& counters : std::as_const(counters_)) {
+        user_ticks += counters.user_ticks;
+        system_ticks += counters.system_ticks;
+        read_total += counters.read_bytes;
+        write_total += counters.write_bytes;
+    }
+
+    static const double ticks_per_second = static_cast<double>(sysconf(_SC_CLK_TCK));
+    const qint64 cpu_ticks = user_ticks + system_ticks;
+    const double elapsed = time - last_time_;
+    if (elapsed > 0.0) {
+        sample.cpu_percent = 100.0 * (cpu_ticks - last_cpu_ticks_) / ticks_per_second / elapsed;
+        sample.read_bps = (read_total - last_read_bytes_) / elapsed;
+        sample.write_bps = (write_total - last_write_bytes_) / elapsed;
+    }
+    last_time_ = time;
+    last_cpu_ticks_ = cpu_ticks;
+    last_read_bytes_ = read_total;
+    last_write_bytes_ = write_total;
+
+    usage_.user_s = user_ticks / ticks_per_second;
+    usage_.system_s = system_ticks / ticks_per_second;
+    usage_.peak_rss_kb = qMax(usage_.peak_rss_kb, sample.rss_kb);
+    usage_.read_bytes = read_total;
+    usage_.write_bytes = write_total;
+    ++usage_.samples;
+
+    *out = sample;
+    return true;
+#else
+    Q_UNUSED(time);
+    Q_UNUSED(out);
+    return false;
+#endif
+}
+
+bool ResourceSampler::WriteCsv(const QString& path, const QVector<ResourceSample>& samples,
+                               const ResourceUsage& usage) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        return false;
+    }
+    QTextStream out(&file);
+    out << "# user_s: " << QString::number(usage.user_s, 'f', 2) << "\n"
+        << "# system_s: " << QString::number(usage.system_s, 'f', 2) << "\n"
+        << "# peak_rss_kb: " << usage.peak_rss_kb << "\n"
+        << "# read_bytes: " << usage.read_bytes << "\n"
+        << "# write_bytes: " << usage.write_bytes << "\n";
+    if (usage.has_rusage) {
+        out << "# rusage_exclusive: " << (usage.rusage_exclusive ? "true" : "false") << "\n"
+            << "# rusage_user_s: " << QString::number(usage.rusage_user_s, 'f', 2) << "\n"
+            << "# rusage_system_s: " << QString::number(usage.rusage_system_s, 'f', 2) << "\n"
+            << "# rusage_max_rss_kb: " << usage.rusage_max_rss_kb << "\n"
+            << "# rusage_in_blocks: " << usage.rusage_in_blocks << "\n"
+            << "# rusage_out_blocks: " << usage.rusage_out_blocks << "\n";
+    }
+    out << "time_s,cpu_percent,rss_kb,read_bps,write_bps,processes,threads\n";
+    for (const ResourceSample& sample : samples) {
+        out << QString::number(sample.time, 'f', 3) << ","
+            << QString::number(sample.cpu_percent, 'f', 1) << ","
+            << sample.rss_kb << ","
+            << QString::number(sample.read_bps, 'f', 0) << ","
+            << QString::number(sample.write_bps, 'f', 0) << ","
+            << sample.processes << ","
+            << sample.threads << "\n";
+    }
+    return out.status() == QTextStream::Ok;
+}
@@ -0,0 +1,103 @@
+// resource_sampler.h - 求解进程资源采样
+// 按固定周期读取 /proc/<pid>/stat, status, io, 汇总求解器进程及其全部子进程 (仅 Linux)
+
+#ifndef RESOURCE_SAMPLER_H
+#define RESOURCE_SAMPLER_H
+
+#include <QHash>
+#include <QJsonObject>
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+// 一次采样 (进程树合计)
+struct ResourceSample {
+    double time = 0.0;           // 采样时刻 (自运行开始, 秒)
+    double cpu_percent = 0.0;    // 上次采样以来的 CPU 占用, 100 表示一个核心
+    qint64 rss_kb = 0;           // 常驻内存
+    double read_bps = 0.0;       // 上次采样以来的磁盘读/写速率 (字节/秒)
+    double write_bps = 0.0;
+    int processes = 0;
+    int threads = 0;
+};
+
+// 一次运行的资源合计
+struct ResourceUsage {
+    // 由采样累计 (最后一次采样时的值, 之后到进程退出的部分不计)
+    double user_s = 0.0;
+    double system_s = 0.0;
+    qint64 peak_rss_kb = 0;
+    qint64 read_bytes = 0;
+    qint64 write_bytes = 0;
+    int samples = 0;
+
+    // 进程回收后的 getrusage(RUSAGE_CHILDREN) 差值;
+    // 运行期间有其他求解结束时混入了它们的用量, rusage_exclusive 为 false
+    bool has_rusage = false;
+    bool rusage_exclusive = false;
+    double rusage_user_s = 0.0;
+    double rusage_system_s = 0.0;
+    qint64 rusage_max_rss_kb = 0;    // 已回收子进程中的最大值, 不是差值
+    qint64 rusage_in_blocks = 0;
+    qint64 rusage_out_blocks = 0;
+
+    QJsonObject ToJson() const;
+};
+
+// 字节数的简短显示 (B / KB / MB / GB)
+QString FormatBytes(double bytes);
+
+Q_DECLARE_METATYPE(ResourceSample)
+Q_DECLARE_METATYPE(ResourceUsage)
+
+// 本进程已回收子进程的 getrusage 快照
+struct ChildRusage {
+    double user_s = 0.0;
+    double system_s = 0.0;
+    qint64 max_rss_kb = 0;
+    qint64 in_blocks = 0;
+    qint64 out_blocks = 0;
+
+    static bool Read(ChildRusage* out);
+};
+
+class ResourceSampler {
+public:
+    // 当前平台能否采样 (需要 /proc)
+    static bool IsSupported();
+
+    // 开始跟踪以 pid 为根的进程树 (清空之前的累计)
+    void Start(qint64 pid);
+    qint64 Pid() const { return root_pid_; }
+
+    // 采样一次, 根进程已不存在时返回 false
+    bool Sample(double time, ResourceSample* out);
+
+    // 到目前为止的合计 (不含 getrusage 部分)
+    const ResourceUsage& Usage() const { return usage_; }
+
+    // 时间序列导出: CSV 每次采样一行, 表头前以 # 注释行写出合计
+    static bool WriteCsv(const QString& path, const QVector<ResourceSample>& samples,
+                         const ResourceUsage& usage);
+
+private:
+    // 每个进程最近一次读到的累计值; 子进程退出后保留, 合计不回退
+    struct ProcessCounters {
+        qint64 user_ticks = 0;
+        qint64 system_ticks = 0;
+        qint64 read_bytes = 0;
+        qint64 write_bytes = 0;
+    };
+
+    qint64 root_pid_ = 0;
+    QHash<qint64, ProcessCounters> counters_;
+    ResourceUsage usage_;
+
+    // 上次采样的累计值, 用于计算速率
+    double last_time_ = 0.0;
+    qint64 last_cpu_ticks_ = 0;
+    qint64 last_read_bytes_ = 0;
+    qint64 last_write_bytes_ = 0;
+};
+
+#endif  // RESOURCE_SAMPLER_H
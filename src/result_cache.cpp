@@ -0,0 +1,218 @@
+// result_cache.cpp - 求解结果缓存实现
+
+#include "result_cache.h"
+#include "file_hash.h"
+#include "job_queue.h"
+#include "result_file.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+
+namespace {
+
+// 缓存格式版本, 变更键的组成方式时递增
+constexpr char kCacheVersion[] = "result-cache-v1";
+
+constexpr char kMetaFile[] = "meta.json";
+// 结果存为二进制格式; 旧记录和无法转换的结果为 JSON
+constexpr char kResultFile[] = "result.gmr";
+constexpr char kJsonResultFile[] = "result.json";
+
+// 参数值的规范文本: 浮点数取最短往返表示, 使 1e-4 与 0.0001 得到相同的键
+QString CanonicalValue(const QVariant& value) {
+    if (value.typeId() == QMetaType::Double || value.typeId() == QMetaType::Float) {
+        return QString::number(value.toDouble(), 'g', 17);
+    }
+    return value.toString();
+}
+
+qint64 DirBytes(const QString& path) {
+    qint64 bytes = 0;
+    const QFileInfoList files = QDir(path).entryInfoList(QDir::Files);
+    for (const QFileInfo& info : files) {
+        bytes += info.size();
+    }
+    return bytes;
+}
+
+}  // namespace
+
+ResultCache::ResultCache(const QString& root)
+    : root_(root)
+    , max_bytes_(0)
+    , max_age_days_(0) {
+}
+
+void ResultCache::SetLimits(qint64 max_bytes, int max_age_days) {
+    max_bytes_ = max_bytes;
+    max_age_days_ = max_age_days;
+}
+
+QString ResultCache::Key(const QString& data_file, const QVariantMap& params,
+                         const QString& solver_path) {
+    const QByteArray data_hash = FileHash::Sha256(data_file);
+    const QByteArray solver_hash = FileHash::Sha256(solver_path);
+    if (data_hash.isEmpty() || solver_hash.isEmpty()) {
+        return QString();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    hash.addData(QByteArrayView(kCacheVersion));
+    hash.addData(data_hash);
+    hash.addData(solver_hash);
+
+    // QVariantMap 按键有序, 逐行拼接即为规范形式; 按运行分配的参数不影响结果
+    for (auto it = params.cbegin(); it != params.cend(); ++it) {
+        if (JobQueue::IsRunParam(it.key())) continue;
+        hash.addData(QString("%1=%2\n").arg(it.key(), CanonicalValue(it.value())).toUtf8());
+    }
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+QString ResultCache::EntryDir(const QString& key) const {
+    return QDir(root_).filePath(key);
+}
+
+bool ResultCache::ReadMeta(const QString& key, Entry* entry) const {
+    QFile file(QDir(EntryDir(key)).filePath(kMetaFile));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    const QJsonObject meta = QJsonDocument::fromJson(file.readAll()).object();
+    if (meta.isEmpty()) {
+        return false;
+    }
+
+    const QDir dir(EntryDir(key));
+    entry->key = key;
+    entry->result_file = dir.filePath(meta["result_file"].toString(kJsonResultFile));
+    const QString log_name = meta["log_file"].toString();
+    entry->log_file = log_name.isEmpty() ? QString() : dir.filePath(log_name);
+    entry->data_file = meta["data_file"].toString();
+    entry->final_v = meta["final_v"].toDouble();
+    entry->iterations = meta["iterations"].toInt();
+    entry->runtime = meta["runtime"].toDouble();
+    entry->created = QDateTime::fromString(meta["created"].toString(), Qt::ISODate);
+    entry->last_used = QDateTime::fromString(meta["last_used"].toString(), Qt::ISODate);
+    entry->bytes = DirBytes(EntryDir(key));
+    return QFileInfo::exists(entry->result_file);
+}
+
+bool ResultCache::WriteMeta(const Entry& entry) const {
+    QJsonObject meta;
+    meta["result_file"] = QFileInfo(entry.result_file).fileName();
+    meta["log_file"] = entry.log_file.isEmpty() ? QString() : QFileInfo(entry.log_file).fileName();
+    meta["data_file"] = entry.data_file;
+    meta["final_v"] = entry.final_v;
+    meta["iterations"] = entry.iterations;
+    meta["runtime"] = entry.runtime;
+    meta["created"] = entry.created.toString(Qt::ISODate);
+    meta["last_used"] = entry.last_used.toString(Qt::ISODate);
+
+    // 先写临时文件再替换, 中途退出不会留下损坏的记录
+    QSaveFile file(QDir(EntryDir(entry.key)).filePath(kMetaFile));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    file.write(QJsonDocument(meta).toJson(QJsonDocument::Compact));
+    return file.commit();
+}
+
+bool ResultCache::Lookup(const QString& key, Entry* entry) {
+    if (key.isEmpty() || !ReadMeta(key, entry)) {
+        return false;
+    }
+    entry->last_used = QDateTime::currentDateTime();
+    WriteMeta(*entry);
+    return true;
+}
+
+bool ResultCache::Store(const Entry& entry) {
+    if (entry.key.isEmpty() || !QFileInfo::exists(entry.result_file)) {
+        return false;
+    }
+
+    // 覆盖同键的旧记录
+    QDir dir(EntryDir(entry.key));
+    if (dir.exists()) {
+        dir.removeRecursively();
+    }
+    if (!QDir().mkpath(dir.path())) {
+        return false;
+    }
+
+    Entry stored = entry;
+    stored.result_file = dir.filePath(kResultFile);
+    QString error;
+    const bool stored_binary = ResultFile::IsResultFile(entry.result_file)
+        ? QFile::copy(entry.result_file, stored.result_file)
+        : ResultFile::Convert(entry.result_file, stored.result_file, &error);
+    if (!stored_binary) {
+        stored.result_file = dir.filePath(kJsonResultFile);
+        if (!QFile::copy(entry.result_file, stored.result_file)) {
+            dir.removeRecursively();
+            return false;
+        }
+    }
+    if (!entry.log_file.isEmpty() && QFileInfo::exists(entry.log_file)) {
+        // 保留扩展名, 压缩日志 (.logz) 仍能按格式还原
+        stored.log_file = dir.filePath("solver." + QFileInfo(entry.log_file).suffix());
+        if (!QFile::copy(entry.log_file, stored.log_file)) {
+            stored.log_file.clear();
+        }
+    } else {
+        stored.log_file.clear();
+    }
+    stored.created = QDateTime::currentDateTime();
+    stored.last_used = stored.created;
+
+    if (!WriteMeta(stored)) {
+        dir.removeRecursively();
+        return false;
+    }
+
+    Evict();
+    return true;
+}
+
+void ResultCache::Evict() {
+    const QDir root(root_);
+    if (!root.exists()) return;
+
+    QVector<Entry> entries;
+    const QDateTime now = QDateTime::currentDateTime();
+    for (const QString& key : root.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        Entry entry;
+        const bool valid = ReadMeta(key, &entry);
+        const bool expired = valid && max_age_days_ > 0
+            && entry.last_used.daysTo(now) > max_age_days_;
+        // 残缺或过期的记录直接删除
+        if (!valid || expired) {
+            QDir(EntryDir(key)).removeRecursively();
+            continue;
+        }
+        entries.append(entry);
+    }
+
+    if (max_bytes_ <= 0) return;
+
+    qint64 total = 0;
+    for (const Entry& entry : entries) {
+        total += entry.bytes;
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.last_used < b.last_used;
+    });
+    for (const Entry& entry : entries) {
+        if (total <= max_bytes_) break;
+        QDir(EntryDir(entry.key)).removeRecursively();
+        total -= entry.bytes;
+    }
+}
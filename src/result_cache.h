@@ -0,0 +1,55 @@
+// result_cache.h - 求解结果缓存
+// 以 (实例文件内容, 规范化参数, 求解器程序) 的哈希为键保存结果和运行日志, 按总大小和闲置时间淘汰
+
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include <QDateTime>
+#include <QString>
+#include <QVariantMap>
+
+class ResultCache {
+public:
+    // 一条缓存记录
+    struct Entry {
+        QString key;
+        QString result_file;   // 结果文件 (二进制 .gmr, 旧记录为 JSON)
+        QString log_file;      // 运行日志 (可能为压缩格式, 可为空)
+        QString data_file;     // 生成该结果的实例文件 (仅供显示)
+        double final_v = 0.0;
+        int iterations = 0;
+        double runtime = 0.0;
+        QDateTime created;
+        QDateTime last_used;
+        qint64 bytes = 0;
+    };
+
+    explicit ResultCache(const QString& root);
+
+    // 淘汰条件: 总大小上限 (字节) 和最长闲置天数, 0 表示不限
+    void SetLimits(qint64 max_bytes, int max_age_days);
+
+    // 计算缓存键, 文件无法读取时返回空串; 可在任意线程调用 (大文件首次哈希较慢, 不宜在界面线程上)
+    // 文件哈希取自 FileHash 的进程内缓存, 求解器程序不必每次重算
+    QString Key(const QString& data_file, const QVariantMap& params, const QString& solver_path);
+
+    // 查找记录, 命中时更新最近使用时间
+    bool Lookup(const QString& key, Entry* entry);
+
+    // 结果转为二进制格式, 与日志一起存入缓存, 随后按限制淘汰
+    bool Store(const Entry& entry);
+
+    // 删除过期记录, 再按最近使用时间从旧到新删除直到总大小不超限
+    void Evict();
+
+private:
+    QString EntryDir(const QString& key) const;
+    bool ReadMeta(const QString& key, Entry* entry) const;
+    bool WriteMeta(const Entry& entry) const;
+
+    QString root_;
+    qint64 max_bytes_;
+    int max_age_days_;
+};
+
+#endif  // RESULT_CACHE_H
@@ -0,0 +1,573 @@
+// result_file.cpp - 二进制结果文件实现
+// 文件格式: 魔数 "GMRES001" + quint32 版本 + quint32 索引长度 + 索引 (CBOR) + 各节 qCompress(CBOR)
+// 索引: {"summary": [偏移, 长度, 0], "tables": {表名: [偏移, 长度, 行数]}}, 偏移相对索引之后的数据区
+
+#include "result_file.h"
+
+#include <QCborValue>
+#include <QDataStream>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QtEndian>
+
+#include <cstring>
+#include <limits>
+
+namespace {
+
+constexpr char kMagic[] = "GMRES001";
+constexpr int kMagicSize = 8;
+constexpr quint32 kVersion = 1;
+
+// 索引的长度上限, 防止损坏的文件头导致超大分配
+constexpr quint32 kMaxIndexBytes = 16 * 1024 * 1024;
+
+template <typename T>
+QByteArray Pack(const QVector<T>& values) {
+    QByteArray bytes(values.size() * qsizetype(sizeof(T)), Qt::Uninitialized);
+    qToLittleEndian<T>(values.constData(), values.size(), bytes.data());
+    return bytes;
+}
+
+template <typename T>
+bool Unpack(const QByteArray& bytes, qsizetype count, QVector<T>* values) {
+    if (bytes.size() != count * qsizetype(sizeof(T))) {
+        return false;
+    }
+    values->resize(count);
+    qFromLittleEndian<T>(bytes.constData(), count, values->data());
+    return true;
+}
+
+// 对象数组才单独成节 (约束, 迭代历史等随规模增长的部分)
+bool IsTableValue(const QJsonValue& value) {
+    if (!value.isArray()) return false;
+    const QJsonArray rows = value.toArray();
+    if (rows.isEmpty()) return false;
+    for (const QJsonValue& row : rows) {
+        if (!row.isObject()) return false;
+    }
+    return true;
+}
+
+QCborArray SectionEntry(qint64 offset, qint64 size, int rows) {
+    return QCborArray{offset, size, rows};
+}
+
+bool ParseSectionEntry(const QCborValue& value, qint64 data_size, qint64* offset, qint64* size, int* rows) {
+    const QCborArray entry = value.toArray();
+    if (entry.size() != 3) return false;
+    *offset = entry[0].toInteger(-1);
+    *size = entry[1].toInteger(-1);
+    *rows = static_cast<int>(entry[2].toInteger(-1));
+    return *offset >= 0 && *size >= 0 && *rows >= 0 && *offset + *size <= data_size;
+}
+
+}  // namespace
+
+// ========== ResultTable ==========
+
+const ResultTable::Column* ResultTable::Find(const QString& key, int row) const {
+    auto it = columns_.constFind(key);
+    if (it == columns_.constEnd() || row < 0 || row >= rows_ || !it->IsPresent(row)) {
+        return nullptr;
+    }
+    return &it.value();
+}
+
+double ResultTable::Double(const QString& key, int row, double fallback) const {
+    const Column* column = Find(key, row);
+    if (!column) return fallback;
+    switch (column->type) {
+    case ColumnType::kDouble:
+        return column->doubles[row];
+    case ColumnType::kInteger:
+        return static_cast<double>(column->integers[row]);
+    default:
+        return fallback;
+    }
+}
+
+qint64 ResultTable::Integer(const QString& key, int row, qint64 fallback) const {
+    const Column* column = Find(key, row);
+    if (!column) return fallback;
+    switch (column->type) {
+    case ColumnType::kInteger:
+        return column->integers[row];
+    case ColumnType::kDouble:
+        return static_cast<qint64>(column->doubles[row]);
+    default:
+        return fallback;
+    }
+}
+
+bool ResultTable::Bool(const QString& key, int row, bool fallback) const {
+    const Column* column = Find(key, row);
+    if (!column || column->type != ColumnType::kBool) return fallback;
+    return column->flags[row] != 0;
+}
+
+Coalition ResultTable::CoalitionAt(const QString& key, int row) const {
+    Coalition coalition;
+    const Column* column = Find(key, row);
+    if (!column || column->type != ColumnType::kIntList) return coalition;
+    for (qint32 i = column->offsets[row]; i < column->offsets[row + 1]; ++i) {
+        if (!coalition.Add(column->items[i])) {
+            return Coalition();
+        }
+    }
+    return coalition;
+}
+
+QJsonValue ResultTable::Value(const QString& key, int row) const {
+    const Column* column = Find(key, row);
+    if (!column) return QJsonValue(QJsonValue::Undefined);
+    switch (column->type) {
+    case ColumnType::kDouble:
+        return column->doubles[row];
+    case ColumnType::kInteger:
+        return column->integers[row];
+    case ColumnType::kBool:
+        return column->flags[row] != 0;
+    case ColumnType::kString:
+        return column->strings[row];
+    case ColumnType::kIntList: {
+        QJsonArray members;
+        for (qint32 i = column->offsets[row]; i < column->offsets[row + 1]; ++i) {
+            members.append(column->items[i]);
+        }
+        return members;
+    }
+    case ColumnType::kValue:
+        return column->values[row].toJsonValue();
+    }
+    return QJsonValue(QJsonValue::Undefined);
+}
+
+ResultTable ResultTable::FromJson(const QJsonArray& rows) {
+    // 单个取值的类型; 数值无小数部分时算整数
+    auto classify = [](const QJsonValue& value) {
+        if (value.isBool()) return ColumnType::kBool;
+        if (value.isString()) return ColumnType::kString;
+        if (value.isDouble()) {
+            return QCborValue::fromJsonValue(value).isInteger() ? ColumnType::kInteger : ColumnType::kDouble;
+        }
+        if (value.isArray()) {
+            for (const QJsonValue& item : value.toArray()) {
+                const QCborValue number = QCborValue::fromJsonValue(item);
+                if (!number.isInteger()
+                    || number.toInteger() < std::numeric_limits<qint32>::min()
+                    || number.toInteger() > std::numeric_limits<qint32>::max()) {
+                    return ColumnType::kValue;
+                }
+            }
+            return ColumnType::kIntList;
+        }
+        return ColumnType::kValue;
+    };
+
+    // 先由全部行确定每列的类型: 整数和浮点混合时按浮点, 其他不一致按原样保存
+    QHash<QString, ColumnType> types;
+    for (const QJsonValue& row : rows) {
+        const QJsonObject object = row.toObject();
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            const ColumnType type = classify(it.value());
+            auto found = types.find(it.key());
+            if (found == types.end()) {
+                types.insert(it.key(), type);
+            } else if (*found != type) {
+                const bool numeric = (*found == ColumnType::kInteger || *found == ColumnType::kDouble)
+                    && (type == ColumnType::kInteger || type == ColumnType::kDouble);
+                *found = numeric ? ColumnType::kDouble : ColumnType::kValue;
+            }
+        }
+    }
+
+    ResultTable table;
+    table.rows_ = rows.size();
+    for (auto it = types.constBegin(); it != types.constEnd(); ++it) {
+        const QString& key = it.key();
+        Column column;
+        column.type = it.value();
+        column.present.fill(1, rows.size());
+        bool all_present = true;
+        if (column.type == ColumnType::kIntList) {
+            column.offsets.reserve(rows.size() + 1);
+            column.offsets.append(0);
+        }
+
+        for (int i = 0; i < rows.size(); ++i) {
+            const QJsonValue value = rows[i].toObject().value(key);
+            const bool present = !value.isUndefined();
+            if (!present) {
+                column.present[i] = 0;
+                all_present = false;
+            }
+            switch (column.type) {
+            case ColumnType::kDouble:
+                column.doubles.append(value.toDouble());
+                break;
+            case ColumnType::kInteger:
+                column.integers.append(value.toInteger());
+                break;
+            case ColumnType::kBool:
+                column.flags.append(value.toBool() ? 1 : 0);
+                break;
+            case ColumnType::kString:
+                column.strings.append(value.toString());
+                break;
+            case ColumnType::kIntList:
+                for (const QJsonValue& item : value.toArray()) {
+                    column.items.append(item.toInt());
+                }
+                column.offsets.append(column.items.size());
+                break;
+            case ColumnType::kValue:
+                column.values.append(QCborValue::fromJsonValue(value));
+                break;
+            }
+        }
+        if (all_present) {
+            column.present.clear();
+        }
+        table.columns_.insert(key, column);
+    }
+    return table;
+}
+
+QJsonArray ResultTable::ToJson() const {
+    QJsonArray rows;
+    for (int i = 0; i < rows_; ++i) {
+        QJsonObject object;
+        for (auto it = columns_.constBegin(); it != columns_.constEnd(); ++it) {
+            if (it->IsPresent(i)) {
+                object.insert(it.key(), Value(it.key(), i));
+            }
+        }
+        rows.append(object);
+    }
+    return rows;
+}
+
+QCborMap ResultTable::ToCbor() const {
+    QCborMap columns;
+    for (auto it = columns_.constBegin(); it != columns_.constEnd(); ++it) {
+        const Column& column = it.value();
+        QCborMap map;
+        map.insert(QStringLiteral("type"), static_cast<int>(column.type));
+        if (!column.present.isEmpty()) {
+            map.insert(QStringLiteral("present"), column.present);
+        }
+        switch (column.type) {
+        case ColumnType::kDouble:
+            map.insert(QStringLiteral("data"), Pack(column.doubles));
+            break;
+        case ColumnType::kInteger:
+            map.insert(QStringLiteral("data"), Pack(column.integers));
+            break;
+        case ColumnType::kBool:
+            map.insert(QStringLiteral("data"), column.flags);
+            break;
+        case ColumnType::kString:
+            map.insert(QStringLiteral("data"), QCborArray::fromStringList(column.strings));
+            break;
+        case ColumnType::kIntList:
+            map.insert(QStringLiteral("offsets"), Pack(column.offsets));
+            map.insert(QStringLiteral("data"), Pack(column.items));
+            break;
+        case ColumnType::kValue:
+            map.insert(QStringLiteral("data"), column.values);
+            break;
+        }
+        columns.insert(it.key(), map);
+    }
+
+    QCborMap table;
+    table.insert(QStringLiteral("rows"), rows_);
+    table.insert(QStringLiteral("columns"), columns);
+    return table;
+}
+
+bool ResultTable::FromCbor(const QCborMap& map, ResultTable* table) {
+    ResultTable loaded;
+    loaded.rows_ = static_cast<int>(map.value(QStringLiteral("rows")).toInteger(-1));
+    if (loaded.rows_ < 0) return false;
+    const qsizetype rows = loaded.rows_;
+
+    const QCborMap columns = map.value(QStringLiteral("columns")).toMap();
+    for (auto it = columns.constBegin(); it != columns.constEnd(); ++it) {
+        const QCborMap entry = it.value().toMap();
+        const qint64 type = entry.value(QStringLiteral("type")).toInteger(-1);
+        if (type < static_cast<int>(ColumnType::kDouble) || type > static_cast<int>(ColumnType::kValue)) {
+            return false;
+        }
+
+        Column column;
+        column.type = static_cast<ColumnType>(type);
+        column.present = entry.value(QStringLiteral("present")).toByteArray();
+        if (!column.present.isEmpty() && column.present.size() != rows) {
+            return false;
+        }
+
+        const QCborValue data = entry.value(QStringLiteral("data"));
+        bool valid = true;
+        switch (column.type) {
+        case ColumnType::kDouble:
+            valid = Unpack(data.toByteArray(), rows, &column.doubles);
+            break;
+        case ColumnType::kInteger:
+            valid = Unpack(data.toByteArray(), rows, &column.integers);
+            break;
+        case ColumnType::kBool:
+            column.flags = data.toByteArray();
+            valid = column.flags.size() == rows;
+            break;
+        case ColumnType::kString:
+            for (const QCborValue& value : data.toArray()) {
+                column.strings.append(value.toString());
+            }
+            valid = column.strings.size() == rows;
+            break;
+        case ColumnType::kIntList: {
+            const QByteArray items = data.toByteArray();
+            valid = Unpack(entry.value(QStringLiteral("offsets")).toByteArray(), rows + 1, &column.offsets)
+                && Unpack(items, items.size() / qsizetype(sizeof(qint32)), &column.items)
+                && column.offsets.first() == 0 && column.offsets.last() == column.items.size();
+            for (qsizetype i = 0; valid && i < rows; ++i) {
+                valid = column.offsets[i] <= column.offsets[i + 1];
+            }
+            break;
+        }
+        case ColumnType::kValue:
+            column.values = data.toArray();
+            valid = column.values.size() == rows;
+            break;
+        }
+        if (!valid) return false;
+        loaded.columns_.insert(it.key().toString(), column);
+    }
+
+    *table = loaded;
+    return true;
+}
+
+// ========== ResultFile ==========
+
+bool ResultFile::IsResultFile(const QString& path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    char magic[kMagicSize];
+    return file.read(magic, kMagicSize) == kMagicSize && std::memcmp(magic, kMagic, kMagicSize) == 0;
+}
+
+bool ResultFile::Write(const QString& path, const QJsonObject& result, QString* error) {
+    // 对象数组各为一节, 其余字段归入摘要
+    QCborMap summary;
+    QVector<QPair<QString, ResultTable>> tables;
+    for (auto it = result.constBegin(); it != result.constEnd(); ++it) {
+        if (IsTableValue(it.value())) {
+            tables.append({it.key(), ResultTable::FromJson(it.value().toArray())});
+        } else {
+            summary.insert(it.key(), QCborValue::fromJsonValue(it.value()));
+        }
+    }
+
+    QByteArray data;
+    auto add_section = [&data](const QCborValue& value, int rows) {
+        const QByteArray packed = qCompress(value.toCbor());
+        const QCborArray entry = SectionEntry(data.size(), packed.size(), rows);
+        data.append(packed);
+        return entry;
+    };
+
+    QCborMap index;
+    index.insert(QStringLiteral("summary"), add_section(summary, 0));
+    QCborMap table_index;
+    for (const auto& table : std::as_const(tables)) {
+        table_index.insert(table.first, add_section(table.second.ToCbor(), table.second.Rows()));
+    }
+    index.insert(QStringLiteral("tables"), table_index);
+    const QByteArray index_bytes = QCborValue(index).toCbor();
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *error = file.errorString();
+        return false;
+    }
+    QDataStream header(&file);
+    header.writeRawData(kMagic, kMagicSize);
+    header << kVersion << quint32(index_bytes.size());
+    file.write(index_bytes);
+    file.write(data);
+    if (!file.commit()) {
+        *error = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+bool ResultFile::Convert(const QString& source, const QString& target, QString* error) {
+    // 二进制 -> JSON
+    if (IsResultFile(source)) {
+        ResultFile file;
+        QJsonObject result;
+        if (!file.Open(source, error) || !file.ReadJson(&result, error)) {
+            return false;
+        }
+        QSaveFile out(target);
+        if (!out.open(QIODevice::WriteOnly)) {
+            *error = out.errorString();
+            return false;
+        }
+        out.write(QJsonDocument(result).toJson(QJsonDocument::Indented));
+        if (!out.commit()) {
+            *error = out.errorString();
+            return false;
+        }
+        return true;
+    }
+
+    // JSON -> 二进制
+    QFile in(source);
+    if (!in.open(QIODevice::ReadOnly)) {
+        *error = "无法打开文件: " + source;
+        return false;
+    }
+    QJsonParseError parse_error;
+    const QJsonDocument doc = QJsonDocument::fromJson(in.readAll(), &parse_error);
+    if (parse_error.error != QJsonParseError::NoError || !doc.isObject()) {
+        *error = "JSON 解析错误: " + parse_error.errorString();
+        return false;
+    }
+    return Write(target, doc.object(), error);
+}
+
+QString ResultFile::ConvertedPath(const QString& source) {
+    const QFileInfo info(source);
+    const QString suffix = IsResultFile(source) ? QString("json") : Suffix();
+    return info.dir().filePath(info.completeBaseName() + "." + suffix);
+}
+
+bool ResultFile::Open(const QString& path, QString* error) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        *error = "无法打开文件: " + path;
+        return false;
+    }
+
+    char magic[kMagicSize];
+    QDataStream header(&file);
+    quint32 version = 0;
+    quint32 index_size = 0;
+    if (header.readRawData(magic, kMagicSize) != kMagicSize
+        || std::memcmp(magic, kMagic, kMagicSize) != 0) {
+        *error = "不是二进制结果文件";
+        return false;
+    }
+    header >> version >> index_size;
+    if (version != kVersion) {
+        *error = QString("不支持的结果文件版本 %1").arg(version);
+        return false;
+    }
+    if (header.status() != QDataStream::Ok || index_size > kMaxIndexBytes) {
+        *error = "结果文件头损坏";
+        return false;
+    }
+
+    const QByteArray index_bytes = file.read(index_size);
+    QCborParserError parse_error;
+    const QCborMap index = QCborValue::fromCbor(index_bytes, &parse_error).toMap();
+    if (index_bytes.size() != qsizetype(index_size) || parse_error.error != QCborError::NoError) {
+        *error = "结果文件索引损坏";
+        return false;
+    }
+
+    // 逐节校验范围, 之后读取时不必再检查
+    data_offset_ = kMagicSize + 2 * qint64(sizeof(quint32)) + index_size;
+    const qint64 data_size = file.size() - data_offset_;
+    if (!ParseSectionEntry(index.value(QStringLiteral("summary")), data_size,
+                           &summary_.offset, &summary_.size, &summary_.rows)) {
+        *error = "结果文件索引损坏";
+        return false;
+    }
+    tables_.clear();
+    const QCborMap table_index = index.value(QStringLiteral("tables")).toMap();
+    for (auto it = table_index.constBegin(); it != table_index.constEnd(); ++it) {
+        Section section;
+        if (!ParseSectionEntry(it.value(), data_size, &section.offset, &section.size, &section.rows)) {
+            *error = "结果文件索引损坏";
+            return false;
+        }
+        tables_.insert(it.key().toString(), section);
+    }
+
+    path_ = path;
+    return true;
+}
+
+int ResultFile::TableRows(const QString& name) const {
+    auto it = tables_.constFind(name);
+    return it == tables_.constEnd() ? 0 : it->rows;
+}
+
+bool ResultFile::ReadSection(const Section& section, QCborValue* value, QString* error) const {
+    QFile file(path_);
+    if (!file.open(QIODevice::ReadOnly) || !file.seek(data_offset_ + section.offset)) {
+        *error = "无法读取文件: " + path_;
+        return false;
+    }
+    const QByteArray packed = file.read(section.size);
+    const QByteArray bytes = qUncompress(packed);
+    QCborParserError parse_error;
+    *value = QCborValue::fromCbor(bytes, &parse_error);
+    if (packed.size() != section.size || bytes.isEmpty() || parse_error.error != QCborError::NoError) {
+        *error = "结果文件数据损坏";
+        return false;
+    }
+    return true;
+}
+
+bool ResultFile::ReadSummary(QJsonObject* summary, QString* error) const {
+    QCborValue value;
+    if (!ReadSection(summary_, &value, error)) {
+        return false;
+    }
+    *summary = value.toMap().toJsonObject();
+    return true;
+}
+
+bool ResultFile::ReadTable(const QString& name, ResultTable* table, QString* error) const {
+    auto it = tables_.constFind(name);
+    if (it == tables_.constEnd()) {
+        *table = ResultTable();
+        return true;
+    }
+    QCborValue value;
+    if (!ReadSection(*it, &value, error)) {
+        return false;
+    }
+    if (!ResultTable::FromCbor(value.toMap(), table)) {
+        *error = "结果文件数据损坏: " + name;
+        return false;
+    }
+    return true;
+}
+
+bool ResultFile::ReadJson(QJsonObject* result, QString* error) const {
+    if (!ReadSummary(result, error)) {
+        return false;
+    }
+    for (auto it = tables_.constBegin(); it != tables_.constEnd(); ++it) {
+        ResultTable table;
+        if (!ReadTable(it.key(), &table, error)) {
+            return false;
+        }
+        result->insert(it.key(), table.ToJson());
+    }
+    return true;
+}
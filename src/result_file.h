@@ -0,0 +1,113 @@
+// result_file.h - 二进制结果文件 (.gmr)
+// 文件头带节索引, 摘要 (标量, 分配, 问题规模等) 和每个对象数组 (cuts, iteration_history 等) 各为一节, 单独压缩, 按需读取; 可与结果 JSON 双向转换
+
+#ifndef RESULT_FILE_H
+#define RESULT_FILE_H
+
+#include "coalition.h"
+
+#include <QByteArray>
+#include <QCborArray>
+#include <QCborMap>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+// 对象数组的列存储: 每个字段一列, 数值和成员列表为紧凑数组
+class ResultTable {
+public:
+    int Rows() const { return rows_; }
+    bool Has(const QString& key) const { return columns_.contains(key); }
+
+    // 第 row 行的字段值, 该行没有此字段或类型不符时返回 fallback
+    double Double(const QString& key, int row, double fallback = 0.0) const;
+    qint64 Integer(const QString& key, int row, qint64 fallback = 0) const;
+    bool Bool(const QString& key, int row, bool fallback = false) const;
+    Coalition CoalitionAt(const QString& key, int row) const;
+    QJsonValue Value(const QString& key, int row) const;
+
+    // 与 JSON 对象数组互相转换; 每列的类型由全部行的取值决定
+    static ResultTable FromJson(const QJsonArray& rows);
+    QJsonArray ToJson() const;
+
+    QCborMap ToCbor() const;
+    static bool FromCbor(const QCborMap& map, ResultTable* table);
+
+private:
+    enum class ColumnType { kDouble = 0, kInteger = 1, kBool = 2, kString = 3, kIntList = 4, kValue = 5 };
+
+    struct Column {
+        ColumnType type = ColumnType::kValue;
+        QByteArray present;         // 每行一字节, 空表示每行都有此字段
+        QVector<double> doubles;
+        QVector<qint64> integers;
+        QByteArray flags;           // kBool
+        QStringList strings;
+        QVector<qint32> offsets;    // kIntList: 第 i 行为 items[offsets[i], offsets[i + 1])
+        QVector<qint32> items;
+        QCborArray values;          // kValue: 其他取值原样保存
+
+        bool IsPresent(int row) const { return present.isEmpty() || present[row] != 0; }
+    };
+
+    // 该行有此字段时返回所在列
+    const Column* Find(const QString& key, int row) const;
+
+    int rows_ = 0;
+    QHash<QString, Column> columns_;
+};
+
+class ResultFile {
+public:
+    // 文件扩展名 (不含点)
+    static QString Suffix() { return "gmr"; }
+
+    // 按魔数判断是否为二进制结果文件
+    static bool IsResultFile(const QString& path);
+
+    // 由结果 JSON 写出二进制文件 (先写临时文件再替换)
+    static bool Write(const QString& path, const QJsonObject& result, QString* error);
+
+    // JSON 与二进制互相转换, 方向由源文件格式决定
+    static bool Convert(const QString& source, const QString& target, QString* error);
+
+    // 源文件转换后的默认路径: 同名, 换成另一种格式的扩展名
+    static QString ConvertedPath(const QString& source);
+
+    // 打开文件, 只读取文件头和节索引
+    bool Open(const QString& path, QString* error);
+
+    const QString& Path() const { return path_; }
+
+    bool HasTable(const QString& name) const { return tables_.contains(name); }
+
+    // 表的行数 (记录在索引中, 不必读取表), 没有该表时为 0
+    int TableRows(const QString& name) const;
+
+    // 摘要: 除对象数组以外的全部顶层字段
+    bool ReadSummary(QJsonObject* summary, QString* error) const;
+
+    bool ReadTable(const QString& name, ResultTable* table, QString* error) const;
+
+    // 读取全部节, 还原为结果 JSON
+    bool ReadJson(QJsonObject* result, QString* error) const;
+
+private:
+    struct Section {
+        qint64 offset = 0;     // 相对数据区起点
+        qint64 size = 0;
+        int rows = 0;
+    };
+
+    bool ReadSection(const Section& section, QCborValue* value, QString* error) const;
+
+    QString path_;
+    qint64 data_offset_ = 0;
+    Section summary_;
+    QHash<QString, Section> tables_;
+};
+
+#endif  // RESULT_FILE_H
@@ -0,0 +1,235 @@
+// result_loader.cpp - 结果文件后台加载实现
+
+#include "result_loader.h"
+
+#include <QFile>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QThread>
+
+namespace {
+
+// 每次读取的块大小
+constexpr qint64 kReadChunkBytes = 4 * 1024 * 1024;
+
+// 结果 JSON 各阶段在总进度中的区间: 读取 [0, 70), 解析 [70, 100]; 摘要部分的准备不计
+constexpr int kReadEnd = 70;
+
+}  // namespace
+
+ResultLoader::ResultLoader(QObject* parent)
+    : QObject(parent)
+    , thread_(new QThread(this))
+    , thread_root_(new QObject())
+    , current_request_(0)
+    , next_request_(1)
+    , loading_request_(0)
+    , loaded_request_(0) {
+    qRegisterMetaType<AnalysisDataPtr>();
+    qRegisterMetaType<CoalitionDataPtr>();
+    qRegisterMetaType<IterationDataPtr>();
+
+    thread_->setObjectName("ResultLoader");
+    thread_root_->moveToThread(thread_);
+    thread_->start();
+}
+
+ResultLoader::~ResultLoader() {
+    current_request_ = -1;
+    QObject* root = thread_root_;
+    QMetaObject::invokeMethod(root, [root]() { delete root; }, Qt::BlockingQueuedConnection);
+    thread_->quit();
+    thread_->wait();
+}
+
+int ResultLoader::Load(const QString& path, const QJsonObject& extra) {
+    if (loading_request_ != 0) {
+        emit Cancelled(loading_request_);
+    }
+    const int request_id = next_request_++;
+    current_request_ = request_id;
+    loading_request_ = request_id;
+
+    QMetaObject::invokeMethod(thread_root_, [this, request_id, path, extra]() {
+        Run(request_id, path, extra);
+    }, Qt::QueuedConnection);
+    return request_id;
+}
+
+void ResultLoader::LoadPart(int request_id, AnalysisPart part) {
+    QMetaObject::invokeMethod(thread_root_, [this, request_id, part]() {
+        RunPart(request_id, part);
+    }, Qt::QueuedConnection);
+}
+
+void ResultLoader::Cancel() {
+    if (loading_request_ == 0) return;
+
+    // 之前加载完成的结果仍可按需准备其余部分
+    const int request_id = loading_request_;
+    current_request_ = loaded_request_;
+    loading_request_ = 0;
+    emit Cancelled(request_id);
+}
+
+void ResultLoader::Run(int request_id, const QString& path, const QJsonObject& extra) {
+    auto cancelled = [this, request_id]() { return current_request_.load() != request_id; };
+
+    // 结果在主线程上发出, 先确认请求仍是最新的 (期间可能已取消或换了文件)
+    auto deliver = [this, request_id](std::function<void()> emit_result) {
+        QMetaObject::invokeMethod(this, [this, request_id, emit_result]() {
+            if (loading_request_ != request_id) return;
+            loading_request_ = 0;
+            emit_result();
+        }, Qt::QueuedConnection);
+    };
+
+    int last_percent = -1;
+    auto report = [&](int percent, const QString& stage) {
+        if (percent == last_percent) return;
+        last_percent = percent;
+        emit Progress(request_id, percent, stage);
+    };
+
+    auto fail = [&](const QString& error) {
+        deliver([this, request_id, path, error]() {
+            current_request_ = loaded_request_;
+            emit Failed(request_id, path, error);
+        });
+    };
+
+    // 摘要部分交出后, 这次的结果成为其余部分的来源
+    auto loaded = [&](const Source& source) {
+        source_ = source;
+        const AnalysisDataPtr ready = source.summary;
+        deliver([this, request_id, path, ready]() {
+            loaded_request_ = request_id;
+            emit Loaded(request_id, path, ready);
+        });
+    };
+
+    if (cancelled()) return;
+
+    Source source;
+    source.request_id = request_id;
+
+    // 二进制结果: 按索引只读摘要节, 约束和迭代历史留到 LoadPart
+    if (ResultFile::IsResultFile(path)) {
+        ResultFile result_file;
+        QSharedPointer<AnalysisData> data = QSharedPointer<AnalysisData>::create();
+        QString error;
+        if (!result_file.Open(path, &error) || !AnalysisData::FromResultFile(result_file, data.get(), &error)) {
+            fail(error);
+            return;
+        }
+        data->source_file = path;
+        source.binary = true;
+        source.file = result_file;
+        source.extra = extra;
+        source.summary = data;
+        loaded(source);
+        return;
+    }
+
+    // 读取: 按块读, 报告字节进度
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        fail("无法打开文件: " + path);
+        return;
+    }
+    const qint64 size = qMax<qint64>(1, file.size());
+    QByteArray bytes;
+    bytes.reserve(file.size());
+    while (!file.atEnd()) {
+        const QByteArray chunk = file.read(kReadChunkBytes);
+        if (chunk.isEmpty()) break;
+        bytes.append(chunk);
+        if (cancelled()) return;
+        report(static_cast<int>(bytes.size() * kReadEnd / size), "读取");
+    }
+    file.close();
+
+    // 解析
+    report(kReadEnd, "解析");
+    QJsonParseError parse_error;
+    const QJsonDocument doc = QJsonDocument::fromJson(bytes, &parse_error);
+    bytes = QByteArray();
+    if (parse_error.error != QJsonParseError::NoError) {
+        fail("JSON 解析错误: " + parse_error.errorString());
+        return;
+    }
+    if (cancelled()) return;
+
+    QJsonObject result = doc.object();
+    for (auto it = extra.constBegin(); it != extra.constEnd(); ++it) {
+        result.insert(it.key(), it.value());
+    }
+
+    // 摘要部分只用标量和分配, 立即交出; 解析后的结果留给其余部分
+    QSharedPointer<AnalysisData> data = QSharedPointer<AnalysisData>::create(AnalysisData::FromSummary(result));
+    data->source_file = path;
+    source.result = result;
+    source.summary = data;
+    loaded(source);
+}
+
+void ResultLoader::RunPart(int request_id, AnalysisPart part) {
+    auto cancelled = [this, request_id]() { return current_request_.load() != request_id; };
+    if (cancelled() || source_.request_id != request_id) return;
+
+    const QString stage = (part == AnalysisPart::kCoalitions) ? "联盟分析" : "迭代历史";
+    int last_percent = -1;
+    auto progress = [&](int percent) {
+        if (percent != last_percent) {
+            last_percent = percent;
+            emit Progress(request_id, percent, stage);
+        }
+        return !cancelled();
+    };
+
+    // 结果在主线程上发出, 先确认期间没有加载其他文件
+    auto deliver = [this, request_id](std::function<void()> emit_result) {
+        QMetaObject::invokeMethod(this, [this, request_id, emit_result]() {
+            if (current_request_.load() == request_id) {
+                emit_result();
+            }
+        }, Qt::QueuedConnection);
+    };
+
+    const OverviewData& overview = source_.summary->overview;
+    QString error;
+    if (part == AnalysisPart::kCoalitions) {
+        if (!source_.coalitions) {
+            QSharedPointer<CoalitionData> data = QSharedPointer<CoalitionData>::create();
+            const bool complete = source_.binary
+                ? CoalitionData::FromResultFile(source_.file, overview, data.get(), progress, &error)
+                : CoalitionData::FromJson(source_.result, overview, data.get(), progress);
+            if (complete) {
+                source_.coalitions = data;
+                source_.result.remove("cuts");
+            }
+        }
+        if (const CoalitionDataPtr ready = source_.coalitions) {
+            deliver([this, request_id, ready]() { emit CoalitionsLoaded(request_id, ready); });
+            return;
+        }
+    } else {
+        if (!source_.iterations) {
+            QSharedPointer<IterationData> data = QSharedPointer<IterationData>::create();
+            const bool complete = source_.binary
+                ? IterationData::FromResultFile(source_.file, source_.extra, overview, data.get(), progress, &error)
+                : IterationData::FromJson(source_.result, overview, data.get(), progress);
+            if (complete) {
+                source_.iterations = data;
+                source_.result.remove("iteration_history");
+            }
+        }
+        if (const IterationDataPtr ready = source_.iterations) {
+            deliver([this, request_id, ready]() { emit IterationsLoaded(request_id, ready); });
+            return;
+        }
+    }
+    if (!error.isEmpty()) {
+        deliver([this, request_id, part, error]() { emit PartFailed(request_id, part, error); });
+    }
+}
@@ -0,0 +1,88 @@
+// result_loader.h - 结果文件后台加载
+// 读取, 解析和面板数据准备都在加载线程上进行, 主线程只接收准备好的数据; 支持结果 JSON 和二进制结果文件 (.gmr)
+// 加载只准备摘要部分 (概览, 工厂视角) 并立即交出; 联盟分析和迭代历史由 LoadPart 按需准备
+
+#ifndef RESULT_LOADER_H
+#define RESULT_LOADER_H
+
+#include "analysis_data.h"
+
+#include <QJsonObject>
+#include <QObject>
+#include <atomic>
+
+class QThread;
+
+// 按需准备的部分
+enum class AnalysisPart {
+    kCoalitions,
+    kIterations
+};
+
+class ResultLoader : public QObject {
+    Q_OBJECT
+
+public:
+    explicit ResultLoader(QObject* parent = nullptr);
+
+    // 取消进行中的加载并停止加载线程
+    ~ResultLoader();
+
+    // 开始加载, 之前未完成的加载被取消; extra 中的字段在解析后并入结果 (如阶段计时)
+    // 返回请求编号, 之后的信号都带着它
+    int Load(const QString& path, const QJsonObject& extra = QJsonObject());
+
+    // 为已加载 (发出过 Loaded) 的请求准备一个部分, 完成后发出 CoalitionsLoaded / IterationsLoaded;
+    // 准备过的部分直接再次发出; 之后又加载了其他文件时忽略
+    void LoadPart(int request_id, AnalysisPart part);
+
+    // 取消进行中的加载 (随后发出 Cancelled); 之前加载完成的结果仍可 LoadPart
+    void Cancel();
+
+    bool IsLoading() const { return loading_request_ != 0; }
+
+signals:
+    // 进度 (0-100) 及当前阶段
+    void Progress(int request_id, int percent, QString stage);
+
+    // 摘要部分
+    void Loaded(int request_id, QString path, AnalysisDataPtr data);
+    void Failed(int request_id, QString path, QString error);
+    void Cancelled(int request_id);
+
+    // 按需准备的部分
+    void CoalitionsLoaded(int request_id, CoalitionDataPtr data);
+    void IterationsLoaded(int request_id, IterationDataPtr data);
+    void PartFailed(int request_id, AnalysisPart part, QString error);
+
+private:
+    // 在加载线程上执行
+    void Run(int request_id, const QString& path, const QJsonObject& extra);
+    void RunPart(int request_id, AnalysisPart part);
+
+    // 最近加载完成的结果, 其余部分由此准备并缓存; 只在加载线程上访问
+    struct Source {
+        int request_id = 0;
+        bool binary = false;
+        ResultFile file;            // 二进制结果 (只含索引)
+        QJsonObject result;         // 结果 JSON (extra 已并入), 部分准备好后移除对应的数组
+        QJsonObject extra;
+        AnalysisDataPtr summary;
+        CoalitionDataPtr coalitions;
+        IterationDataPtr iterations;
+    };
+    Source source_;
+
+    QThread* thread_;
+    QObject* thread_root_;
+
+    // 最新的请求编号; 加载线程看到编号变化即放弃当前请求
+    std::atomic<int> current_request_;
+
+    // 以下成员只在主线程上访问
+    int next_request_;
+    int loading_request_;
+    int loaded_request_;    // 最近发出 Loaded 的请求, 取消或加载失败后恢复为当前请求
+};
+
+#endif  // RESULT_LOADER_H
@@ -0,0 +1,228 @@
+// results_model.cpp - 求解 Tab 实时结果模型实现
+
+#include "results_model.h"
+
+#include <algorithm>
+
+// ========== AllocationTableModel ==========
+
+AllocationTableModel::AllocationTableModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , has_values_(false) {
+}
+
+int AllocationTableModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : static_cast<int>(values_.size());
+}
+
+int AllocationTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : 3;
+}
+
+QVariant AllocationTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const int row = index.row();
+    switch (index.column()) {
+    case 0:
+        return QString::number(row);
+    case 1:
+        return has_values_ ? QString::number(values_[row], 'f', 2) : QString("-");
+    case 2:
+        return has_values_ ? QString("%1%").arg(ratios_[row], 0, 'f', 1) : QString("-");
+    default:
+        return QVariant();
+    }
+}
+
+QVariant AllocationTableModel::headerData(int section, Qt::Orientation orientation,
+                                          int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    static const char* kHeaders[] = {"工厂", "分配", "占比"};
+    return QString(kHeaders[section]);
+}
+
+void AllocationTableModel::SetProblemSize(int plants) {
+    beginResetModel();
+    values_.fill(0.0, plants);
+    ratios_.fill(0.0, plants);
+    has_values_ = false;
+    endResetModel();
+}
+
+void AllocationTableModel::SetAllocation(const QVector<double>& pi) {
+    const int rows = static_cast<int>(qMin(pi.size(), values_.size()));
+    if (rows == 0) return;
+
+    double total = 0.0;
+    for (int i = 0; i < rows; ++i) {
+        total += pi[i];
+    }
+
+    // 首次赋值时整表刷新
+    const bool all = !has_values_;
+    has_values_ = true;
+
+    // 连续变化的行合并为一次通知
+    int changed_first = -1;
+    for (int i = 0; i <= rows; ++i) {
+        bool changed = false;
+        if (i < rows) {
+            const double ratio = (total > 0) ? (pi[i] / total * 100.0) : 0.0;
+            changed = all || pi[i] != values_[i] || ratio != ratios_[i];
+            values_[i] = pi[i];
+            ratios_[i] = ratio;
+        }
+
+        if (changed && changed_first < 0) {
+            changed_first = i;
+        } else if (!changed && changed_first >= 0) {
+            emit dataChanged(index(changed_first, 1), index(i - 1, 2), {Qt::DisplayRole});
+            changed_first = -1;
+        }
+    }
+}
+
+void AllocationTableModel::Clear() {
+    beginResetModel();
+    values_.clear();
+    ratios_.clear();
+    has_values_ = false;
+    endResetModel();
+}
+
+// ========== CutTableModel ==========
+
+CutTableModel::CutTableModel(QObject* parent)
+    : QAbstractTableModel(parent)
+    , top_k_(0) {
+}
+
+int CutTableModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid()) return 0;
+    return top_k_ > 0 ? static_cast<int>(top_rows_.size()) : CutCount();
+}
+
+int CutTableModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : 3;
+}
+
+QVariant CutTableModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    const int cut = CutAt(index.row());
+    switch (index.column()) {
+    case 0:
+        return CoalitionText(cut);
+    case 1:
+        return QString::number(costs_[cut], 'f', 2);
+    case 2:
+        return QString::number(violations_[cut], 'f', 4);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant CutTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    static const char* kHeaders[] = {"联盟", "成本", "违反"};
+    return QString(kHeaders[section]);
+}
+
+void CutTableModel::AppendCuts(const QVector<Cut>& cuts) {
+    if (cuts.isEmpty()) return;
+
+    const int first = CutCount();
+    const int count = static_cast<int>(cuts.size());
+    const bool show_all = top_k_ <= 0;
+
+    if (show_all) {
+        beginInsertRows(QModelIndex(), first, first + count - 1);
+    }
+
+    masks_.reserve(first + count);
+    costs_.reserve(first + count);
+    violations_.reserve(first + count);
+    for (const Cut& cut : cuts) {
+        if (cut.coalition.IsWide()) {
+            wide_coalitions_.insert(static_cast<int>(masks_.size()), cut.coalition);
+        }
+        masks_.append(cut.coalition.Mask());
+        costs_.append(cut.cost);
+        violations_.append(cut.violation);
+    }
+
+    if (show_all) {
+        endInsertRows();
+        return;
+    }
+
+    // 前 K 视图: 只有进入前 K 的新约束会改动显示, 行数不超过 K, 变化时直接重置
+    QVector<int> top = top_rows_;
+    bool changed = false;
+    for (int cut = first; cut < first + count; ++cut) {
+        changed |= OfferTop(cut, &top);
+    }
+    if (changed) {
+        beginResetModel();
+        top_rows_.swap(top);
+        endResetModel();
+    }
+}
+
+void CutTableModel::Clear() {
+    beginResetModel();
+    masks_.clear();
+    costs_.clear();
+    violations_.clear();
+    wide_coalitions_.clear();
+    top_rows_.clear();
+    endResetModel();
+}
+
+void CutTableModel::SetTopK(int k) {
+    k = qMax(0, k);
+    if (k == top_k_) return;
+
+    beginResetModel();
+    top_k_ = k;
+    top_rows_.clear();
+    if (top_k_ > 0) {
+        for (int cut = 0; cut < CutCount(); ++cut) {
+            OfferTop(cut, &top_rows_);
+        }
+    }
+    endResetModel();
+}
+
+bool CutTableModel::OfferTop(int cut, QVector<int>* top) const {
+    const double violation = violations_[cut];
+    if (top->size() >= top_k_ && violation <= violations_[top->last()]) {
+        return false;
+    }
+
+    // 违反相同时先到的在前
+    auto pos = std::upper_bound(top->begin(), top->end(), violation,
+        [this](double value, int row) { return value > violations_[row]; });
+    top->insert(pos, cut);
+    if (top->size() > top_k_) {
+        top->removeLast();
+    }
+    return true;
+}
+
+QString CutTableModel::CoalitionText(int cut) const {
+    const auto wide = wide_coalitions_.constFind(cut);
+    if (wide != wide_coalitions_.constEnd()) {
+        return wide.value().ToString();
+    }
+    return Coalition::FromMask(masks_[cut]).ToString();
+}
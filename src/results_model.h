@@ -0,0 +1,92 @@
+// results_model.h - 求解 Tab 实时结果模型
+// 分配表只通知数值变化的行; 约束表按列存储, 每批一次插入通知, 可只显示违反最大的前 K 条
+
+#ifndef RESULTS_MODEL_H
+#define RESULTS_MODEL_H
+
+#include "coalition.h"
+
+#include <QAbstractTableModel>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+// 分配方案: 工厂 / 分配 / 占比
+class AllocationTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    explicit AllocationTableModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    // 重置为 plants 行, 数值未知
+    void SetProblemSize(int plants);
+
+    // 更新分配, 只对分配或占比变化的行发出 dataChanged
+    void SetAllocation(const QVector<double>& pi);
+
+    void Clear();
+
+private:
+    QVector<double> values_;
+    QVector<double> ratios_;
+    bool has_values_;
+};
+
+// 联盟约束: 联盟 / 成本 / 违反
+class CutTableModel : public QAbstractTableModel {
+    Q_OBJECT
+
+public:
+    struct Cut {
+        Coalition coalition;
+        double cost;
+        double violation;
+    };
+
+    explicit CutTableModel(QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation,
+                        int role = Qt::DisplayRole) const override;
+
+    // 追加一批约束 (一次插入通知)
+    void AppendCuts(const QVector<Cut>& cuts);
+
+    void Clear();
+
+    // 只显示违反最大的前 k 条 (k <= 0 恢复按到达顺序显示全部)
+    void SetTopK(int k);
+    int TopK() const { return top_k_; }
+
+    // 已存储的约束总数 (与显示行数无关)
+    int CutCount() const { return static_cast<int>(costs_.size()); }
+
+private:
+    // 显示行 -> 存储下标
+    int CutAt(int row) const { return top_k_ > 0 ? top_rows_[row] : row; }
+
+    // 约束若进入前 K 则插入 top (按违反降序), 返回是否改变
+    bool OfferTop(int cut, QVector<int>* top) const;
+
+    QString CoalitionText(int cut) const;
+
+    // 列存储; 成员编号超过 63 的联盟另存完整对象
+    QVector<quint64> masks_;
+    QVector<double> costs_;
+    QVector<double> violations_;
+    QHash<int, Coalition> wide_coalitions_;
+
+    // 前 K 视图 (按违反降序的存储下标)
+    int top_k_;
+    QVector<int> top_rows_;
+};
+
+#endif  // RESULTS_MODEL_H
@@ -4,8 +4,26 @@
 
 #include <QVBoxLayout>
 #include <QGroupBox>
-#include <QTableWidget>
+#include <QTableView>
 #include <QHeaderView>
+#include <QCheckBox>
+
+namespace {
+
+// 只看违反最大的约束时显示的条数
+constexpr int kTopCutCount = 50;
+
+// 两张表共用的视图设置
+void SetupTableView(QTableView* table) {
+    table->horizontalHeader()->setStretchLastSection(true);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table->verticalHeader()->setVisible(false);
+    table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+}
+
+}  // namespace
 
 ResultsWidget::ResultsWidget(QWidget* parent)
     : QWidget(parent)
@@ -24,14 +42,10 @@ void ResultsWidget::SetupUI() {
     QVBoxLayout* alloc_layout = new QVBoxLayout(alloc_group);
     alloc_layout->setContentsMargins(8, 12, 8, 8);
 
-    allocation_table_ = new QTableWidget();
-    allocation_table_->setColumnCount(3);
-    allocation_table_->setHorizontalHeaderLabels({"工厂", "分配", "占比"});
-    allocation_table_->horizontalHeader()->setStretchLastSection(true);
-    allocation_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    allocation_table_->verticalHeader()->setVisible(false);
-    allocation_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    allocation_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    allocation_model_ = new AllocationTableModel(this);
+    allocation_table_ = new QTableView();
+    allocation_table_->setModel(allocation_model_);
+    SetupTableView(allocation_table_);
     allocation_table_->setMaximumHeight(120);
     alloc_layout->addWidget(allocation_table_);
 
@@ -42,23 +56,26 @@ void ResultsWidget::SetupUI() {
     QVBoxLayout* coalition_layout = new QVBoxLayout(coalition_group);
     coalition_layout->setContentsMargins(8, 12, 8, 8);
 
-    coalition_table_ = new QTableWidget();
-    coalition_table_->setColumnCount(3);
-    coalition_table_->setHorizontalHeaderLabels({"联盟", "成本", "违反"});
-    coalition_table_->horizontalHeader()->setStretchLastSection(true);
-    coalition_table_->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
-    coalition_table_->verticalHeader()->setVisible(false);
-    coalition_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
-    coalition_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    top_cuts_check_ = new QCheckBox(QString("只看违反最大的 %1 条").arg(kTopCutCount));
+    coalition_layout->addWidget(top_cuts_check_);
+
+    cut_model_ = new CutTableModel(this);
+    coalition_table_ = new QTableView();
+    coalition_table_->setModel(cut_model_);
+    SetupTableView(coalition_table_);
     coalition_table_->setMaximumHeight(100);
     coalition_layout->addWidget(coalition_table_);
 
     main_layout->addWidget(coalition_group);
+
+    connect(top_cuts_check_, &QCheckBox::toggled, this, [this](bool checked) {
+        cut_model_->SetTopK(checked ? kTopCutCount : 0);
+    });
 }
 
 void ResultsWidget::Clear() {
-    allocation_table_->setRowCount(0);
-    coalition_table_->setRowCount(0);
+    allocation_model_->Clear();
+    cut_model_->Clear();
     num_plants_ = 0;
 }
 
@@ -66,35 +83,17 @@ void ResultsWidget::SetProblemSize(int plants) {
     num_plants_ = plants;
 
     // 初始化分配表格
-    allocation_table_->setRowCount(plants);
-    for (int i = 0; i < plants; ++i) {
-        allocation_table_->setItem(i, 0, new QTableWidgetItem(QString::number(i)));
-        allocation_table_->setItem(i, 1, new QTableWidgetItem("-"));
-        allocation_table_->setItem(i, 2, new QTableWidgetItem("-"));
-    }
+    allocation_model_->SetProblemSize(plants);
 }
 
 void ResultsWidget::SetAllocation(const QVector<double>& pi) {
-    // 计算总和
-    double total = 0.0;
-    for (int i = 0; i < pi.size() && i < allocation_table_->rowCount(); ++i) {
-        total += pi[i];
-    }
-
-    // 更新分配表格
-    for (int i = 0; i < pi.size() && i < allocation_table_->rowCount(); ++i) {
-        allocation_table_->item(i, 1)->setText(QString::number(pi[i], 'f', 2));
-
-        double ratio = (total > 0) ? (pi[i] / total * 100.0) : 0.0;
-        allocation_table_->item(i, 2)->setText(QString("%1%").arg(ratio, 0, 'f', 1));
-    }
+    allocation_model_->SetAllocation(pi);
 }
 
-void ResultsWidget::AddCoalitionCut(const QString& coalition, double cost, double violation) {
-    int row = coalition_table_->rowCount();
-    coalition_table_->insertRow(row);
+void ResultsWidget::AddCoalitionCut(const Coalition& coalition, double cost, double violation) {
+    AddCoalitionCuts({CutRow{coalition, cost, violation}});
+}
 
-    coalition_table_->setItem(row, 0, new QTableWidgetItem(coalition));
-    coalition_table_->setItem(row, 1, new QTableWidgetItem(QString::number(cost, 'f', 2)));
-    coalition_table_->setItem(row, 2, new QTableWidgetItem(QString::number(violation, 'f', 4)));
+void ResultsWidget::AddCoalitionCuts(const QVector<CutRow>& rows) {
+    cut_model_->AppendCuts(rows);
 }
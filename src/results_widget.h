@@ -3,15 +3,21 @@
 #ifndef RESULTS_WIDGET_H
 #define RESULTS_WIDGET_H
 
+#include "results_model.h"
+
 #include <QWidget>
 #include <QVector>
 
-class QTableWidget;
+class QTableView;
+class QCheckBox;
 
 class ResultsWidget : public QWidget {
     Q_OBJECT
 
 public:
+    // 联盟约束行
+    using CutRow = CutTableModel::Cut;
+
     explicit ResultsWidget(QWidget* parent = nullptr);
 
     // 清空结果
@@ -20,20 +26,26 @@ public:
     // 设置问题规模 (初始化表格)
     void SetProblemSize(int plants);
 
-    // 设置分配方案
+    // 设置分配方案 (只刷新变化的行)
     void SetAllocation(const QVector<double>& pi);
 
     // 添加联盟约束
-    void AddCoalitionCut(const QString& coalition, double cost, double violation);
+    void AddCoalitionCut(const Coalition& coalition, double cost, double violation);
+
+    // 批量添加联盟约束 (一次插入, 一次重绘)
+    void AddCoalitionCuts(const QVector<CutRow>& rows);
 
 private:
     void SetupUI();
 
     // 分配表格
-    QTableWidget* allocation_table_;
+    QTableView* allocation_table_;
+    AllocationTableModel* allocation_model_;
 
     // 联盟约束表格
-    QTableWidget* coalition_table_;
+    QTableView* coalition_table_;
+    CutTableModel* cut_model_;
+    QCheckBox* top_cuts_check_;
 
     // 数据
     int num_plants_;
@@ -0,0 +1,53 @@
+// solver_event.h - 求解器事件
+// 工作线程按批次投递给主窗口, 每个状态码行只对应一个事件
+
+#ifndef SOLVER_EVENT_H
+#define SOLVER_EVENT_H
+
+#include "coalition.h"
+#include "log_tag.h"
+
+#include <QMetaType>
+#include <QString>
+#include <QVector>
+
+// 事件类型
+enum class SolverEventType {
+    kLog,               // 仅日志
+    kDataLoaded,        // ints: P N G T
+    kGrandCoalition,    // values: cost runtime
+    kIterationStarted,  // ints[0]: 迭代号
+    kMPSolved,          // pi, values: v runtime (自上一个状态码到达起的秒数)
+    kSPResult,          // coalition, values: cost violation
+    kCutAdded,          // coalition, values[0]: cost
+    kConverged          // values[0]: eps
+};
+
+struct SolverEvent {
+    SolverEventType type = SolverEventType::kLog;
+    int ints[4] = {0, 0, 0, 0};
+    double values[2] = {0.0, 0.0};
+    Coalition coalition;
+    QVector<double> pi;
+
+    // 状态码行的到达时刻 (秒, 自进程启动起的单调时钟), 普通日志行为 0
+    double time = 0.0;
+
+    // 原始日志行 (为空表示不写日志) 及其类别
+    QString message;
+    LogTag log_tag = LogTag::kPlain;
+};
+
+// 求解结束原因 (成功为 kNone), 随 Finished 一起给出
+enum class FailureReason {
+    kNone,
+    kCancelled,       // 用户取消
+    kStartFailed,     // 无法启动 (含资源限制无法施加)
+    kCrashed,         // 被信号终止
+    kExitCode,        // 返回非零错误码
+    kMemoryLimit      // 超出任务的内存上限
+};
+
+Q_DECLARE_METATYPE(SolverEvent)
+
+#endif  // SOLVER_EVENT_H
@@ -0,0 +1,157 @@
+// solver_supervisor.cpp - 求解进程管理实现
+
+#include "solver_supervisor.h"
+#include "solver_worker.h"
+
+#include <QThread>
+#include <QTimer>
+
+namespace {
+
+// 默认资源采样周期 (毫秒)
+constexpr int kDefaultSampleIntervalMs = 1000;
+
+}  // namespace
+
+SolverSupervisor::SolverSupervisor(QObject* parent)
+    : QObject(parent)
+    , io_thread_(new QThread(this))
+    , io_root_(new QObject())
+    , sample_timer_(nullptr)
+    , sample_interval_ms_(kDefaultSampleIntervalMs)
+    , finished_runs_(0)
+    , next_run_id_(1) {
+    qRegisterMetaType<ResourceSample>();
+    qRegisterMetaType<ResourceUsage>();
+
+    io_thread_->setObjectName("SolverIO");
+    io_root_->moveToThread(io_thread_);
+    io_thread_->start();
+
+    // 采样定时器属于 I/O 线程, 只在有求解运行时走动
+    Post([this]() {
+        sample_timer_ = new QTimer(io_root_);
+        connect(sample_timer_, &QTimer::timeout, io_root_, [this]() { SampleResources(); });
+    });
+}
+
+SolverSupervisor::~SolverSupervisor() {
+    // 在 I/O 线程上析构全部 SolverWorker (结束进程), 再停止线程
+    QObject* root = io_root_;
+    QMetaObject::invokeMethod(root, [root]() { delete root; }, Qt::BlockingQueuedConnection);
+    io_thread_->quit();
+    io_thread_->wait();
+}
+
+void SolverSupervisor::Post(std::function<void()> task) {
+    QMetaObject::invokeMethod(io_root_, std::move(task), Qt::QueuedConnection);
+}
+
+int SolverSupervisor::Start(const QString& solver_path, const QString& data_file,
+                            const QVariantMap& params) {
+    const int run_id = next_run_id_++;
+    active_runs_.insert(run_id);
+
+    Post([this, run_id, solver_path, data_file, params]() {
+        SolverWorker* worker = new SolverWorker(io_root_);
+        workers_.insert(run_id, worker);
+
+        RusageStart start;
+        ChildRusage::Read(&start.rusage);
+        start.finished_runs = finished_runs_;
+        rusage_starts_.insert(run_id, start);
+        if (sample_interval_ms_ > 0 && !sample_timer_->isActive() && ResourceSampler::IsSupported()) {
+            sample_timer_->start(sample_interval_ms_);
+        }
+
+        // 接收方在主线程, 信号自动排队转发
+        connect(worker, &SolverWorker::EventsReady, this,
+                [this, run_id](const QVector<SolverEvent>& events) {
+            emit EventsReady(run_id, events);
+        });
+        // 完成后在 I/O 线程上取资源合计并回收, 再到主线程发出 Finished;
+        // 两者按顺序排队, 接收方先拿到合计
+        connect(worker, &SolverWorker::Finished, worker,
+                [this, run_id, worker](bool success, FailureReason reason, const QString& message,
+                                       double final_v, int iterations, double runtime) {
+            emit ResourceUsageReady(run_id, TakeUsage(run_id));
+            workers_.remove(run_id);
+            worker->deleteLater();
+            if (workers_.isEmpty()) {
+                sample_timer_->stop();
+            }
+
+            QMetaObject::invokeMethod(this,
+                [this, run_id, success, reason, message, final_v, iterations, runtime]() {
+                    active_runs_.remove(run_id);
+                    emit Finished(run_id, success, reason, message, final_v, iterations, runtime);
+                }, Qt::QueuedConnection);
+        });
+
+        worker->Run(solver_path, data_file, params);
+    });
+    return run_id;
+}
+
+void SolverSupervisor::Cancel(int run_id) {
+    Post([this, run_id]() {
+        if (SolverWorker* worker = workers_.value(run_id)) {
+            worker->RequestCancel();
+        }
+    });
+}
+
+void SolverSupervisor::CancelAll() {
+    Post([this]() {
+        for (SolverWorker* worker : std::as_const(workers_)) {
+            worker->RequestCancel();
+        }
+    });
+}
+
+void SolverSupervisor::SetSampleInterval(int interval_ms) {
+    Post([this, interval_ms]() {
+        sample_interval_ms_ = qMax(0, interval_ms);
+        if (sample_interval_ms_ == 0) {
+            sample_timer_->stop();
+        } else if (!workers_.isEmpty() && ResourceSampler::IsSupported()) {
+            sample_timer_->start(sample_interval_ms_);
+        }
+    });
+}
+
+void SolverSupervisor::SampleResources() {
+    for (auto it = workers_.cbegin(); it != workers_.cend(); ++it) {
+        // 进程启动前后进程号才有效, 进程号变化时重新开始累计
+        const qint64 pid = it.value()->ProcessId();
+        if (pid <= 0) continue;
+
+        ResourceSampler& sampler = samplers_[it.key()];
+        if (sampler.Pid() != pid) {
+            sampler.Start(pid);
+        }
+        ResourceSample sample;
+        if (sampler.Sample(it.value()->ElapsedSeconds(), &sample)) {
+            emit ResourceSampled(it.key(), sample);
+        }
+    }
+}
+
+ResourceUsage SolverSupervisor::TakeUsage(int run_id) {
+    ResourceUsage usage = samplers_.take(run_id).Usage();
+    const RusageStart start = rusage_starts_.take(run_id);
+
+    // getrusage 只统计已回收的子进程; 本运行期间没有别的运行结束时差值就是本运行的用量
+    ChildRusage now;
+    if (ChildRusage::Read(&now)) {
+        usage.has_rusage = true;
+        usage.rusage_exclusive = finished_runs_ == start.finished_runs;
+        usage.rusage_user_s = now.user_s - start.rusage.user_s;
+        usage.rusage_system_s = now.system_s - start.rusage.system_s;
+        usage.rusage_max_rss_kb = now.max_rss_kb;
+        usage.rusage_in_blocks = now.in_blocks - start.rusage.in_blocks;
+        usage.rusage_out_blocks = now.out_blocks - start.rusage.out_blocks;
+    }
+    ++finished_runs_;
+    return usage;
+}
@@ -0,0 +1,89 @@
+// solver_supervisor.h - 求解进程管理
+// 所有求解进程由同一个 I/O 线程上的事件循环驱动, 同时运行多个求解不需要额外线程
+
+#ifndef SOLVER_SUPERVISOR_H
+#define SOLVER_SUPERVISOR_H
+
+#include "solver_event.h"
+#include "resource_sampler.h"
+
+#include <QHash>
+#include <QObject>
+#include <QSet>
+#include <QVariantMap>
+#include <QVector>
+#include <functional>
+
+class QThread;
+class QTimer;
+class SolverWorker;
+
+class SolverSupervisor : public QObject {
+    Q_OBJECT
+
+public:
+    explicit SolverSupervisor(QObject* parent = nullptr);
+
+    // 结束所有进程并停止 I/O 线程
+    ~SolverSupervisor();
+
+    // 启动一次求解, 返回运行编号; 不等待进程启动
+    int Start(const QString& solver_path, const QString& data_file,
+              const QVariantMap& params);
+
+    // 取消一次求解 / 全部求解 (随后各自发出 Finished)
+    void Cancel(int run_id);
+    void CancelAll();
+
+    // 尚未结束的求解数
+    int ActiveCount() const { return static_cast<int>(active_runs_.size()); }
+    bool IsActive(int run_id) const { return active_runs_.contains(run_id); }
+
+    // 资源采样周期 (毫秒), 0 表示关闭; 平台不支持时不采样
+    void SetSampleInterval(int interval_ms);
+
+signals:
+    // 转发各次求解的事件和结果, 在主线程发出
+    void EventsReady(int run_id, QVector<SolverEvent> events);
+    void Finished(int run_id, bool success, FailureReason reason, QString message,
+                  double final_v, int iterations, double runtime);
+
+    // 求解进程树的资源采样; 运行的资源合计在该运行的 Finished 之前发出
+    void ResourceSampled(int run_id, ResourceSample sample);
+    void ResourceUsageReady(int run_id, ResourceUsage usage);
+
+private:
+    // 在 I/O 线程上执行
+    void Post(std::function<void()> task);
+
+    QThread* io_thread_;
+
+    // I/O 线程上的根对象, 各次求解的 SolverWorker 挂在其下
+    QObject* io_root_;
+
+    // 采样全部运行中的求解进程 (I/O 线程)
+    void SampleResources();
+
+    // 运行结束 (进程已回收) 时的资源合计, 并清除该运行的采样状态 (I/O 线程)
+    ResourceUsage TakeUsage(int run_id);
+
+    // 以下成员只在 I/O 线程上访问
+    QHash<int, SolverWorker*> workers_;
+    QHash<int, ResourceSampler> samplers_;
+    QTimer* sample_timer_;
+    int sample_interval_ms_;
+
+    // 各运行启动时的 getrusage 快照及当时已结束的运行数, 用于判断差值是否只含本运行
+    struct RusageStart {
+        ChildRusage rusage;
+        qint64 finished_runs = 0;
+    };
+    QHash<int, RusageStart> rusage_starts_;
+    qint64 finished_runs_;
+
+    // 以下成员只在主线程上访问
+    QSet<int> active_runs_;
+    int next_run_id_;
+};
+
+#endif  // SOLVER_SUPERVISOR_H
@@ -1,43 +1,136 @@
-// solver_worker.cpp - 求解器后台线程实现
+// solver_worker.cpp - 单次求解的进程驱动实现
 
 #include "solver_worker.h"
 
-#include <QRegularExpression>
 #include <QStringList>
+#include <QTimer>
 #include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// 批次大小阈值: 超过则放宽窗口, 低于则收紧窗口
+constexpr qsizetype kBusyBatchSize = 256;
+constexpr qsizetype kIdleBatchSize = 16;
+
+// 日志写线程积压时暂停读取输出, 每隔这段时间重试
+constexpr int kBacklogRetryMs = 20;
+
+// 状态码标签 -> 日志类别
+LogTag StatusLogTag(StatusTag tag) {
+    switch (tag) {
+    case StatusTag::kLoad: return LogTag::kLoad;
+    case StatusTag::kGrand: return LogTag::kGrand;
+    case StatusTag::kIter: return LogTag::kIter;
+    case StatusTag::kMP: return LogTag::kMP;
+    case StatusTag::kSP: return LogTag::kSP;
+    case StatusTag::kCut: return LogTag::kCut;
+    case StatusTag::kConverge: return LogTag::kConverge;
+    case StatusTag::kDone: return LogTag::kDone;
+    case StatusTag::kNone: break;
+    }
+    return LogTag::kPlain;
+}
+
+// 求解器 (或 CPLEX) 报告内存不足的输出行
+bool ReportsOutOfMemory(const QString& message) {
+    return message.contains("out of memory", Qt::CaseInsensitive)
+        || message.contains("bad_alloc")
+        || message.contains("CPLEX Error  1001");
+}
+
+// 纯 ASCII 的行用 Latin-1 直接展开, 其余按本地编码解码
+// (状态码行的 ']' 之后可能跟着本地编码的中文说明)
+QString DecodeLine(QByteArrayView line) {
+    const bool ascii = std::all_of(line.begin(), line.end(), [](char c) {
+        return static_cast<uchar>(c) < 0x80;
+    });
+    return ascii ? QString::fromLatin1(line) : QString::fromLocal8Bit(line);
+}
+
+}  // namespace
 
 SolverWorker::SolverWorker(QObject* parent)
     : QObject(parent)
     , process_(nullptr)
     , cancel_requested_(false)
+    , finished_(false)
+    , drain_scheduled_(false)
+    , iteration_offset_(0)
     , current_iteration_(0)
     , final_v_(0.0)
     , total_iterations_(0)
-    , total_runtime_(0.0) {
+    , total_runtime_(0.0)
+    , last_status_time_(0.0)
+    , flush_timer_(new QTimer(this))
+    , batch_interval_ms_(16)
+    , batch_min_ms_(16)
+    , batch_max_ms_(50) {
+    qRegisterMetaType<SolverEvent>();
+    qRegisterMetaType<QVector<SolverEvent>>();
+
+    // 输出间歇期积压的事件按批次窗口投递
+    connect(flush_timer_, &QTimer::timeout, this, [this]() {
+        if (batch_timer_.elapsed() >= batch_interval_ms_) {
+            FlushEvents();
+        }
+    });
 }
 
 SolverWorker::~SolverWorker() {
     if (process_) {
+        // 不再处理退出信号, 进程随 QProcess 一起回收
+        process_->disconnect(this);
         process_->kill();
-        process_->waitForFinished(1000);
     }
 }
 
 void SolverWorker::RequestCancel() {
     cancel_requested_ = true;
-    if (process_ && process_->state() == QProcess::Running) {
+    if (process_ && process_->state() != QProcess::NotRunning) {
         process_->kill();
     }
 }
 
+void SolverWorker::SetBatchInterval(int min_ms, int max_ms) {
+    batch_min_ms_ = qMax(1, min_ms);
+    batch_max_ms_ = qMax(batch_min_ms_, max_ms);
+    batch_interval_ms_ = qBound(batch_min_ms_, batch_interval_ms_, batch_max_ms_);
+}
+
+qint64 SolverWorker::ProcessId() const {
+    return (process_ && process_->state() == QProcess::Running) ? process_->processId() : 0;
+}
+
 void SolverWorker::Run(const QString& solver_path, const QString& data_file,
                         const QVariantMap& params) {
     cancel_requested_ = false;
+    finished_ = false;
+    // 从检查点续算时, 迭代号接着之前的编号
+    iteration_offset_ = params.value("iteration_offset", 0).toInt();
     current_iteration_ = 0;
     final_v_ = 0.0;
     total_iterations_ = 0;
     total_runtime_ = 0.0;
     current_pi_.clear();
+    last_status_time_ = 0.0;
+    stdout_buffer_.Clear();
+    parser_.Reset();
+    pending_events_.clear();
+    if (params.contains("batch_min_ms") && params.contains("batch_max_ms")) {
+        SetBatchInterval(params["batch_min_ms"].toInt(), params["batch_max_ms"].toInt());
+    }
+    batch_interval_ms_ = batch_min_ms_;
+    batch_timer_.start();
+
+    // 原始输出同步写入运行日志, 导出时不再依赖界面中的内容
+    if (params.contains("log_file")) {
+        const QString log_file = params["log_file"].toString();
+        if (!log_sink_.Open(log_file, params.value("log_compress").toBool())) {
+            PostLog(QString("[WARN] 无法创建运行日志 %1: %2")
+                .arg(log_file, log_sink_.ErrorString()));
+        }
+    }
 
     // 构建命令行参数
     QStringList args;
@@ -58,7 +151,9 @@ void SolverWorker::Run(const QString& solver_path, const QString& data_file,
 
     // 最大迭代次数
     if (params.contains("max_iterations")) {
-        args << "-m" << QString::number(params["max_iterations"].toInt());
+        // 续算时只给剩余的迭代次数
+        const int max_iterations = qMax(1, params["max_iterations"].toInt() - iteration_offset_);
+        args << "-m" << QString::number(max_iterations);
     }
 
     // MP 时限
@@ -106,6 +201,16 @@ void SolverWorker::Run(const QString& solver_path, const QString& data_file,
         args << "--sp-mode" << params["sp_strategy"].toString();
     }
 
+    // 初始约束 (约束池热启动)
+    if (params.contains("cuts_file")) {
+        args << "--cuts-file" << params["cuts_file"].toString();
+    }
+
+    // 结果输出目录 (每次运行单独一个; 界面确认求解器支持 --output-dir 时才给出)
+    if (params.contains("result_dir")) {
+        args << "--output-dir" << params["result_dir"].toString();
+    }
+
     // 创建进程
     process_ = new QProcess(this);
 
@@ -115,164 +220,257 @@ void SolverWorker::Run(const QString& solver_path, const QString& data_file,
             this, &SolverWorker::OnReadyReadStderr);
     connect(process_, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished),
             this, &SolverWorker::OnProcessFinished);
+    connect(process_, &QProcess::errorOccurred, this, &SolverWorker::OnProcessError);
+
+    // 强制执行任务分得的资源, 做不到的部分记入日志
+    const ProcessLimits limits = ProcessLimits::FromParams(params);
+    if (!limits.IsEmpty()) {
+        QString warning;
+        const QString applied = limiter_.Apply(limits, process_, &warning);
+        if (!applied.isEmpty()) {
+            PostLog("[GUI] 资源限制: " + applied);
+        }
+        if (!warning.isEmpty()) {
+            PostLog("[WARN] 资源限制: " + warning);
+        }
+    }
 
-    emit LogMessage(QString("[GUI] 启动求解器: %1").arg(solver_path));
-    emit LogMessage(QString("[GUI] 数据文件: %1").arg(data_file));
-    emit LogMessage(QString("[GUI] 命令行参数: %1").arg(args.join(" ")));
+    PostLog(QString("[GUI] 启动求解器: %1").arg(solver_path));
+    PostLog(QString("[GUI] 数据文件: %1").arg(data_file));
+    PostLog(QString("[GUI] 命令行参数: %1").arg(args.join(" ")));
 
-    // 启动进程
+    // 启动进程后立即返回, 启动失败由 errorOccurred 报告
+    run_clock_.start();
     process_->start(solver_path, args);
-
-    if (!process_->waitForStarted(5000)) {
-        emit LogMessage("[ERROR] 无法启动求解器进程");
-        emit Finished(false, "无法启动求解器进程", 0, 0, 0);
-        return;
+    if (!finished_) {
+        flush_timer_->start(batch_min_ms_);
     }
-
-    // 等待完成 (阻塞当前线程，但不阻塞GUI)
-    process_->waitForFinished(-1);
 }
 
 void SolverWorker::OnReadyReadStdout() {
-    while (process_->canReadLine()) {
-        QString line = QString::fromLocal8Bit(process_->readLine()).trimmed();
-        if (!line.isEmpty()) {
-            ParseLine(line);
+    DrainStdout(false);
+}
+
+void SolverWorker::DrainStdout(bool force) {
+    if (!process_) return;
+
+    // 按块排空管道, 行视图直接指向缓冲区, 下一次读取前处理完
+    // 日志写线程积压时暂停读取, 未读输出留在 QProcess 缓冲区和管道中, 共享的 I/O 线程不阻塞
+    while (force || !log_sink_.Backlogged()) {
+        if (stdout_buffer_.ReadFrom(process_) <= 0) {
+            return;
+        }
+        QByteArrayView line;
+        while (stdout_buffer_.NextLine(&line)) {
+            line = line.trimmed();
+            if (!line.isEmpty()) {
+                ParseLine(line);
+            }
         }
     }
+
+    if (!drain_scheduled_) {
+        drain_scheduled_ = true;
+        QTimer::singleShot(kBacklogRetryMs, this, [this]() {
+            drain_scheduled_ = false;
+            DrainStdout(false);
+        });
+    }
 }
 
 void SolverWorker::OnReadyReadStderr() {
     QString error = QString::fromLocal8Bit(process_->readAllStandardError()).trimmed();
     if (!error.isEmpty()) {
-        emit LogMessage("[STDERR] " + error);
+        if (ReportsOutOfMemory(error)) {
+            limiter_.NoteOutOfMemory();
+        }
+        PostLog("[STDERR] " + error);
     }
 }
 
 void SolverWorker::OnProcessFinished(int exit_code, QProcess::ExitStatus status) {
-    // 读取剩余输出
-    OnReadyReadStdout();
+    // 读取剩余输出 (包括末尾没有换行的行)
+    DrainStdout(true);
+    const QByteArrayView rest = stdout_buffer_.TakeRemainder().trimmed();
+    if (!rest.isEmpty()) {
+        ParseLine(rest);
+    }
 
+    if (parser_.MalformedLineCount() > 0) {
+        PostLog(QString("[WARN] 状态码字段格式错误 %1 行, 已忽略")
+            .arg(parser_.MalformedLineCount()));
+    }
+
+    const QString throttled = limiter_.Release();
+    if (!throttled.isEmpty()) {
+        PostLog("[INFO] " + throttled);
+    }
+
+    // 崩溃退出时 exit_code 为终止信号
     if (cancel_requested_) {
-        emit Finished(false, "用户取消", final_v_, total_iterations_, total_runtime_);
+        Finish(false, FailureReason::kCancelled, "用户取消");
+    } else if (exit_code == 0 && status == QProcess::NormalExit) {
+        Finish(true, FailureReason::kNone, "求解完成");
+    } else if (limiter_.MemoryExceeded()) {
+        Finish(false, FailureReason::kMemoryLimit,
+               QString("超出内存限制 (%1 MB)").arg(limiter_.MemoryLimitMb()));
     } else if (status == QProcess::CrashExit) {
-        emit Finished(false, "求解器崩溃", final_v_, total_iterations_, total_runtime_);
-    } else if (exit_code != 0) {
-        emit Finished(false, QString("求解器返回错误码 %1").arg(exit_code),
-                      final_v_, total_iterations_, total_runtime_);
+        Finish(false, FailureReason::kCrashed, QString("求解器崩溃 (信号 %1)").arg(exit_code));
     } else {
-        emit Finished(true, "求解完成", final_v_, total_iterations_, total_runtime_);
+        Finish(false, FailureReason::kExitCode, QString("求解器返回错误码 %1").arg(exit_code));
     }
 
     process_->deleteLater();
     process_ = nullptr;
 }
 
-void SolverWorker::ParseLine(const QString& line) {
-    // 尝试解析状态码
-    if (ParseStatusCode(line)) {
+void SolverWorker::OnProcessError(QProcess::ProcessError error) {
+    // 其余错误 (崩溃, 读写失败) 之后仍会收到 finished
+    if (error != QProcess::FailedToStart) {
         return;
     }
 
-    // 发送原始日志消息
-    emit LogMessage(line);
+    // 资源限制无法施加时同样在此报告 (errorString 带有原因)
+    limiter_.Release();
+    PostLog("[ERROR] 无法启动求解器进程: " + process_->errorString());
+    Finish(false, FailureReason::kStartFailed, "无法启动求解器进程: " + process_->errorString());
+    process_->deleteLater();
+    process_ = nullptr;
 }
 
-bool SolverWorker::ParseStatusCode(const QString& line) {
-    // [LOAD:OK:P:N:G:T] - 数据加载成功
-    QRegularExpression load_regex(R"(\[LOAD:OK:(\d+):(\d+):(\d+):(\d+)\])");
-    auto load_match = load_regex.match(line);
-    if (load_match.hasMatch()) {
-        int p = load_match.captured(1).toInt();
-        int n = load_match.captured(2).toInt();
-        int g = load_match.captured(3).toInt();
-        int t = load_match.captured(4).toInt();
-        emit DataLoaded(p, n, g, t);
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [GRAND:cost:time] - 大联盟成本
-    QRegularExpression grand_regex(R"(\[GRAND:([\d.]+):([\d.]+)\])");
-    auto grand_match = grand_regex.match(line);
-    if (grand_match.hasMatch()) {
-        double cost = grand_match.captured(1).toDouble();
-        double time = grand_match.captured(2).toDouble();
-        emit GrandCoalitionComputed(cost, time);
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [ITER:k:START] - 迭代开始
-    QRegularExpression iter_regex(R"(\[ITER:(\d+):START\])");
-    auto iter_match = iter_regex.match(line);
-    if (iter_match.hasMatch()) {
-        current_iteration_ = iter_match.captured(1).toInt();
-        emit IterationStarted(current_iteration_);
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [MP:pi0:pi1:...:v] - MP 结果
-    QRegularExpression mp_regex(R"(\[MP:([\d.:]+)\])");
-    auto mp_match = mp_regex.match(line);
-    if (mp_match.hasMatch()) {
-        QStringList parts = mp_match.captured(1).split(':');
-        if (parts.size() >= 2) {
-            current_pi_.clear();
-            for (int i = 0; i < parts.size() - 1; ++i) {
-                current_pi_.append(parts[i].toDouble());
-            }
-            double v = parts.last().toDouble();
-            emit MPSolved(current_pi_, v, 0.0);
+void SolverWorker::ParseLine(QByteArrayView line) {
+    // 状态码行与其日志合并为一个事件
+    log_sink_.Write(line);
+
+    SolverEvent event;
+    if (ParseStatusCode(line, &event)) {
+        event.message = DecodeLine(line);
+        event.log_tag = StatusLogTag(parser_.Record().tag);
+    } else {
+        event.type = SolverEventType::kLog;
+        event.message = DecodeLine(line);
+        event.log_tag = ClassifyLogLine(event.message);
+        if (limiter_.HasMemoryLimit() && ReportsOutOfMemory(event.message)) {
+            limiter_.NoteOutOfMemory();
         }
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [SP:coalition:cost:violation] - SP 结果
-    QRegularExpression sp_regex(R"(\[SP:(\{[^}]+\}):([\d.]+):([\d.-]+)\])");
-    auto sp_match = sp_regex.match(line);
-    if (sp_match.hasMatch()) {
-        QString coalition = sp_match.captured(1);
-        double cost = sp_match.captured(2).toDouble();
-        double violation = sp_match.captured(3).toDouble();
-        emit SPResult(coalition, cost, violation);
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [CUT:coalition:cost] - 添加约束
-    QRegularExpression cut_regex(R"(\[CUT:(\{[^}]+\}):([\d.]+)\])");
-    auto cut_match = cut_regex.match(line);
-    if (cut_match.hasMatch()) {
-        QString coalition = cut_match.captured(1);
-        double cost = cut_match.captured(2).toDouble();
-        emit CutAdded(coalition, cost);
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [CONVERGE:eps] - 收敛
-    QRegularExpression conv_regex(R"(\[CONVERGE:([\d.e+-]+)\])");
-    auto conv_match = conv_regex.match(line);
-    if (conv_match.hasMatch()) {
-        double eps = conv_match.captured(1).toDouble();
-        emit Converged(eps);
-        emit LogMessage(line);
-        return true;
-    }
-
-    // [DONE:status:v:iter:time] - 完成
-    QRegularExpression done_regex(R"(\[DONE:(\w+):([\d.-]+):(\d+):([\d.]+)\])");
-    auto done_match = done_regex.match(line);
-    if (done_match.hasMatch()) {
-        final_v_ = done_match.captured(2).toDouble();
-        total_iterations_ = done_match.captured(3).toInt();
-        total_runtime_ = done_match.captured(4).toDouble();
-        emit LogMessage(line);
-        return true;
-    }
-
-    return false;
+    }
+    PostEvent(std::move(event));
+}
+
+bool SolverWorker::ParseStatusCode(QByteArrayView line, SolverEvent* event) {
+    if (!parser_.Parse(line)) {
+        return false;
+    }
+
+    // SP/CUT 的联盟成员编号超出上限 (输出损坏) 时整行按普通日志处理
+    const StatusRecord& rec = parser_.Record();
+    Coalition coalition;
+    if (rec.tag == StatusTag::kSP || rec.tag == StatusTag::kCut) {
+        coalition = Coalition::Parse(rec.text);
+        if (coalition.IsEmpty()) {
+            return false;
+        }
+    }
+
+    // 到达时刻以读到该行为准; 与上一个状态码的间隔即该阶段用时
+    event->time = run_clock_.nsecsElapsed() / 1e9;
+    const double since_last = event->time - last_status_time_;
+    last_status_time_ = event->time;
+
+    switch (rec.tag) {
+    case StatusTag::kLoad:
+        event->type = SolverEventType::kDataLoaded;
+        std::copy(rec.ints, rec.ints + 4, event->ints);
+        break;
+    case StatusTag::kGrand:
+        event->type = SolverEventType::kGrandCoalition;
+        event->values[0] = rec.values[0];
+        event->values[1] = rec.values[1];
+        break;
+    case StatusTag::kIter:
+        current_iteration_ = rec.ints[0] + iteration_offset_;
+        event->type = SolverEventType::kIterationStarted;
+        event->ints[0] = current_iteration_;
+        break;
+    case StatusTag::kMP:
+        // 解析缓冲区跨行复用, 只为投递的事件复制一份
+        current_pi_ = QVector<double>(rec.pi.cbegin(), rec.pi.cend());
+        event->type = SolverEventType::kMPSolved;
+        event->pi = current_pi_;
+        event->values[0] = rec.values[0];
+        event->values[1] = since_last;
+        break;
+    case StatusTag::kSP:
+        event->type = SolverEventType::kSPResult;
+        event->coalition = coalition;
+        event->values[0] = rec.values[0];
+        event->values[1] = rec.values[1];
+        break;
+    case StatusTag::kCut:
+        event->type = SolverEventType::kCutAdded;
+        event->coalition = coalition;
+        event->values[0] = rec.values[0];
+        break;
+    case StatusTag::kConverge:
+        event->type = SolverEventType::kConverged;
+        event->values[0] = rec.values[0];
+        break;
+    case StatusTag::kDone:
+        final_v_ = rec.values[0];
+        total_iterations_ = rec.ints[0] + iteration_offset_;
+        total_runtime_ = rec.values[1];
+        event->type = SolverEventType::kLog;
+        break;
+    case StatusTag::kNone:
+        return false;
+    }
+    return true;
+}
+
+void SolverWorker::PostEvent(SolverEvent&& event) {
+    pending_events_.append(std::move(event));
+    if (batch_timer_.elapsed() >= batch_interval_ms_) {
+        FlushEvents();
+    }
+}
+
+void SolverWorker::PostLog(const QString& message) {
+    log_sink_.Write(message.toLocal8Bit());
+
+    SolverEvent event;
+    event.message = message;
+    event.log_tag = ClassifyLogLine(message);
+    PostEvent(std::move(event));
+}
+
+void SolverWorker::FlushEvents() {
+    batch_timer_.restart();
+    if (pending_events_.isEmpty()) {
+        return;
+    }
+
+    const qsizetype count = pending_events_.size();
+    QVector<SolverEvent> batch;
+    batch.swap(pending_events_);
+    pending_events_.reserve(count);
+    emit EventsReady(batch);
+
+    // 负载高时放宽窗口减少跨线程投递, 负载低时收紧窗口降低延迟
+    if (count >= kBusyBatchSize) {
+        batch_interval_ms_ = qMin(batch_max_ms_, batch_interval_ms_ * 3 / 2 + 1);
+    } else if (count <= kIdleBatchSize) {
+        batch_interval_ms_ = qMax(batch_min_ms_, batch_interval_ms_ * 3 / 4);
+    }
+}
+
+void SolverWorker::Finish(bool success, FailureReason reason, const QString& message) {
+    if (finished_) return;
+    finished_ = true;
+    flush_timer_->stop();
+
+    // 日志先落盘, 收到完成信号后即可导出; 写线程收尾期间不占用共享的 I/O 线程
+    log_sink_.CloseAsync(this, [this, success, reason, message]() {
+        FlushEvents();
+        emit Finished(success, reason, message, final_v_, total_iterations_, total_runtime_);
+    });
 }
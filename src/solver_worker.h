@@ -1,13 +1,22 @@
-// solver_worker.h - 求解器后台线程
+// solver_worker.h - 单次求解的进程驱动
+// 完全由 QProcess 信号和定时器驱动, 不阻塞所在线程; 由 SolverSupervisor 在 I/O 线程上创建
 
 #ifndef SOLVER_WORKER_H
 #define SOLVER_WORKER_H
 
+#include "line_buffer.h"
+#include "log_sink.h"
+#include "process_limits.h"
+#include "solver_event.h"
+#include "status_parser.h"
+
 #include <QObject>
 #include <QProcess>
 #include <QVariantMap>
 #include <QVector>
-#include <atomic>
+#include <QElapsedTimer>
+
+class QTimer;
 
 class SolverWorker : public QObject {
     Q_OBJECT
@@ -16,64 +25,87 @@ public:
     explicit SolverWorker(QObject* parent = nullptr);
     ~SolverWorker();
 
-    // 请求取消
+    // 请求取消 (结束进程, 随后发出 Finished)
     void RequestCancel();
 
+    // 事件批次窗口 (毫秒), 实际周期在 [min_ms, max_ms] 内随负载调整
+    void SetBatchInterval(int min_ms, int max_ms);
+
+    // 求解器进程号 (未启动或已退出时为 0) 及自进程启动以来的秒数, 供资源采样
+    qint64 ProcessId() const;
+    double ElapsedSeconds() const { return run_clock_.isValid() ? run_clock_.nsecsElapsed() / 1e9 : 0.0; }
+
 public slots:
-    // 运行求解器
+    // 启动求解器后立即返回
     void Run(const QString& solver_path, const QString& data_file,
              const QVariantMap& params);
 
 signals:
-    // 数据加载完成
-    void DataLoaded(int plants, int items, int families, int periods);
-
-    // 大联盟成本计算完成
-    void GrandCoalitionComputed(double cost, double runtime);
-
-    // 迭代开始
-    void IterationStarted(int iteration);
-
-    // MP 求解完成
-    void MPSolved(QVector<double> pi, double v, double runtime);
-
-    // SP 结果
-    void SPResult(QString coalition, double cost, double violation);
-
-    // 算法收敛
-    void Converged(double epsilon);
+    // 一批求解器事件 (数据加载, 迭代进度, MP/SP 结果, 日志等), 按到达顺序排列
+    void EventsReady(QVector<SolverEvent> events);
 
-    // 添加了新的联盟约束
-    void CutAdded(QString coalition, double cost);
-
-    // 求解完成
-    void Finished(bool success, QString message,
+    // 求解完成 (之前的事件已全部投递); 失败时 reason 区分取消, 崩溃和超出资源限制
+    void Finished(bool success, FailureReason reason, QString message,
                   double final_v, int iterations, double runtime);
 
-    // 日志消息
-    void LogMessage(QString message);
-
 private slots:
     void OnReadyReadStdout();
     void OnReadyReadStderr();
     void OnProcessFinished(int exit_code, QProcess::ExitStatus status);
+    void OnProcessError(QProcess::ProcessError error);
 
 private:
+    // 读取并解析标准输出; force 时忽略日志积压, 读到管道为空
+    void DrainStdout(bool force);
+
     // 解析输出行
-    void ParseLine(const QString& line);
+    void ParseLine(QByteArrayView line);
+
+    // 解析状态码并填写事件, 非状态码行返回 false
+    bool ParseStatusCode(QByteArrayView line, SolverEvent* event);
+
+    // 事件入队, 超过批次窗口时投递
+    void PostEvent(SolverEvent&& event);
+    void PostLog(const QString& message);
 
-    // 解析状态码
-    bool ParseStatusCode(const QString& line);
+    // 投递积压事件, 并按批次大小调整窗口
+    void FlushEvents();
+
+    // 日志写完后投递剩余事件并发出完成信号
+    void Finish(bool success, FailureReason reason, const QString& message);
 
     QProcess* process_;
-    std::atomic<bool> cancel_requested_;
+    bool cancel_requested_;
+    bool finished_;
+    bool drain_scheduled_;  // 已安排积压后的重试读取
+    LineBuffer stdout_buffer_;
+    StatusParser parser_;
+
+    // 本次运行的日志文件 (参数 log_file 指定时启用)
+    LogSink log_sink_;
 
-    // 解析状态
+    // 任务分得的内存/CPU 的强制执行 (参数 limit_* 指定时启用)
+    ProcessLimiter limiter_;
+
+    // 解析状态 (迭代号已加上续算偏移)
+    int iteration_offset_;
     int current_iteration_;
     double final_v_;
     int total_iterations_;
     double total_runtime_;
     QVector<double> current_pi_;
+
+    // 状态码到达计时 (单调时钟, 进程启动时开始)
+    QElapsedTimer run_clock_;
+    double last_status_time_;
+
+    // 事件批次
+    QVector<SolverEvent> pending_events_;
+    QElapsedTimer batch_timer_;
+    QTimer* flush_timer_;
+    int batch_interval_ms_;
+    int batch_min_ms_;
+    int batch_max_ms_;
 };
 
 #endif  // SOLVER_WORKER_H
@@ -0,0 +1,195 @@
+// status_parser.cpp - 求解器状态码解析实现
+
+#include "status_parser.h"
+#include "field_parser.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// 按 ':' 拆分字段; 字段数超过 max_fields 时返回 -1
+int SplitFields(QByteArrayView payload, QByteArrayView* fields, int max_fields) {
+    int count = 0;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i <= payload.size(); ++i) {
+        if (i == payload.size() || payload[i] == ':') {
+            if (count == max_fields) {
+                return -1;
+            }
+            fields[count++] = payload.sliced(start, i - start);
+            start = i + 1;
+        }
+    }
+    return count;
+}
+
+// 联盟字段形如 "{0,1,2}"
+bool IsCoalition(QByteArrayView field) {
+    return field.size() >= 3 && field.front() == '{' && field.back() == '}';
+}
+
+}  // namespace
+
+void StatusParser::Reset() {
+    record_.tag = StatusTag::kNone;
+    malformed_lines_ = 0;
+}
+
+bool StatusParser::Malformed() {
+    ++malformed_lines_;
+    return false;
+}
+
+bool StatusParser::ToInt(QByteArrayView field, int* out) {
+    return ParseIntField(field, out) || Malformed();
+}
+
+bool StatusParser::ToDouble(QByteArrayView field, double* out) {
+    return ParseDoubleField(field, out) || Malformed();
+}
+
+bool StatusParser::Parse(QByteArrayView line) {
+    record_.tag = StatusTag::kNone;
+
+    // 与原先的正则一致, 标签可出现在行内任意位置 (时间戳前缀, 缩进, 回车进度等);
+    // 依次尝试每个 '[', 不含 '[' 的普通日志行只扫描一遍
+    for (qsizetype open = line.indexOf('['); open >= 0; open = line.indexOf('[', open + 1)) {
+        const qsizetype close = line.indexOf(']', open + 1);
+        if (close < 0) {
+            return false;
+        }
+        bool known = false;
+        const bool parsed = ParseBody(line.sliced(open + 1, close - open - 1), &known);
+        if (known) {
+            return parsed;
+        }
+    }
+    return false;
+}
+
+bool StatusParser::ParseBody(QByteArrayView body, bool* known) {
+    if (body.isEmpty()) {
+        return false;
+    }
+
+    // 按标签首字母分派, 只比较一次前缀
+    *known = true;
+    switch (body[0]) {
+    case 'L':
+        if (body.startsWith("LOAD:")) return ParseLoad(body.sliced(5));
+        break;
+    case 'G':
+        if (body.startsWith("GRAND:")) return ParseGrand(body.sliced(6));
+        break;
+    case 'I':
+        if (body.startsWith("ITER:")) return ParseIter(body.sliced(5));
+        break;
+    case 'M':
+        if (body.startsWith("MP:")) return ParseMP(body.sliced(3));
+        break;
+    case 'S':
+        if (body.startsWith("SP:")) return ParseSP(body.sliced(3));
+        break;
+    case 'C':
+        if (body.startsWith("CUT:")) return ParseCut(body.sliced(4));
+        if (body.startsWith("CONVERGE:")) return ParseConverge(body.sliced(9));
+        break;
+    case 'D':
+        if (body.startsWith("DONE:")) return ParseDone(body.sliced(5));
+        break;
+    default:
+        break;
+    }
+    *known = false;
+    return false;
+}
+
+// OK:P:N:G:T
+bool StatusParser::ParseLoad(QByteArrayView payload) {
+    QByteArrayView f[5];
+    if (SplitFields(payload, f, 5) != 5 || f[0] != "OK") return Malformed();
+    for (int i = 0; i < 4; ++i) {
+        if (!ToInt(f[i + 1], &record_.ints[i])) return false;
+    }
+    record_.tag = StatusTag::kLoad;
+    return true;
+}
+
+// cost:time
+bool StatusParser::ParseGrand(QByteArrayView payload) {
+    QByteArrayView f[2];
+    if (SplitFields(payload, f, 2) != 2) return Malformed();
+    if (!ToDouble(f[0], &record_.values[0]) || !ToDouble(f[1], &record_.values[1])) {
+        return false;
+    }
+    record_.tag = StatusTag::kGrand;
+    return true;
+}
+
+// k:START
+bool StatusParser::ParseIter(QByteArrayView payload) {
+    QByteArrayView f[2];
+    if (SplitFields(payload, f, 2) != 2 || f[1] != "START") return Malformed();
+    if (!ToInt(f[0], &record_.ints[0])) return false;
+    record_.tag = StatusTag::kIter;
+    return true;
+}
+
+// pi0:pi1:...:v
+// 任一分量格式错误或为 NaN 时整行作废 (计一次), 不把残缺的分配交给界面和检查点
+bool StatusParser::ParseMP(QByteArrayView payload) {
+    QVector<double>& pi = scratch_pi_;
+    if (ParseDoubleList(payload, ':', &pi) > 0 || pi.size() < 2) return Malformed();
+    if (std::any_of(pi.cbegin(), pi.cend(), [](double value) { return std::isnan(value); })) {
+        return Malformed();
+    }
+
+    record_.values[0] = pi.last();
+    pi.resize(pi.size() - 1);
+    record_.pi.swap(pi);
+    record_.tag = StatusTag::kMP;
+    return true;
+}
+
+// coalition:cost:violation
+bool StatusParser::ParseSP(QByteArrayView payload) {
+    QByteArrayView f[3];
+    if (SplitFields(payload, f, 3) != 3 || !IsCoalition(f[0])) return Malformed();
+    if (!ToDouble(f[1], &record_.values[0]) || !ToDouble(f[2], &record_.values[1])) {
+        return false;
+    }
+    record_.text = f[0];
+    record_.tag = StatusTag::kSP;
+    return true;
+}
+
+// coalition:cost
+bool StatusParser::ParseCut(QByteArrayView payload) {
+    QByteArrayView f[2];
+    if (SplitFields(payload, f, 2) != 2 || !IsCoalition(f[0])) return Malformed();
+    if (!ToDouble(f[1], &record_.values[0])) return false;
+    record_.text = f[0];
+    record_.tag = StatusTag::kCut;
+    return true;
+}
+
+// eps
+bool StatusParser::ParseConverge(QByteArrayView payload) {
+    if (!ToDouble(payload, &record_.values[0])) return false;
+    record_.tag = StatusTag::kConverge;
+    return true;
+}
+
+// status:v:iter:time
+bool StatusParser::ParseDone(QByteArrayView payload) {
+    QByteArrayView f[4];
+    if (SplitFields(payload, f, 4) != 4 || f[0].isEmpty()) return Malformed();
+    if (!ToDouble(f[1], &record_.values[0]) || !ToInt(f[2], &record_.ints[0])
+        || !ToDouble(f[3], &record_.values[1])) {
+        return false;
+    }
+    record_.text = f[0];
+    record_.tag = StatusTag::kDone;
+    return true;
+}
@@ -0,0 +1,82 @@
+// status_parser.h - 求解器状态码解析
+// 在行内查找 '[' 开头的标签, 读取一次标签前缀后只解析该标签的字段
+
+#ifndef STATUS_PARSER_H
+#define STATUS_PARSER_H
+
+#include <QByteArrayView>
+#include <QVector>
+
+// 状态码标签
+enum class StatusTag {
+    kNone,
+    kLoad,      // [LOAD:OK:P:N:G:T]
+    kGrand,     // [GRAND:cost:time]
+    kIter,      // [ITER:k:START]
+    kMP,        // [MP:pi0:pi1:...:v]
+    kSP,        // [SP:coalition:cost:violation]
+    kCut,       // [CUT:coalition:cost]
+    kConverge,  // [CONVERGE:eps]
+    kDone       // [DONE:status:v:iter:time]
+};
+
+// 单行解析结果, 各标签只填写自己用到的字段
+struct StatusRecord {
+    StatusTag tag = StatusTag::kNone;
+
+    // LOAD: P N G T; ITER: k; DONE: iter
+    int ints[4] = {0, 0, 0, 0};
+
+    // GRAND: cost time; SP: cost violation; CUT: cost;
+    // CONVERGE: eps; MP: v; DONE: v time
+    double values[2] = {0.0, 0.0};
+
+    // SP/CUT 联盟 "{0,1,2}", DONE 状态字; 指向原始行, 仅在该行有效期内可用
+    QByteArrayView text;
+
+    // MP 分配向量 (跨行复用, 只在整行有效时更新)
+    QVector<double> pi;
+};
+
+class StatusParser {
+public:
+    // 解析一行 (已去除首尾空白), 标签可在行内任意位置; 非状态码行返回 false
+    bool Parse(QByteArrayView line);
+
+    // 最近一次成功解析的结果
+    const StatusRecord& Record() const { return record_; }
+
+    // 带标签但字段格式错误的累计行数 (每行至多计一次)
+    int MalformedLineCount() const { return malformed_lines_; }
+
+    // 新一轮求解前清零计数
+    void Reset();
+
+private:
+    // 解析方括号内的内容; 是已知标签时置 known (字段格式错误也算)
+    bool ParseBody(QByteArrayView body, bool* known);
+
+    // 字段解析, 失败时计入格式错误
+    bool ToInt(QByteArrayView field, int* out);
+    bool ToDouble(QByteArrayView field, double* out);
+
+    // 字段数, 结构或取值不符, 该行计一次格式错误
+    bool Malformed();
+
+    bool ParseLoad(QByteArrayView payload);
+    bool ParseGrand(QByteArrayView payload);
+    bool ParseIter(QByteArrayView payload);
+    bool ParseMP(QByteArrayView payload);
+    bool ParseSP(QByteArrayView payload);
+    bool ParseCut(QByteArrayView payload);
+    bool ParseConverge(QByteArrayView payload);
+    bool ParseDone(QByteArrayView payload);
+
+    StatusRecord record_;
+    int malformed_lines_ = 0;
+
+    // MP 向量先解析到这里, 整行有效后再与 record_.pi 交换 (两者容量都跨行复用)
+    QVector<double> scratch_pi_;
+};
+
+#endif  // STATUS_PARSER_H
@@ -0,0 +1,195 @@
+// sweep_design.cpp - 参数扫描设计实现
+
+#include "sweep_design.h"
+
+#include <QRandomGenerator>
+#include <QSet>
+#include <QStringList>
+
+#include <cmath>
+
+namespace {
+
+// 等距展开的最多取值数
+constexpr int kMaxAxisValues = 1000;
+
+// 随机抽样重复时的最多尝试倍数
+constexpr int kRandomAttemptFactor = 20;
+
+// 区间跨度超过此倍数时按对数均匀抽样 (如收敛精度)
+constexpr double kLogScaleRatio = 100.0;
+
+bool IsIntegerType(const QVariant& value) {
+    const int type = value.typeId();
+    return type == QMetaType::Int || type == QMetaType::LongLong || type == QMetaType::UInt;
+}
+
+bool IsNumberType(const QVariant& value) {
+    return IsIntegerType(value) || value.typeId() == QMetaType::Double;
+}
+
+QVariant NumberValue(double value, bool integer) {
+    return integer ? QVariant(static_cast<int>(std::lround(value))) : QVariant(value);
+}
+
+double SampleAxis(const SweepAxis& axis, QRandomGenerator* rng) {
+    if (axis.lo > 0.0 && axis.hi / axis.lo >= kLogScaleRatio) {
+        const double log_lo = std::log(axis.lo);
+        const double log_hi = std::log(axis.hi);
+        return std::exp(log_lo + rng->generateDouble() * (log_hi - log_lo));
+    }
+    if (axis.integer) {
+        const qint64 lo = std::llround(axis.lo);
+        const qint64 hi = std::llround(axis.hi);
+        return static_cast<double>(rng->bounded(lo, hi + 1));
+    }
+    return axis.lo + rng->generateDouble() * (axis.hi - axis.lo);
+}
+
+// 组合的去重键
+QString ComboKey(const QVariantMap& combo) {
+    QStringList parts;
+    for (auto it = combo.cbegin(); it != combo.cend(); ++it) {
+        parts << it.key() + "=" + it.value().toString();
+    }
+    return parts.join(';');
+}
+
+}  // namespace
+
+bool SweepAxis::Parse(const QString& key, const QString& spec, const QVariant& default_value,
+                      SweepAxis* axis, QString* error) {
+    *axis = SweepAxis();
+    axis->key = key;
+    axis->integer = IsIntegerType(default_value);
+
+    const QString text = spec.trimmed();
+    if (text.isEmpty()) {
+        *error = QString("%1: 取值为空").arg(key);
+        return false;
+    }
+
+    // 字符串参数只能列举
+    if (!IsNumberType(default_value)) {
+        for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+            const QString value = part.trimmed();
+            if (!value.isEmpty() && !axis->values.contains(value)) {
+                axis->values << value;
+            }
+        }
+        return !axis->values.isEmpty();
+    }
+
+    // 区间 lo:hi[:step]
+    if (text.contains(':')) {
+        const QStringList parts = text.split(':');
+        bool ok_lo = false;
+        bool ok_hi = false;
+        const double lo = parts.value(0).trimmed().toDouble(&ok_lo);
+        const double hi = parts.value(1).trimmed().toDouble(&ok_hi);
+        if (parts.size() > 3 || !ok_lo || !ok_hi || hi < lo) {
+            *error = QString("%1: 区间格式应为 lo:hi 或 lo:hi:step").arg(key);
+            return false;
+        }
+        if (parts.size() == 2) {
+            axis->continuous = true;
+            axis->lo = lo;
+            axis->hi = hi;
+            return true;
+        }
+
+        bool ok_step = false;
+        const double step = parts[2].trimmed().toDouble(&ok_step);
+        if (!ok_step || step <= 0.0) {
+            *error = QString("%1: 步长必须为正数").arg(key);
+            return false;
+        }
+        const qint64 count = static_cast<qint64>(std::floor((hi - lo) / step + 1e-9)) + 1;
+        if (count > kMaxAxisValues) {
+            *error = QString("%1: 取值超过 %2 个").arg(key).arg(kMaxAxisValues);
+            return false;
+        }
+        for (qint64 i = 0; i < count; ++i) {
+            const QVariant value = NumberValue(lo + i * step, axis->integer);
+            if (!axis->values.contains(value)) {
+                axis->values << value;
+            }
+        }
+        return true;
+    }
+
+    // 列举
+    for (const QString& part : text.split(',', Qt::SkipEmptyParts)) {
+        bool ok = false;
+        const double number = part.trimmed().toDouble(&ok);
+        if (!ok) {
+            *error = QString("%1: 无法解析 \"%2\"").arg(key, part.trimmed());
+            return false;
+        }
+        const QVariant value = NumberValue(number, axis->integer);
+        if (!axis->values.contains(value)) {
+            axis->values << value;
+        }
+    }
+    return !axis->values.isEmpty();
+}
+
+qint64 SweepDesign::GridSize(const QVector<SweepAxis>& axes) {
+    qint64 size = 1;
+    for (const SweepAxis& axis : axes) {
+        if (axis.continuous) return -1;
+        // 超过上限后饱和: size 不超过 kMaxRuns + 1, 再乘单轴取值数也不会溢出
+        size = qMin<qint64>(size * axis.values.size(), kMaxRuns + 1);
+    }
+    return size;
+}
+
+QVector<QVariantMap> SweepDesign::Grid(const QVector<SweepAxis>& axes) {
+    QVector<QVariantMap> combos;
+    const qint64 size = GridSize(axes);
+    if (size <= 0 || size > kMaxRuns) return combos;
+    combos.reserve(size);
+
+    // 按混合进制计数, 最后一个参数变化最快
+    QVector<int> digits(axes.size(), 0);
+    for (qint64 n = 0; n < size; ++n) {
+        QVariantMap combo;
+        for (int a = 0; a < axes.size(); ++a) {
+            combo.insert(axes[a].key, axes[a].values[digits[a]]);
+        }
+        combos.append(combo);
+
+        for (int a = static_cast<int>(axes.size()) - 1; a >= 0; --a) {
+            if (++digits[a] < axes[a].values.size()) break;
+            digits[a] = 0;
+        }
+    }
+    return combos;
+}
+
+QVector<QVariantMap> SweepDesign::Random(const QVector<SweepAxis>& axes, int count, quint32 seed) {
+    const qint64 grid_size = GridSize(axes);
+    if (grid_size >= 0 && grid_size <= count) {
+        return Grid(axes);
+    }
+
+    QRandomGenerator rng(seed);
+    QVector<QVariantMap> combos;
+    QSet<QString> seen;
+    for (int attempt = 0; combos.size() < count && attempt < count * kRandomAttemptFactor; ++attempt) {
+        QVariantMap combo;
+        for (const SweepAxis& axis : axes) {
+            if (axis.continuous) {
+                combo.insert(axis.key, NumberValue(SampleAxis(axis, &rng), axis.integer));
+            } else {
+                combo.insert(axis.key, axis.values[rng.bounded(static_cast<int>(axis.values.size()))]);
+            }
+        }
+        const QString key = ComboKey(combo);
+        if (!seen.contains(key)) {
+            seen.insert(key);
+            combos.append(combo);
+        }
+    }
+    return combos;
+}
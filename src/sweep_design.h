@@ -0,0 +1,47 @@
+// sweep_design.h - 参数扫描设计
+// 把每个参数的取值说明展开为一组参数组合 (全网格或随机抽样)
+
+#ifndef SWEEP_DESIGN_H
+#define SWEEP_DESIGN_H
+
+#include <QString>
+#include <QVariant>
+#include <QVariantMap>
+#include <QVector>
+
+// 单个参数的取值
+// 取值说明: "a, b, c" 列举; "lo:hi:step" 等距展开; "lo:hi" 为连续区间 (仅随机抽样)
+struct SweepAxis {
+    QString key;
+    QVariantList values;       // 离散取值
+    bool continuous = false;   // 连续区间 [lo, hi]
+    double lo = 0.0;
+    double hi = 0.0;
+    bool integer = false;      // 连续区间按整数抽样
+
+    // 按默认值的类型解析取值说明, 失败时写入 error
+    static bool Parse(const QString& key, const QString& spec, const QVariant& default_value,
+                      SweepAxis* axis, QString* error);
+};
+
+enum class SweepMode {
+    kGrid,
+    kRandom
+};
+
+class SweepDesign {
+public:
+    // 单轮扫描最多组合数
+    static constexpr int kMaxRuns = 1000;
+
+    // 全网格组合数, 含连续区间时返回 -1; 超过 kMaxRuns 时返回 kMaxRuns + 1 (不会溢出)
+    static qint64 GridSize(const QVector<SweepAxis>& axes);
+
+    // 全网格: 每个组合只含被扫描的参数; 组合数超过 kMaxRuns 时返回空
+    static QVector<QVariantMap> Grid(const QVector<SweepAxis>& axes);
+
+    // 随机抽样 count 个互不相同的组合 (离散空间不足时取全部)
+    static QVector<QVariantMap> Random(const QVector<SweepAxis>& axes, int count, quint32 seed);
+};
+
+#endif  // SWEEP_DESIGN_H
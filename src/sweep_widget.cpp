@@ -0,0 +1,477 @@
+// sweep_widget.cpp - 参数扫描 Tab 实现
+
+#include "sweep_widget.h"
+#include "update_scheduler.h"
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QGroupBox>
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QComboBox>
+#include <QSpinBox>
+#include <QPushButton>
+#include <QLabel>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QFile>
+#include <QTextStream>
+#include <QDir>
+#include <QFont>
+#include <QColor>
+
+namespace {
+
+// 结果表每秒最多刷新次数
+constexpr int kSweepViewMaxFps = 10;
+
+// 随机设计默认样本数
+constexpr int kDefaultSamples = 20;
+
+enum AxisColumn {
+    kAxisEnabled,
+    kAxisKey,
+    kAxisCurrent,
+    kAxisValues,
+    kAxisColumnCount
+};
+
+// 结果表固定列 (参数列之后)
+const QStringList kResultColumns = {"状态", "迭代", "线程", "求解时间 (s)", "墙钟时间 (s)", "v*"};
+
+const QColor kBestBackground("#E8F5E9");
+
+QString StateText(JobState state) {
+    switch (state) {
+    case JobState::kQueued: return "排队";
+    case JobState::kRunning: return "运行中";
+    case JobState::kSucceeded: return "完成";
+    case JobState::kFailed: return "失败";
+    case JobState::kCancelled: return "已取消";
+    }
+    return QString();
+}
+
+QString ValueText(const QVariant& value) {
+    if (value.typeId() == QMetaType::Double) {
+        return QString::number(value.toDouble(), 'g', 6);
+    }
+    return value.toString();
+}
+
+}  // namespace
+
+SweepWidget::SweepWidget(JobQueue* queue, QWidget* parent)
+    : QWidget(parent)
+    , queue_(queue)
+    , best_run_(-1)
+    , refresh_scheduler_(new UpdateScheduler(kSweepViewMaxFps, this)) {
+    SetupUI();
+
+    connect(queue_, &JobQueue::JobChanged, this, &SweepWidget::OnJobChanged);
+    connect(queue_, &JobQueue::JobFinished, this, &SweepWidget::OnJobChanged);
+    connect(refresh_scheduler_, &UpdateScheduler::UpdateDue, this, &SweepWidget::RefreshRows);
+}
+
+void SweepWidget::SetupUI() {
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setSpacing(8);
+
+    // 扫描设置
+    QGroupBox* design_group = new QGroupBox("扫描设置");
+    QVBoxLayout* design_layout = new QVBoxLayout(design_group);
+
+    QHBoxLayout* file_row = new QHBoxLayout();
+    file_row->addWidget(new QLabel("数据文件"));
+    file_edit_ = new QLineEdit();
+    file_row->addWidget(file_edit_, 1);
+    browse_button_ = new QPushButton("浏览...");
+    file_row->addWidget(browse_button_);
+    design_layout->addLayout(file_row);
+
+    axis_table_ = new QTableWidget(0, kAxisColumnCount);
+    axis_table_->setHorizontalHeaderLabels({"扫描", "参数", "当前值", "取值"});
+    axis_table_->horizontalHeader()->setStretchLastSection(true);
+    axis_table_->verticalHeader()->setVisible(false);
+    axis_table_->setColumnWidth(kAxisEnabled, 50);
+    axis_table_->setColumnWidth(kAxisKey, 160);
+    axis_table_->setColumnWidth(kAxisCurrent, 100);
+    axis_table_->setToolTip("取值: \"a, b, c\" 列举; \"lo:hi:step\" 等距; \"lo:hi\" 连续区间 (仅随机设计)");
+    design_layout->addWidget(axis_table_);
+
+    QHBoxLayout* mode_row = new QHBoxLayout();
+    mode_row->addWidget(new QLabel("设计"));
+    mode_combo_ = new QComboBox();
+    mode_combo_->addItem("全网格", static_cast<int>(SweepMode::kGrid));
+    mode_combo_->addItem("随机抽样", static_cast<int>(SweepMode::kRandom));
+    mode_row->addWidget(mode_combo_);
+
+    mode_row->addWidget(new QLabel("样本数"));
+    samples_spin_ = new QSpinBox();
+    samples_spin_->setRange(1, SweepDesign::kMaxRuns);
+    samples_spin_->setValue(kDefaultSamples);
+    mode_row->addWidget(samples_spin_);
+
+    mode_row->addWidget(new QLabel("种子"));
+    seed_spin_ = new QSpinBox();
+    seed_spin_->setRange(0, 999999);
+    seed_spin_->setValue(1);
+    mode_row->addWidget(seed_spin_);
+
+    design_label_ = new QLabel();
+    design_label_->setStyleSheet("color: #666; font-size: 9pt;");
+    mode_row->addWidget(design_label_, 1);
+
+    start_button_ = new QPushButton("开始扫描");
+    start_button_->setStyleSheet("background-color: #4CAF50; color: white; font-weight: bold;");
+    cancel_button_ = new QPushButton("取消扫描");
+    mode_row->addWidget(start_button_);
+    mode_row->addWidget(cancel_button_);
+    design_layout->addLayout(mode_row);
+
+    layout->addWidget(design_group);
+
+    // 扫描结果
+    QGroupBox* result_group = new QGroupBox("扫描结果");
+    QVBoxLayout* result_layout = new QVBoxLayout(result_group);
+
+    QHBoxLayout* best_row = new QHBoxLayout();
+    best_label_ = new QLabel("最优配置: -");
+    best_label_->setStyleSheet("font-weight: bold;");
+    best_row->addWidget(best_label_, 1);
+    export_button_ = new QPushButton("导出 CSV...");
+    best_row->addWidget(export_button_);
+    result_layout->addLayout(best_row);
+
+    result_table_ = new QTableWidget();
+    result_table_->horizontalHeader()->setStretchLastSection(true);
+    result_table_->verticalHeader()->setVisible(false);
+    result_table_->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    result_table_->setSelectionBehavior(QAbstractItemView::SelectRows);
+    result_layout->addWidget(result_table_);
+
+    layout->addWidget(result_group, 1);
+
+    connect(browse_button_, &QPushButton::clicked, this, &SweepWidget::OnBrowseFile);
+    connect(start_button_, &QPushButton::clicked, this, &SweepWidget::OnStartSweep);
+    connect(cancel_button_, &QPushButton::clicked, this, &SweepWidget::OnCancelSweep);
+    connect(export_button_, &QPushButton::clicked, this, &SweepWidget::OnExportCsv);
+    connect(axis_table_, &QTableWidget::itemChanged, this, &SweepWidget::UpdateDesignInfo);
+    connect(mode_combo_, QOverload<int>::of(&QComboBox::currentIndexChanged),
+            this, &SweepWidget::UpdateDesignInfo);
+    connect(samples_spin_, QOverload<int>::of(&QSpinBox::valueChanged),
+            this, &SweepWidget::UpdateDesignInfo);
+
+    UpdateDesignInfo();
+}
+
+void SweepWidget::SetBaseParameters(const QVariantMap& params) {
+    base_params_ = params;
+
+    // 首次调用时按参数建行, 之后只更新当前值
+    const QSignalBlocker blocker(axis_table_);
+    if (axis_table_->rowCount() == 0) {
+        axis_table_->setRowCount(static_cast<int>(params.size()));
+        int row = 0;
+        for (auto it = params.cbegin(); it != params.cend(); ++it, ++row) {
+            QTableWidgetItem* enabled = new QTableWidgetItem();
+            enabled->setFlags(Qt::ItemIsEnabled | Qt::ItemIsUserCheckable);
+            enabled->setCheckState(Qt::Unchecked);
+            axis_table_->setItem(row, kAxisEnabled, enabled);
+
+            QTableWidgetItem* key = new QTableWidgetItem(it.key());
+            key->setFlags(Qt::ItemIsEnabled);
+            axis_table_->setItem(row, kAxisKey, key);
+
+            QTableWidgetItem* current = new QTableWidgetItem();
+            current->setFlags(Qt::ItemIsEnabled);
+            axis_table_->setItem(row, kAxisCurrent, current);
+
+            axis_table_->setItem(row, kAxisValues, new QTableWidgetItem(ValueText(it.value())));
+        }
+    }
+
+    for (int row = 0; row < axis_table_->rowCount(); ++row) {
+        const QString key = axis_table_->item(row, kAxisKey)->text();
+        axis_table_->item(row, kAxisCurrent)->setText(ValueText(params.value(key)));
+    }
+    UpdateDesignInfo();
+}
+
+void SweepWidget::SetDataFile(const QString& file) {
+    if (file_edit_->text().isEmpty()) {
+        file_edit_->setText(file);
+    }
+}
+
+void SweepWidget::OnBrowseFile() {
+    const QString file = QFileDialog::getOpenFileName(
+        this, "选择数据文件", QDir::currentPath(),
+        "CSV 文件 (*.csv);;所有文件 (*)");
+    if (!file.isEmpty()) {
+        file_edit_->setText(file);
+    }
+}
+
+bool SweepWidget::CollectAxes(QVector<SweepAxis>* axes, QString* error) const {
+    axes->clear();
+    for (int row = 0; row < axis_table_->rowCount(); ++row) {
+        if (axis_table_->item(row, kAxisEnabled)->checkState() != Qt::Checked) continue;
+
+        const QString key = axis_table_->item(row, kAxisKey)->text();
+        const QTableWidgetItem* values = axis_table_->item(row, kAxisValues);
+        SweepAxis axis;
+        if (!SweepAxis::Parse(key, values ? values->text() : QString(),
+                              base_params_.value(key), &axis, error)) {
+            return false;
+        }
+        axes->append(axis);
+    }
+    if (axes->isEmpty()) {
+        *error = "未勾选要扫描的参数";
+        return false;
+    }
+    return true;
+}
+
+void SweepWidget::UpdateDesignInfo() {
+    const bool random = mode_combo_->currentData().toInt() == static_cast<int>(SweepMode::kRandom);
+    samples_spin_->setEnabled(random);
+    seed_spin_->setEnabled(random);
+
+    QVector<SweepAxis> axes;
+    QString error;
+    if (!CollectAxes(&axes, &error)) {
+        design_label_->setText(error);
+        return;
+    }
+
+    const qint64 grid_size = SweepDesign::GridSize(axes);
+    if (random) {
+        const qint64 count = grid_size >= 0 ? qMin<qint64>(grid_size, samples_spin_->value())
+                                            : samples_spin_->value();
+        design_label_->setText(QString("%1 个组合").arg(count));
+    } else if (grid_size < 0) {
+        design_label_->setText("连续区间只能随机抽样");
+    } else if (grid_size > SweepDesign::kMaxRuns) {
+        design_label_->setText(QString("超过 %1 个组合").arg(SweepDesign::kMaxRuns));
+    } else {
+        design_label_->setText(QString("%1 个组合").arg(grid_size));
+    }
+}
+
+void SweepWidget::OnStartSweep() {
+    const QString data_file = file_edit_->text().trimmed();
+    if (data_file.isEmpty()) {
+        QMessageBox::warning(this, "警告", "请先选择数据文件");
+        return;
+    }
+
+    QVector<SweepAxis> axes;
+    QString error;
+    if (!CollectAxes(&axes, &error)) {
+        QMessageBox::warning(this, "警告", error);
+        return;
+    }
+
+    QVector<QVariantMap> combos;
+    if (mode_combo_->currentData().toInt() == static_cast<int>(SweepMode::kRandom)) {
+        combos = SweepDesign::Random(axes, samples_spin_->value(),
+                                     static_cast<quint32>(seed_spin_->value()));
+    } else {
+        const qint64 grid_size = SweepDesign::GridSize(axes);
+        if (grid_size < 0) {
+            QMessageBox::warning(this, "警告", "连续区间只能随机抽样, 请给出步长或改用随机设计");
+            return;
+        }
+        if (grid_size > SweepDesign::kMaxRuns) {
+            QMessageBox::warning(this, "警告",
+                QString("网格组合数超过上限 %1, 请缩小取值或改用随机设计")
+                    .arg(SweepDesign::kMaxRuns));
+            return;
+        }
+        combos = SweepDesign::Grid(axes);
+    }
+
+    // 新一轮扫描: 重建结果表
+    swept_keys_.clear();
+    for (const SweepAxis& axis : axes) {
+        swept_keys_ << axis.key;
+    }
+    runs_.clear();
+    job_runs_.clear();
+    dirty_runs_.clear();
+    best_run_ = -1;
+    best_label_->setText("最优配置: -");
+
+    result_table_->clear();
+    result_table_->setRowCount(0);
+    result_table_->setColumnCount(static_cast<int>(swept_keys_.size() + kResultColumns.size()) + 1);
+    result_table_->setHorizontalHeaderLabels(QStringList{"#"} + swept_keys_ + kResultColumns);
+    result_table_->setColumnWidth(0, 40);
+
+    emit SweepRequested(data_file, combos);
+}
+
+void SweepWidget::AddRun(int job_id, const QVariantMap& combo) {
+    SweepRun run;
+    run.job_id = job_id;
+    run.combo = combo;
+
+    const int index = static_cast<int>(runs_.size());
+    runs_.append(run);
+    job_runs_.insert(job_id, index);
+
+    result_table_->insertRow(index);
+    FillRow(index);
+}
+
+void SweepWidget::OnCancelSweep() {
+    for (const SweepRun& run : std::as_const(runs_)) {
+        const SolveJob* job = queue_->Job(run.job_id);
+        if (job && job->IsActive()) {
+            queue_->Cancel(run.job_id);
+        }
+    }
+}
+
+void SweepWidget::OnJobChanged(int job_id) {
+    const int index = job_runs_.value(job_id, -1);
+    if (index < 0) return;
+    dirty_runs_.insert(index);
+    refresh_scheduler_->RequestUpdate();
+}
+
+void SweepWidget::RefreshRows() {
+    bool finished = false;
+    for (int index : std::as_const(dirty_runs_)) {
+        // 从队列复制最新状态, 任务被移出队列后仍能显示
+        SweepRun& run = runs_[index];
+        if (const SolveJob* job = queue_->Job(run.job_id)) {
+            run.state = job->state;
+            run.iterations = job->state == JobState::kSucceeded ? job->iterations : job->iteration;
+            run.runtime = job->runtime;
+            run.final_v = job->state == JobState::kSucceeded ? job->final_v : job->v;
+            // 队列启动时分得的线程数, 计时要结合它比较
+            if (job->threads > 0) {
+                run.threads = job->threads;
+            }
+            if (job->started_ms > 0 && job->finished_ms > 0) {
+                run.wall_seconds = (job->finished_ms - job->started_ms) / 1000.0;
+            }
+            finished = finished || !job->IsActive();
+        }
+        FillRow(index);
+    }
+    dirty_runs_.clear();
+
+    if (finished) {
+        UpdateBest();
+    }
+}
+
+void SweepWidget::FillRow(int index) {
+    const SweepRun& run = runs_[index];
+
+    auto set_text = [this, index](int column, const QString& text) {
+        QTableWidgetItem* item = result_table_->item(index, column);
+        if (!item) {
+            item = new QTableWidgetItem();
+            result_table_->setItem(index, column, item);
+        }
+        item->setText(text);
+    };
+
+    int column = 0;
+    set_text(column++, QString::number(index + 1));
+    for (const QString& key : std::as_const(swept_keys_)) {
+        set_text(column++, ValueText(run.combo.value(key)));
+    }
+
+    const bool done = run.state == JobState::kSucceeded;
+    set_text(column++, StateText(run.state));
+    set_text(column++, run.iterations > 0 ? QString::number(run.iterations) : "-");
+    set_text(column++, run.threads > 0 ? QString::number(run.threads) : "-");
+    set_text(column++, done ? QString::number(run.runtime, 'f', 2) : "-");
+    set_text(column++, run.wall_seconds > 0.0 ? QString::number(run.wall_seconds, 'f', 2) : "-");
+    set_text(column++, done || run.iterations > 0 ? QString::number(run.final_v, 'f', 6) : "-");
+}
+
+void SweepWidget::UpdateBest() {
+    // 最优: 成功结束的组合中墙钟时间最短
+    int best = -1;
+    for (int i = 0; i < runs_.size(); ++i) {
+        if (runs_[i].state != JobState::kSucceeded) continue;
+        if (best < 0 || runs_[i].wall_seconds < runs_[best].wall_seconds) {
+            best = i;
+        }
+    }
+    if (best == best_run_) return;
+
+    auto mark_row = [this](int row, bool highlight) {
+        for (int column = 0; column < result_table_->columnCount(); ++column) {
+            QTableWidgetItem* item = result_table_->item(row, column);
+            if (!item) continue;
+            item->setBackground(highlight ? QBrush(kBestBackground) : QBrush());
+            QFont font = item->font();
+            font.setBold(highlight);
+            item->setFont(font);
+        }
+    };
+    if (best_run_ >= 0) {
+        mark_row(best_run_, false);
+    }
+    best_run_ = best;
+    if (best_run_ < 0) return;
+
+    mark_row(best_run_, true);
+    const SweepRun& run = runs_[best_run_];
+    QStringList parts;
+    for (const QString& key : std::as_const(swept_keys_)) {
+        parts << key + " = " + ValueText(run.combo.value(key));
+    }
+    best_label_->setText(QString("最优配置 (#%1): %2, 墙钟 %3 s (%4 线程), v* = %5")
+        .arg(best_run_ + 1)
+        .arg(parts.join(", "))
+        .arg(run.wall_seconds, 0, 'f', 2)
+        .arg(run.threads)
+        .arg(run.final_v, 0, 'f', 6));
+    result_table_->scrollToItem(result_table_->item(best_run_, 0));
+}
+
+void SweepWidget::OnExportCsv() {
+    if (runs_.isEmpty()) {
+        QMessageBox::information(this, "提示", "没有扫描结果");
+        return;
+    }
+
+    const QString file = QFileDialog::getSaveFileName(
+        this, "导出扫描结果", QDir::currentPath() + "/sweep.csv",
+        "CSV 文件 (*.csv)");
+    if (file.isEmpty()) return;
+
+    QFile out(file);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        QMessageBox::critical(this, "错误", "无法写入文件: " + out.errorString());
+        return;
+    }
+
+    QTextStream stream(&out);
+    stream << (QStringList{"run"} + swept_keys_
+               + QStringList{"state", "iterations", "threads", "runtime_s", "wall_s", "v_star"}).join(',') << "\n";
+    for (int i = 0; i < runs_.size(); ++i) {
+        const SweepRun& run = runs_[i];
+        QStringList fields{QString::number(i + 1)};
+        for (const QString& key : std::as_const(swept_keys_)) {
+            fields << ValueText(run.combo.value(key));
+        }
+        fields << StateText(run.state)
+               << QString::number(run.iterations)
+               << QString::number(run.threads)
+               << QString::number(run.runtime, 'f', 3)
+               << QString::number(run.wall_seconds, 'f', 3)
+               << QString::number(run.final_v, 'g', 10);
+        stream << fields.join(',') << "\n";
+    }
+}
@@ -0,0 +1,99 @@
+// sweep_widget.h - 参数扫描 Tab
+// 对求解参数的任意子集做网格或随机设计, 组合作为并发任务进入求解队列, 结果汇总到一张表
+
+#ifndef SWEEP_WIDGET_H
+#define SWEEP_WIDGET_H
+
+#include "job_queue.h"
+#include "sweep_design.h"
+
+#include <QHash>
+#include <QSet>
+#include <QVariantMap>
+#include <QVector>
+#include <QWidget>
+
+class QTableWidget;
+class QLineEdit;
+class QComboBox;
+class QSpinBox;
+class QPushButton;
+class QLabel;
+class UpdateScheduler;
+
+class SweepWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    explicit SweepWidget(JobQueue* queue, QWidget* parent = nullptr);
+
+    // 基准参数 (求解 Tab 当前设置), 未扫描的参数取此值
+    void SetBaseParameters(const QVariantMap& params);
+
+    // 默认数据文件 (求解 Tab 当前文件)
+    void SetDataFile(const QString& file);
+
+    // 组合加入队列后登记, 之后随任务状态更新结果表
+    void AddRun(int job_id, const QVariantMap& combo);
+
+signals:
+    // 请求以基准参数 + 各组合覆盖值加入队列
+    void SweepRequested(const QString& data_file, const QVector<QVariantMap>& combos);
+
+private slots:
+    void OnBrowseFile();
+    void OnStartSweep();
+    void OnCancelSweep();
+    void OnExportCsv();
+    void OnJobChanged(int job_id);
+    void UpdateDesignInfo();
+    void RefreshRows();
+
+private:
+    void SetupUI();
+
+    // 读取勾选的参数及取值, 失败时写入 error
+    bool CollectAxes(QVector<SweepAxis>* axes, QString* error) const;
+
+    void FillRow(int index);
+    void UpdateBest();
+
+    // 一个组合的运行记录 (任务移出队列后仍保留)
+    struct SweepRun {
+        int job_id = 0;
+        QVariantMap combo;
+        JobState state = JobState::kQueued;
+        int iterations = 0;
+        int threads = 0;            // 队列分得的线程数
+        double runtime = 0.0;
+        double wall_seconds = 0.0;
+        double final_v = 0.0;
+    };
+
+    JobQueue* queue_;
+    QVariantMap base_params_;
+
+    QLineEdit* file_edit_;
+    QPushButton* browse_button_;
+    QTableWidget* axis_table_;
+    QComboBox* mode_combo_;
+    QSpinBox* samples_spin_;
+    QSpinBox* seed_spin_;
+    QLabel* design_label_;
+    QPushButton* start_button_;
+    QPushButton* cancel_button_;
+    QPushButton* export_button_;
+    QLabel* best_label_;
+    QTableWidget* result_table_;
+
+    // 本轮扫描的参数 (结果表的参数列)
+    QStringList swept_keys_;
+    QVector<SweepRun> runs_;
+    QHash<int, int> job_runs_;   // 任务编号 -> runs_ 下标
+    int best_run_;
+
+    QSet<int> dirty_runs_;
+    UpdateScheduler* refresh_scheduler_;
+};
+
+#endif  // SWEEP_WIDGET_H
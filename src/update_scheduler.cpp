@@ -0,0 +1,45 @@
+// update_scheduler.cpp - 界面刷新调度实现
+
+#include "update_scheduler.h"
+
+#include <QTimer>
+
+UpdateScheduler::UpdateScheduler(int max_fps, QObject* parent)
+    : QObject(parent)
+    , timer_(new QTimer(this))
+    , interval_ms_(33)
+    , dirty_(false) {
+    timer_->setSingleShot(true);
+    connect(timer_, &QTimer::timeout, this, &UpdateScheduler::OnTimeout);
+    SetMaxFps(max_fps);
+    last_update_.start();
+}
+
+void UpdateScheduler::SetMaxFps(int fps) {
+    interval_ms_ = 1000 / qMax(1, fps);
+}
+
+void UpdateScheduler::RequestUpdate() {
+    dirty_ = true;
+    if (timer_->isActive()) {
+        return;
+    }
+
+    // 距上一帧不足一个周期时等到周期结束
+    const qint64 wait = interval_ms_ - last_update_.elapsed();
+    timer_->start(static_cast<int>(qMax<qint64>(0, wait)));
+}
+
+void UpdateScheduler::FlushNow() {
+    if (!dirty_) {
+        return;
+    }
+    timer_->stop();
+    OnTimeout();
+}
+
+void UpdateScheduler::OnTimeout() {
+    dirty_ = false;
+    last_update_.restart();
+    emit UpdateDue();
+}
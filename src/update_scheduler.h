@@ -0,0 +1,40 @@
+// update_scheduler.h - 界面刷新调度
+// 标记待刷新后合并到下一帧统一刷新, 每秒最多刷新 N 次
+
+#ifndef UPDATE_SCHEDULER_H
+#define UPDATE_SCHEDULER_H
+
+#include <QObject>
+#include <QElapsedTimer>
+
+class QTimer;
+
+class UpdateScheduler : public QObject {
+    Q_OBJECT
+
+public:
+    explicit UpdateScheduler(int max_fps = 30, QObject* parent = nullptr);
+
+    // 每秒最多刷新次数
+    void SetMaxFps(int fps);
+
+    // 标记待刷新, 在下一帧发出 UpdateDue
+    void RequestUpdate();
+
+    // 有待刷新内容时立即刷新
+    void FlushNow();
+
+signals:
+    void UpdateDue();
+
+private slots:
+    void OnTimeout();
+
+private:
+    QTimer* timer_;
+    QElapsedTimer last_update_;
+    int interval_ms_;
+    bool dirty_;
+};
+
+#endif  // UPDATE_SCHEDULER_H